@@ -13,7 +13,7 @@
 // limitations under the License.
 
 // FileAnalyzer holds the results of lexing and parsing.
-// Internally, it owns a copy of the source text as a string,
+// Internally, it owns (or shares) the source text as a MemBlock,
 // and scanned Tokens pointing to substrings as string_views.
 // Subclasses are expected to call Tokenize(), and possibly perform
 // other actions and refinements on the TokenStreamView, before
@@ -40,12 +40,15 @@
 #define VERIBLE_COMMON_ANALYSIS_FILE_ANALYZER_H_
 
 #include <iosfwd>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "common/lexer/lexer.h"
 #include "common/parser/parse.h"
+#include "common/strings/mem_block.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
 
@@ -77,6 +80,12 @@ class FileAnalyzer : public TextStructure {
   explicit FileAnalyzer(absl::string_view contents, absl::string_view filename)
       : TextStructure(contents), filename_(filename), rejected_tokens_() {}
 
+  // Shares ownership of 'contents' without copying.
+  FileAnalyzer(std::shared_ptr<MemBlock> contents, absl::string_view filename)
+      : TextStructure(std::move(contents)),
+        filename_(filename),
+        rejected_tokens_() {}
+
   virtual ~FileAnalyzer() {}
 
   virtual absl::Status Tokenize() = 0;
@@ -0,0 +1,99 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/lint_result_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/strings/fingerprint.h"
+#include "common/util/file_util.h"
+#include "common/util/logging.h"
+
+namespace verible {
+
+// First line of every entry.  Change this when the entry format changes.
+static constexpr absl::string_view kEntryHeader = "verible-lint-result 1\n";
+
+LintResultCache::LintResultCache(absl::string_view directory,
+                                 absl::string_view version)
+    : directory_(directory), version_(FingerprintOf(version)) {
+  const absl::Status status = file::CreateDir(directory_);
+  if (!status.ok()) {
+    LOG(WARNING) << "Can't create lint cache directory '" << directory_
+                 << "': " << status.message();
+  }
+}
+
+// Path of the running program's executable.
+static constexpr absl::string_view kProgramPath = "/proc/self/exe";
+
+absl::StatusOr<std::string> LintResultCache::ProgramVersion(
+    absl::string_view build_version) {
+  if (!build_version.empty()) return std::string(build_version);
+  std::string program;
+  const absl::Status status = file::GetContents(kProgramPath, &program);
+  if (!status.ok()) return status;
+  return absl::StrCat("unstamped ", FingerprintOf(program).ToHex());
+}
+
+Fingerprint LintResultCache::MakeKey(
+    const std::vector<absl::string_view>& parts) const {
+  Fingerprint key = version_;
+  for (const auto part : parts) {
+    key = CombineFingerprints(key, FingerprintOf(part));
+  }
+  return key;
+}
+
+std::string LintResultCache::EntryPath(const Fingerprint& key) const {
+  return file::JoinPath(directory_, key.ToHex());
+}
+
+absl::StatusOr<LintResultCache::Result> LintResultCache::Lookup(
+    const Fingerprint& key) const {
+  std::string entry;
+  if (!file::GetContents(EntryPath(key), &entry).ok() ||
+      !absl::StartsWith(entry, kEntryHeader)) {
+    return absl::NotFoundError(key.ToHex());
+  }
+  // After the header: the exit status on one line, then the output.
+  absl::string_view rest(entry);
+  rest.remove_prefix(kEntryHeader.length());
+  const auto newline = rest.find('\n');
+  Result result;
+  if (newline == absl::string_view::npos ||
+      !absl::SimpleAtoi(rest.substr(0, newline), &result.exit_status)) {
+    return absl::NotFoundError(key.ToHex());
+  }
+  result.output = std::string(rest.substr(newline + 1));
+  return result;
+}
+
+absl::Status LintResultCache::Store(const Fingerprint& key,
+                                    const Result& result) const {
+  // Concurrent readers and writers, in this and in other processes, only see
+  // complete entries.
+  return file::SetContentsAtomically(
+      EntryPath(key),
+      absl::StrCat(kEntryHeader, result.exit_status, "\n", result.output));
+}
+
+}  // namespace verible
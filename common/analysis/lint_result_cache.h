@@ -0,0 +1,90 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_ANALYSIS_LINT_RESULT_CACHE_H_
+#define VERIBLE_COMMON_ANALYSIS_LINT_RESULT_CACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "common/strings/fingerprint.h"
+
+namespace verible {
+
+// LintResultCache keeps the diagnostics of linted files in a directory, so
+// that files that have not changed since they were last linted with the same
+// configuration can be reported without analyzing them again.
+//
+// Entries are keyed by a fingerprint of everything their diagnostics depend
+// on, see MakeKey().  An entry is written to a temporary file that is then
+// renamed into place, so that any number of processes can share a directory
+// without ever observing partially written entries.  Entries are never
+// evicted; the directory can be removed at any time.
+//
+// Usage:
+//   LintResultCache cache(dir, version);
+//   const auto key = cache.MakeKey({filename, content, configuration});
+//   const auto cached = cache.Lookup(key);
+//   if (cached.ok()) return cached->exit_status;
+//   ... lint ...
+//   cache.Store(key, result);
+class LintResultCache {
+ public:
+  // Outcome of linting one file.
+  struct Result {
+    // Exit status of the lint run, e.g. from verilog::LintOneFile().
+    int exit_status = 0;
+
+    // Diagnostics, as printed.
+    std::string output;
+  };
+
+  // Uses 'directory', which is created if it does not exist.
+  // Entries stored with a different 'version', usually that of the tool, are
+  // never returned.
+  LintResultCache(absl::string_view directory, absl::string_view version);
+
+  // Returns the version of the entries of a program built as
+  // 'build_version', e.g. verible::GetBuildVersion().  Unstamped builds have
+  // an empty build version, so a fingerprint of the program's executable is
+  // used instead, and a rebuilt program never returns the entries of an older
+  // build.  Returns an error if the executable can't be read, in which case
+  // no cache should be used.
+  static absl::StatusOr<std::string> ProgramVersion(
+      absl::string_view build_version);
+
+  // Returns the key of a result that depends on the sequence of 'parts'.
+  Fingerprint MakeKey(const std::vector<absl::string_view>& parts) const;
+
+  // Returns the result stored under 'key', or a NotFound error.
+  absl::StatusOr<Result> Lookup(const Fingerprint& key) const;
+
+  // Stores 'result' under 'key', replacing any previous entry.
+  absl::Status Store(const Fingerprint& key, const Result& result) const;
+
+ private:
+  // Returns the path of the entry for 'key'.
+  std::string EntryPath(const Fingerprint& key) const;
+
+  const std::string directory_;
+
+  const Fingerprint version_;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_ANALYSIS_LINT_RESULT_CACHE_H_
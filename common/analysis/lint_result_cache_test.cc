@@ -0,0 +1,107 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/lint_result_cache.h"
+
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "common/util/file_util.h"
+#include "gtest/gtest.h"
+
+namespace verible {
+namespace {
+
+std::string CacheDir(absl::string_view name) {
+  return file::JoinPath(::testing::TempDir(), name);
+}
+
+TEST(LintResultCacheTest, MissingEntry) {
+  const LintResultCache cache(CacheDir("missing"), "v1");
+  const auto result = cache.Lookup(cache.MakeKey({"file.sv", "module m;"}));
+  EXPECT_EQ(result.status().code(), absl::StatusCode::kNotFound);
+}
+
+TEST(LintResultCacheTest, StoreThenLookup) {
+  const LintResultCache cache(CacheDir("store"), "v1");
+  const Fingerprint key = cache.MakeKey({"file.sv", "module m;"});
+  EXPECT_TRUE(cache.Store(key, {1, "file.sv:1:1: bad\nmore\n"}).ok());
+  const auto result = cache.Lookup(key);
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_EQ(result->exit_status, 1);
+  EXPECT_EQ(result->output, "file.sv:1:1: bad\nmore\n");
+
+  // Storing again replaces the entry.
+  EXPECT_TRUE(cache.Store(key, {0, ""}).ok());
+  const auto replaced = cache.Lookup(key);
+  ASSERT_TRUE(replaced.ok()) << replaced.status();
+  EXPECT_EQ(replaced->exit_status, 0);
+  EXPECT_EQ(replaced->output, "");
+}
+
+TEST(LintResultCacheTest, KeysDependOnAllPartsAndVersion) {
+  const LintResultCache cache(CacheDir("keys"), "v1");
+  const LintResultCache other_version(CacheDir("keys"), "v2");
+  const Fingerprint key = cache.MakeKey({"file.sv", "module m;"});
+  EXPECT_EQ(key, cache.MakeKey({"file.sv", "module m;"}));
+  EXPECT_NE(key, cache.MakeKey({"file.sv", "module n;"}));
+  EXPECT_NE(key, cache.MakeKey({"file.s", "vmodule m;"}));
+  EXPECT_NE(key, cache.MakeKey({"file.sv", "module m;", ""}));
+  EXPECT_NE(key, other_version.MakeKey({"file.sv", "module m;"}));
+}
+
+TEST(LintResultCacheTest, ProgramVersion) {
+  const auto stamped = LintResultCache::ProgramVersion("v1");
+  ASSERT_TRUE(stamped.ok()) << stamped.status();
+  EXPECT_EQ(*stamped, "v1");
+
+  // Unstamped builds are told apart by their executable.
+  const auto unstamped = LintResultCache::ProgramVersion("");
+  ASSERT_TRUE(unstamped.ok()) << unstamped.status();
+  EXPECT_FALSE(unstamped->empty());
+  EXPECT_EQ(*unstamped, *LintResultCache::ProgramVersion(""));
+}
+
+TEST(LintResultCacheTest, IgnoresCorruptEntries) {
+  const LintResultCache cache(CacheDir("corrupt"), "v1");
+  const Fingerprint key = cache.MakeKey({"file.sv"});
+  ASSERT_TRUE(file::SetContents(file::JoinPath(CacheDir("corrupt"),
+                                               key.ToHex()),
+                                "garbage")
+                  .ok());
+  EXPECT_FALSE(cache.Lookup(key).ok());
+}
+
+TEST(LintResultCacheTest, ConcurrentWritersOfSameEntry) {
+  const LintResultCache cache(CacheDir("concurrent"), "v1");
+  const Fingerprint key = cache.MakeKey({"file.sv"});
+  const std::string output(10000, 'x');
+  std::vector<std::thread> writers;
+  for (int i = 0; i < 8; ++i) {
+    writers.emplace_back([&] {
+      for (int j = 0; j < 20; ++j) {
+        EXPECT_TRUE(cache.Store(key, {1, output}).ok());
+        const auto result = cache.Lookup(key);
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_EQ(result->output, output);
+      }
+    });
+  }
+  for (auto& writer : writers) writer.join();
+}
+
+}  // namespace
+}  // namespace verible
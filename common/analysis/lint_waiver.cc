@@ -20,11 +20,16 @@
 #include <functional>
 #include <iterator>
 #include <map>
-#include <regex>  // NOLINT
+#include <memory>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "common/analysis/command_file_lexer.h"
@@ -37,6 +42,8 @@
 #include "common/util/file_util.h"
 #include "common/util/iterator_range.h"
 #include "common/util/logging.h"
+#include "re2/re2.h"
+#include "re2/set.h"
 
 namespace verible {
 
@@ -50,29 +57,122 @@ void LintWaiver::WaiveLineRange(absl::string_view rule_name, int line_begin,
   line_set.Add({line_begin, line_end});
 }
 
-void LintWaiver::WaiveWithRegex(absl::string_view rule_name,
-                                const std::string& regex_str) {
-  RegexVector& regex_vector = waiver_re_map_[rule_name];
-  auto regex_iter = regex_cache_.find(regex_str);
+// Waiver files can hold hundreds of expressions, so allow the combined
+// automaton more memory than RE2's default.
+static constexpr int64_t kRegexSetMaxMemory = 64 << 20;
+
+absl::StatusOr<int> WaiverRegexSet::Add(const std::string& regex) {
+  const auto found = regex_index_.find(regex);
+  if (found != regex_index_.end()) return found->second;
+  const RE2 re(regex, RE2::Quiet);
+  if (!re.ok()) return absl::InvalidArgumentError(re.error());
+  const int index = static_cast<int>(regex_index_.size());
+  regex_index_.emplace(regex, index);
+  // Recompile the set with the new expression when next needed.
+  regex_set_.reset();
+  return index;
+}
 
-  if (regex_iter == regex_cache_.end()) {
-    regex_cache_[regex_str] = std::regex(regex_str);
+absl::StatusOr<int> WaiverRegexSet::Find(const std::string& regex) const {
+  const auto found = regex_index_.find(regex);
+  if (found == regex_index_.end()) {
+    return absl::NotFoundError(absl::StrCat("Unknown regex: ", regex));
   }
+  return found->second;
+}
 
-  regex_vector.push_back(&regex_cache_[regex_str]);
+absl::Status WaiverRegexSet::Compile() {
+  RE2::Options options;
+  options.set_log_errors(false);
+  options.set_max_mem(kRegexSetMaxMemory);
+  auto regex_set = absl::make_unique<RE2::Set>(options, RE2::UNANCHORED);
+  // Add in index order, which is the order RE2::Set reports matches by.
+  std::vector<const std::string*> regexes(regex_index_.size());
+  for (const auto& regex : regex_index_) regexes[regex.second] = &regex.first;
+  for (const std::string* regex : regexes) {
+    // Each expression was validated by Add().
+    if (regex_set->Add(*regex, nullptr) < 0) {
+      return absl::InternalError(absl::StrCat("Can't add regex: ", *regex));
+    }
+  }
+  if (!regex_set->Compile()) {
+    return absl::ResourceExhaustedError(
+        "Out of memory compiling waiver regexes");
+  }
+  regex_set_ = std::move(regex_set);
+  return absl::OkStatus();
+}
+
+void WaiverRegexSet::Match(absl::string_view text,
+                           std::vector<int>* matches) const {
+  matches->clear();
+  regex_set_->Match(re2::StringPiece(text.data(), text.size()), matches);
 }
 
-void LintWaiver::RegexToLines(absl::string_view contents,
-                              const LineColumnMap& line_map) {
-  for (const auto& rule : waiver_re_map_) {
-    for (const auto* re : rule.second) {
-      for (std::cregex_iterator i(contents.begin(), contents.end(), *re);
-           i != std::cregex_iterator(); i++) {
-        std::cmatch match = *i;
-        WaiveOneLine(rule.first, line_map(match.position()).line);
+LintWaiver::RegexWaivers& LintWaiver::GetRegexWaivers(
+    const WaiverRegexSet* regex_set) {
+  for (auto& regex_waivers : regex_waivers_) {
+    if (regex_waivers.regex_set.get() == regex_set) return regex_waivers;
+  }
+  regex_waivers_.emplace_back();
+  return regex_waivers_.back();
+}
+
+absl::Status LintWaiver::WaiveWithRegex(absl::string_view rule_name,
+                                        const std::string& regex_str) {
+  if (own_regex_set_ == nullptr) {
+    own_regex_set_ = std::make_shared<WaiverRegexSet>();
+  }
+  const auto index = own_regex_set_->Add(regex_str);
+  if (!index.ok()) return index.status();
+  WaiveWithRegex(rule_name, own_regex_set_, *index);
+  return absl::OkStatus();
+}
+
+void LintWaiver::WaiveWithRegex(absl::string_view rule_name,
+                                std::shared_ptr<const WaiverRegexSet> regex_set,
+                                int index) {
+  RegexWaivers& regex_waivers = GetRegexWaivers(regex_set.get());
+  if (regex_waivers.regex_set == nullptr) {
+    regex_waivers.regex_set = std::move(regex_set);
+  }
+  regex_waivers.rules[index].push_back(rule_name);
+}
+
+absl::Status LintWaiver::RegexToLines(absl::string_view contents,
+                                      const LineColumnMap& line_map) {
+  if (own_regex_set_ != nullptr && !own_regex_set_->IsCompiled()) {
+    const auto status = own_regex_set_->Compile();
+    if (!status.ok()) return status;
+  }
+
+  const std::vector<int>& line_offsets = line_map.GetBeginningOfLineOffsets();
+  std::vector<int> matches;  // Re-use in loop.
+  for (const auto& regex_waivers : regex_waivers_) {
+    if (!regex_waivers.regex_set->IsCompiled()) {
+      return absl::FailedPreconditionError("Waiver regexes are not compiled");
+    }
+    for (size_t line = 0; line < line_offsets.size(); ++line) {
+      const size_t begin =
+          std::min<size_t>(line_offsets[line], contents.size());
+      // Exclude the newline.
+      const size_t end =
+          line + 1 < line_offsets.size()
+              ? std::max<size_t>(begin, line_offsets[line + 1] - 1)
+              : contents.size();
+      regex_waivers.regex_set->Match(contents.substr(begin, end - begin),
+                                     &matches);
+      for (const int index : matches) {
+        const auto* rules =
+            verible::container::FindOrNull(regex_waivers.rules, index);
+        if (rules == nullptr) continue;  // Not applied to this file.
+        for (const auto& rule : *rules) {
+          WaiveOneLine(rule, line);
+        }
       }
     }
   }
+  return absl::OkStatus();
 }
 
 bool LintWaiver::RuleIsWaivedOnLine(absl::string_view rule_name,
@@ -184,7 +284,7 @@ void LintWaiverBuilder::ProcessLine(const TokenRange& tokens, int line_number) {
   }
 }
 
-void LintWaiverBuilder::ProcessTokenRangesByLine(
+absl::Status LintWaiverBuilder::ProcessTokenRangesByLine(
     const TextStructureView& text_structure) {
   const int total_lines = text_structure.Lines().size();
   const auto& tokens = text_structure.TokenStream();
@@ -199,8 +299,8 @@ void LintWaiverBuilder::ProcessTokenRangesByLine(
   }
 
   // Apply regex waivers
-  lint_waiver_.RegexToLines(text_structure.Contents(),
-                            text_structure.GetLineColumnMap());
+  const auto status = lint_waiver_.RegexToLines(
+      text_structure.Contents(), text_structure.GetLineColumnMap());
 
   // Flush out any remaining open-ranges, so that those waivers take effect
   // until the end-of-file.
@@ -210,6 +310,7 @@ void LintWaiverBuilder::ProcessTokenRangesByLine(
                                 total_lines);
   }
   waiver_open_ranges_.clear();
+  return status;
 }
 
 template <typename... T>
@@ -230,10 +331,12 @@ static absl::Status WaiveCommandError(LineColumn pos,
 }
 
 static absl::Status WaiveCommandHandler(
-    const TokenRange& tokens, absl::string_view waive_file,
-    absl::string_view waive_content, absl::string_view lintee_filename,
-    const LineColumnMap& line_map, LintWaiver* waiver,
+    const TokenRange& tokens, const ExternalWaiverFile& waiver_file,
+    absl::string_view lintee_filename, LintWaiver* waiver,
     const std::set<absl::string_view>& active_rules) {
+  const absl::string_view waive_file = waiver_file.Filename();
+  const absl::string_view waive_content = waiver_file.Contents();
+  const LineColumnMap& line_map = waiver_file.GetLineColumnMap();
   absl::string_view rule;
 
   absl::string_view option;
@@ -330,15 +433,15 @@ static absl::Status WaiveCommandHandler(
         }
 
         if (option == "location") {
-          const std::string file_match_regex(val);
-          try {
-            const std::regex file_matcher(file_match_regex);
-            location_match =
-                std::regex_search(std::string(lintee_filename), file_matcher);
-          } catch (const std::regex_error& e) {
+          const RE2 file_matcher(re2::StringPiece(val.data(), val.size()),
+                                 RE2::Quiet);
+          if (!file_matcher.ok()) {
             return WaiveCommandError(token_pos, waive_file,
                                      "--location regex is invalid");
           }
+          location_match = RE2::PartialMatch(
+              re2::StringPiece(lintee_filename.data(), lintee_filename.size()),
+              file_matcher);
           continue;
         }
 
@@ -361,14 +464,14 @@ static absl::Status WaiveCommandHandler(
         }
 
         if (can_use_regex) {
-          try {
-            waiver->WaiveWithRegex(rule, regex);
-          } catch (const std::regex_error& e) {
-            auto* reason = e.what();
-
+          const auto regex_index = waiver_file.FindRegex(regex);
+          if (!regex_index.ok()) {
             return WaiveCommandError(regex_token_pos, waive_file,
-                                     "Invalid regex: ", reason);
+                                     "Invalid regex: ",
+                                     regex_index.status().message());
           }
+          waiver->WaiveWithRegex(rule, waiver_file.GetRegexSet(),
+                                 *regex_index);
         }
 
         if (can_use_lineno) {
@@ -376,15 +479,16 @@ static absl::Status WaiveCommandHandler(
         }
 
         if (!can_use_regex && !can_use_lineno) {
-          std::string content;
-          absl::Status status =
-              verible::file::GetContents(lintee_filename, &content);
-          if (!status.ok()) {
-            return WaiveCommandError(token_pos, waive_file, status.ToString());
+          const auto content =
+              verible::file::GetContentAsMemBlock(lintee_filename);
+          if (!content.ok()) {
+            return WaiveCommandError(token_pos, waive_file,
+                                     content.status().ToString());
           }
 
+          const absl::string_view text = (*content)->AsStringView();
           const size_t number_of_lines =
-              std::count(content.begin(), content.end(), '\n');
+              std::count(text.begin(), text.end(), '\n');
           waiver->WaiveLineRange(rule, 1, number_of_lines);
         }
 
@@ -401,9 +505,9 @@ static absl::Status WaiveCommandHandler(
 }
 
 using HandlerFun = std::function<absl::Status(
-    const TokenRange&, absl::string_view waive_file,
-    absl::string_view waive_content, absl::string_view lintee_filename,
-    const LineColumnMap&, LintWaiver*, const std::set<absl::string_view>&)>;
+    const TokenRange&, const ExternalWaiverFile&,
+    absl::string_view lintee_filename, LintWaiver*,
+    const std::set<absl::string_view>&)>;
 static const std::map<absl::string_view, HandlerFun>& GetCommandHandlers() {
   // allocated once, never freed
   static const auto* handlers = new std::map<absl::string_view, HandlerFun>{
@@ -413,6 +517,52 @@ static const std::map<absl::string_view, HandlerFun>& GetCommandHandlers() {
   return *handlers;
 }
 
+ExternalWaiverFile::ExternalWaiverFile(absl::string_view filename,
+                                       std::string content)
+    : filename_(filename), content_(std::move(content)), line_map_(content_) {
+  CommandFileLexer lexer(content_);
+  const std::vector<TokenRange> commands = lexer.GetCommandsTokenRanges();
+  // Copy tokens out of the lexer, which is not kept.
+  for (const auto& command : commands) {
+    const size_t begin = tokens_.size();
+    tokens_.insert(tokens_.end(), command.begin(), command.end());
+    command_bounds_.emplace_back(begin, tokens_.size());
+  }
+
+  // Validate and compile the regexes once, as they are the same for every
+  // linted file.
+  auto regex_set = std::make_shared<WaiverRegexSet>();
+  for (size_t i = 0; i + 1 < tokens_.size(); ++i) {
+    if (tokens_[i].token_enum() == CFG_TK_FLAG_WITH_ARG &&
+        tokens_[i].text() == "regex" &&
+        tokens_[i + 1].token_enum() == CFG_TK_ARG) {
+      const std::string regex(tokens_[i + 1].text());
+      const auto index = regex_set->Add(regex);
+      if (!index.ok()) regex_errors_.emplace(regex, index.status());
+    }
+  }
+  compile_status_ = regex_set->Compile();
+  regex_set_ = std::move(regex_set);
+}
+
+absl::StatusOr<int> ExternalWaiverFile::FindRegex(
+    const std::string& regex) const {
+  const auto error = regex_errors_.find(regex);
+  if (error != regex_errors_.end()) return error->second;
+  if (!compile_status_.ok()) return compile_status_;
+  return regex_set_->Find(regex);
+}
+
+std::vector<TokenRange> ExternalWaiverFile::Commands() const {
+  std::vector<TokenRange> commands;
+  commands.reserve(command_bounds_.size());
+  for (const auto& bounds : command_bounds_) {
+    commands.push_back(make_range(tokens_.begin() + bounds.first,
+                                  tokens_.begin() + bounds.second));
+  }
+  return commands;
+}
+
 absl::Status LintWaiverBuilder::ApplyExternalWaivers(
     const std::set<absl::string_view>& active_rules,
     absl::string_view lintee_filename, absl::string_view waiver_filename,
@@ -422,13 +572,22 @@ absl::Status LintWaiverBuilder::ApplyExternalWaivers(
                         "Broken waiver config handle");
   }
 
-  CommandFileLexer lexer(waivers_config_content);
-  const LineColumnMap line_map(waivers_config_content);
+  const ExternalWaiverFile waiver_file(waiver_filename,
+                                       std::string(waivers_config_content));
+  return ApplyExternalWaivers(active_rules, lintee_filename, waiver_file);
+}
+
+absl::Status LintWaiverBuilder::ApplyExternalWaivers(
+    const std::set<absl::string_view>& active_rules,
+    absl::string_view lintee_filename, const ExternalWaiverFile& waiver_file) {
+  const absl::string_view waiver_filename = waiver_file.Filename();
+  const absl::string_view waivers_config_content = waiver_file.Contents();
+  const LineColumnMap& line_map = waiver_file.GetLineColumnMap();
   LineColumn command_pos;
 
   const auto& handlers = GetCommandHandlers();
 
-  std::vector<TokenRange> commands = lexer.GetCommandsTokenRanges();
+  const std::vector<TokenRange> commands = waiver_file.Commands();
 
   bool all_commands_ok = true;
   for (const auto c_range : commands) {
@@ -458,9 +617,8 @@ absl::Status LintWaiverBuilder::ApplyExternalWaivers(
       continue;
     }
 
-    auto status = handler_iter->second(command, waiver_filename,
-                                       waivers_config_content, lintee_filename,
-                                       line_map, &lint_waiver_, active_rules);
+    auto status = handler_iter->second(command, waiver_file, lintee_filename,
+                                       &lint_waiver_, active_rules);
     if (!status.ok()) {
       // Mark the return value to be false, but continue parsing the config
       // file anyway
@@ -17,24 +17,64 @@
 
 #include <cstddef>
 #include <map>
-#include <regex>  // NOLINT
+#include <memory>
 #include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "common/strings/line_column_map.h"
 #include "common/strings/position.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_stream_view.h"
 #include "common/util/container_util.h"
 #include "common/util/interval_set.h"
+#include "re2/re2.h"
+#include "re2/set.h"
 
 namespace verible {
 
+// WaiverRegexSet holds distinct regular expressions (RE2 syntax), which are
+// compiled into a single automaton that matches a line against all of them in
+// one pass.
+class WaiverRegexSet {
+ public:
+  WaiverRegexSet() = default;
+
+  WaiverRegexSet(const WaiverRegexSet&) = delete;
+  WaiverRegexSet& operator=(const WaiverRegexSet&) = delete;
+
+  // Returns the index of 'regex', adding it if it is new, which discards any
+  // previous compilation.
+  // Returns an error if the regular expression is invalid.
+  absl::StatusOr<int> Add(const std::string& regex);
+
+  // Returns the index of 'regex', or a NotFound error if it was never added.
+  absl::StatusOr<int> Find(const std::string& regex) const;
+
+  // Compiles all regular expressions added so far.
+  // Returns an error if they need more memory than allowed.
+  absl::Status Compile();
+
+  bool IsCompiled() const { return regex_set_ != nullptr; }
+
+  // Sets 'matches' to the indices of all regular expressions that match
+  // 'text'.  Requires IsCompiled().
+  void Match(absl::string_view text, std::vector<int>* matches) const;
+
+ private:
+  // Index of each regular expression in the order it was added.
+  std::map<std::string, int> regex_index_;
+
+  std::unique_ptr<RE2::Set> regex_set_;
+};
+
 // LintWaiver maintains a set of line ranges per lint rule that should be
 // exempt from each rule.
 class LintWaiver {
-  using RegexVector = std::vector<const std::regex*>;
-
  public:
   LintWaiver() {}
 
@@ -55,12 +95,24 @@ class LintWaiver {
   void WaiveLineRange(absl::string_view rule_name, int line_begin,
                       int line_end);
 
-  // Adds a regular expression which will be used to apply a waiver.
-  void WaiveWithRegex(absl::string_view rule_name, const std::string& regex);
+  // Adds a regular expression (RE2 syntax) which will be used to apply a
+  // waiver to every line that it matches.
+  // Returns an error if the regular expression is invalid.
+  absl::Status WaiveWithRegex(absl::string_view rule_name,
+                              const std::string& regex);
+
+  // Same as above, but with the regular expression at 'index' in an already
+  // compiled set, which may be shared among many waivers.
+  void WaiveWithRegex(absl::string_view rule_name,
+                      std::shared_ptr<const WaiverRegexSet> regex_set,
+                      int index);
 
   // Converts the prepared regular expressions to line numbers and applies the
-  // waivers.
-  void RegexToLines(absl::string_view content, const LineColumnMap& line_map);
+  // waivers.  All regular expressions of a set are matched together, in a
+  // single pass over the lines of 'content'.
+  // Returns an error if the regular expressions can't be compiled.
+  absl::Status RegexToLines(absl::string_view content,
+                            const LineColumnMap& line_map);
 
   // Returns true if `line_number` should be waived for a particular rule.
   bool RuleIsWaivedOnLine(absl::string_view rule_name, int line_number) const;
@@ -83,11 +135,79 @@ class LintWaiver {
   // Keys in the maps below are the names of the waived rules. They can be
   // string_view because the static strings for each lint rule class exist,
   // and will outlive all LintWaiver objects. This applies to both waiver_map_
-  // and waiver_re_map_.
+  // and regex_waivers_.
   std::map<absl::string_view, LineNumberSet> waiver_map_;
-  std::map<absl::string_view, RegexVector> waiver_re_map_;
 
-  std::map<std::string, std::regex> regex_cache_;
+  // A set of regular expressions, and the rules that each one waives, keyed
+  // by its index in the set.
+  struct RegexWaivers {
+    std::shared_ptr<const WaiverRegexSet> regex_set;
+    std::map<int, std::vector<absl::string_view>> rules;
+  };
+
+  // Returns the waivers of 'regex_set', adding them if they are new.
+  RegexWaivers& GetRegexWaivers(const WaiverRegexSet* regex_set);
+
+  // Waivers of each set of regular expressions, in the order they were first
+  // given.
+  std::vector<RegexWaivers> regex_waivers_;
+
+  // Regular expressions given to WaiveWithRegex() by string, compiled on first
+  // use by RegexToLines().
+  std::shared_ptr<WaiverRegexSet> own_regex_set_;
+};
+
+// ExternalWaiverFile holds the lexed commands of an external waiver
+// configuration file.  Lexing is done once, after which the same commands can
+// be applied to any number of linted files with
+// LintWaiverBuilder::ApplyExternalWaivers().
+class ExternalWaiverFile {
+ public:
+  ExternalWaiverFile(absl::string_view filename, std::string content);
+
+  // Not copyable or movable: tokens point into owned content.
+  ExternalWaiverFile(const ExternalWaiverFile&) = delete;
+  ExternalWaiverFile& operator=(const ExternalWaiverFile&) = delete;
+
+  absl::string_view Filename() const { return filename_; }
+
+  absl::string_view Contents() const { return content_; }
+
+  const LineColumnMap& GetLineColumnMap() const { return line_map_; }
+
+  // Returns one token range per command (including its terminating newline),
+  // in file order.
+  std::vector<TokenRange> Commands() const;
+
+  // Returns the regular expressions of all --regex arguments, compiled once
+  // for all linted files.
+  const std::shared_ptr<const WaiverRegexSet>& GetRegexSet() const {
+    return regex_set_;
+  }
+
+  // Returns the index of 'regex' in GetRegexSet(), or the error from adding or
+  // compiling it.
+  absl::StatusOr<int> FindRegex(const std::string& regex) const;
+
+ private:
+  const std::string filename_;
+
+  const std::string content_;
+
+  const LineColumnMap line_map_;
+
+  // Tokens of all commands.
+  TokenSequence tokens_;
+
+  // [begin, end) offsets into tokens_ of each command.
+  std::vector<std::pair<size_t, size_t>> command_bounds_;
+
+  std::shared_ptr<const WaiverRegexSet> regex_set_;
+
+  // Errors of regular expressions that could not be added to regex_set_, or
+  // of compiling it.
+  std::map<std::string, absl::Status> regex_errors_;
+  absl::Status compile_status_;
 };
 
 // LintWaiverBuilder is a language-agnostic helper class for constructing
@@ -134,7 +254,8 @@ class LintWaiverBuilder {
   // Takes a lexically analyzed text structure and determines the entire set of
   // waived lines.  This can be more easily unit-tested using
   // TextStructureTokenized from text_structure_test_utils.h.
-  void ProcessTokenRangesByLine(const TextStructureView&);
+  // Returns an error if regular expression waivers could not be applied.
+  absl::Status ProcessTokenRangesByLine(const TextStructureView&);
 
   // Takes a set of active linter rules and the affected filename to be linted,
   // and applies waivers from waiver_filename and its content.
@@ -143,6 +264,13 @@ class LintWaiverBuilder {
       absl::string_view lintee_filename, absl::string_view waiver_filename,
       absl::string_view waivers_config_content);
 
+  // Same as above, but applies waivers from an already lexed waiver file,
+  // which may be shared among many linted files.
+  absl::Status ApplyExternalWaivers(
+      const std::set<absl::string_view>& active_rules,
+      absl::string_view lintee_filename,
+      const ExternalWaiverFile& waiver_file);
+
   const LintWaiver& GetLintWaiver() const { return lint_waiver_; }
 
  protected:
@@ -764,6 +764,65 @@ TEST_F(LintWaiverBuilderTest, LocationOptionNarrowsTestedFile) {
   EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("abc", 299));   // matching loc
 }
 
+TEST_F(LintWaiverBuilderTest, ExternalWaiverFileSharedAmongLintees) {
+  const std::set<absl::string_view> active_rules{"abc"};
+  const ExternalWaiverFile waiver_file("waive_file.config", R"(
+    waive --rule=abc --line=100
+    waive --rule=abc --line=200 --location=".*foo.*"
+)");
+  EXPECT_EQ(waiver_file.Commands().size(), 2);
+
+  // Applying a lexed file leaves it unchanged, for use with other files.
+  EXPECT_OK(ApplyExternalWaivers(active_rules, "bar.sv", waiver_file));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("abc", 99));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("abc", 199));
+
+  EXPECT_OK(ApplyExternalWaivers(active_rules, "foo.sv", waiver_file));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("abc", 199));
+  EXPECT_EQ(waiver_file.Commands().size(), 2);
+}
+
+TEST_F(LintWaiverBuilderTest, ExternalWaiverFileRegexSharedAmongLintees) {
+  const std::set<absl::string_view> active_rules{"abc"};
+  const ExternalWaiverFile waiver_file("waive_file.config", R"(
+    waive --rule=abc --regex=def --location=".*foo.*"
+    waive --rule=abc --regex="[0-9]"
+)");
+  const absl::string_view file = "abc\ndef\ng2hi\n";
+  const LineColumnMap line_map(file);
+
+  // The compiled regexes are shared, but only those whose location matches
+  // are applied.
+  EXPECT_OK(ApplyExternalWaivers(active_rules, "bar.sv", waiver_file));
+  EXPECT_OK(lint_waiver_.RegexToLines(file, line_map));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("abc", 1));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("abc", 2));
+
+  LintWaiver foo_waiver;
+  EXPECT_OK(foo_waiver.WaiveWithRegex("abc", "a"));
+  foo_waiver.WaiveWithRegex("abc", waiver_file.GetRegexSet(),
+                            *waiver_file.FindRegex("def"));
+  EXPECT_OK(foo_waiver.RegexToLines(file, line_map));
+  EXPECT_TRUE(foo_waiver.RuleIsWaivedOnLine("abc", 0));
+  EXPECT_TRUE(foo_waiver.RuleIsWaivedOnLine("abc", 1));
+  EXPECT_FALSE(foo_waiver.RuleIsWaivedOnLine("abc", 2));
+}
+
+TEST(LintWaiverTest, WaiveWithInvalidRegex) {
+  LintWaiver waiver;
+  EXPECT_FALSE(waiver.WaiveWithRegex("abc", "[0-9").ok());
+  EXPECT_OK(waiver.WaiveWithRegex("abc", "[0-9]"));
+  const absl::string_view file = "abc\n123\n";
+  EXPECT_OK(waiver.RegexToLines(file, LineColumnMap(file)));
+  EXPECT_FALSE(waiver.RuleIsWaivedOnLine("abc", 0));
+  EXPECT_TRUE(waiver.RuleIsWaivedOnLine("abc", 1));
+
+  // Regexes added after matching are compiled on next use.
+  EXPECT_OK(waiver.WaiveWithRegex("abc", "b"));
+  EXPECT_OK(waiver.RegexToLines(file, LineColumnMap(file)));
+  EXPECT_TRUE(waiver.RuleIsWaivedOnLine("abc", 0));
+}
+
 TEST_F(LintWaiverBuilderTest, RegexToLinesSimple) {
   const std::set<absl::string_view> active_rules{"rule-1"};
   const absl::string_view user_file = "filename";
@@ -775,7 +834,7 @@ TEST_F(LintWaiverBuilderTest, RegexToLinesSimple) {
   const absl::string_view file = "abc\ndef\nghi\n";
   const LineColumnMap line_map(file);
 
-  lint_waiver_.RegexToLines(file, line_map);
+  EXPECT_OK(lint_waiver_.RegexToLines(file, line_map));
 
   // The rule should be waived on the second line only (0-based indexing)
   EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 0));
@@ -794,7 +853,7 @@ TEST_F(LintWaiverBuilderTest, RegexToLinesCatchAll) {
   const absl::string_view file = "abc\ndef\nghi\n";
   const LineColumnMap line_map(file);
 
-  lint_waiver_.RegexToLines(file, line_map);
+  EXPECT_OK(lint_waiver_.RegexToLines(file, line_map));
 
   // The rule should be waived on all lines
   EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 0));
@@ -813,7 +872,7 @@ TEST_F(LintWaiverBuilderTest, RegexToLinesMultipleMatches) {
   const absl::string_view file = "abc1\ndef\ng2hi\n";
   const LineColumnMap line_map(file);
 
-  lint_waiver_.RegexToLines(file, line_map);
+  EXPECT_OK(lint_waiver_.RegexToLines(file, line_map));
 
   // The rule should be waived on all lines that contain any digits
   EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 0));
@@ -821,5 +880,51 @@ TEST_F(LintWaiverBuilderTest, RegexToLinesMultipleMatches) {
   EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 2));
 }
 
+TEST_F(LintWaiverBuilderTest, RegexToLinesAnchorsMatchEachLine) {
+  const std::set<absl::string_view> active_rules{"rule-1"};
+  const absl::string_view user_file = "filename";
+  const absl::string_view cfg_file = "waive_file.config";
+
+  const absl::string_view cfg_regex =
+      "waive --rule=rule-1 --regex=\"^ *def$\"";
+  EXPECT_OK(ApplyExternalWaivers(active_rules, user_file, cfg_file, cfg_regex));
+
+  const absl::string_view file = "abc\n  def\ndefg\n";
+  const LineColumnMap line_map(file);
+
+  EXPECT_OK(lint_waiver_.RegexToLines(file, line_map));
+
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 0));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 1));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 2));
+}
+
+TEST_F(LintWaiverBuilderTest, RegexToLinesManyRulesAndRegexes) {
+  const std::set<absl::string_view> active_rules{"rule-1", "rule-2"};
+  const absl::string_view user_file = "filename";
+  const absl::string_view cfg_file = "waive_file.config";
+
+  const absl::string_view cfg_regex =
+      "waive --rule=rule-1 --regex=abc\n"
+      "waive --rule=rule-2 --regex=abc\n"
+      "waive --rule=rule-1 --regex=\"g.i\"\n"
+      "waive --rule=rule-2 --regex=xyz\n";
+  EXPECT_OK(ApplyExternalWaivers(active_rules, user_file, cfg_file, cfg_regex));
+
+  const absl::string_view file = "abc\ndef\nghi\nxyz";
+  const LineColumnMap line_map(file);
+
+  EXPECT_OK(lint_waiver_.RegexToLines(file, line_map));
+
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 0));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 0));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 1));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 1));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 2));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 2));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 3));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 3));
+}
+
 }  // namespace
 }  // namespace verible
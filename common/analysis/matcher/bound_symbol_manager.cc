@@ -14,33 +14,152 @@
 
 #include "common/analysis/matcher/bound_symbol_manager.h"
 
+#include <deque>
 #include <map>
 #include <string>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "common/text/symbol.h"
-#include "common/util/container_util.h"
 #include "common/util/logging.h"
 
-using verible::container::FindOrNull;
-
 namespace verible {
 namespace matcher {
 
-bool BoundSymbolManager::ContainsSymbol(const std::string& id) const {
-  return bound_symbols_.find(id) != bound_symbols_.end();
+namespace {
+// Registry of interned bind id names.
+// Interned names never change, so each thread keeps a copy of the entries it
+// has used, and only takes the lock for names it has not seen before.  This
+// keeps lookups by name, which happen on every match, free of contention.
+class BindIdRegistry {
+ public:
+  BindId Intern(absl::string_view name) {
+    LocalEntries& local = Local();
+    auto found = local.ids.find(name);
+    if (found != local.ids.end()) return found->second;
+    BindId id;
+    {
+      absl::MutexLock lock(&lock_);
+      auto interned = ids_.find(name);
+      if (interned != ids_.end()) {
+        id = interned->second;
+      } else {
+        id = names_.size();
+        names_.emplace_back(name);
+        // Keys refer to the stable strings in names_.
+        ids_.emplace(names_.back(), id);
+      }
+    }
+    local.ids.emplace(Name(id), id);
+    return id;
+  }
+
+  BindId Find(absl::string_view name) {
+    LocalEntries& local = Local();
+    auto found = local.ids.find(name);
+    if (found != local.ids.end()) return found->second;
+    BindId id;
+    {
+      absl::MutexLock lock(&lock_);
+      auto interned = ids_.find(name);
+      // Names that are not interned yet may be later, so they aren't cached.
+      if (interned == ids_.end()) return -1;
+      id = interned->second;
+    }
+    local.ids.emplace(Name(id), id);
+    return id;
+  }
+
+  const std::string& Name(BindId id) {
+    CHECK_GE(id, 0);
+    LocalEntries& local = Local();
+    if (id < static_cast<BindId>(local.names.size()) &&
+        local.names[id] != nullptr) {
+      return *local.names[id];
+    }
+    const std::string* name;
+    {
+      absl::MutexLock lock(&lock_);
+      CHECK_LT(id, static_cast<BindId>(names_.size()));
+      name = &names_[id];
+    }
+    if (id >= static_cast<BindId>(local.names.size())) {
+      local.names.resize(id + 1, nullptr);
+    }
+    local.names[id] = name;
+    return *name;
+  }
+
+ private:
+  // This thread's copy of the registry entries it has used.
+  // Keys and names refer to the stable strings in names_.
+  struct LocalEntries {
+    absl::flat_hash_map<absl::string_view, BindId> ids;
+    std::vector<const std::string*> names;  // indexed by id, null if unused
+  };
+
+  // The registry is a singleton, so the entries of each thread are too.
+  static LocalEntries& Local() {
+    static thread_local LocalEntries entries;
+    return entries;
+  }
+
+  absl::Mutex lock_;
+  // Interned names, indexed by id.  A deque never moves its elements.
+  std::deque<std::string> names_ ABSL_GUARDED_BY(lock_);
+  absl::flat_hash_map<absl::string_view, BindId> ids_ ABSL_GUARDED_BY(lock_);
+};
+
+BindIdRegistry& GetBindIdRegistry() {
+  static auto* registry = new BindIdRegistry();
+  return *registry;
+}
+}  // namespace
+
+BindId InternBindId(absl::string_view name) {
+  return GetBindIdRegistry().Intern(name);
+}
+
+BindId FindBindId(absl::string_view name) {
+  return GetBindIdRegistry().Find(name);
+}
+
+const std::string& BindIdName(BindId id) {
+  return GetBindIdRegistry().Name(id);
 }
 
 const Symbol* BoundSymbolManager::FindSymbol(const std::string& id) const {
-  auto result = FindOrNull(bound_symbols_, id);
-  if (result)
-    return *result;
-  else
-    return nullptr;
+  if (bound_symbols_.empty()) return nullptr;
+  return FindSymbol(FindBindId(id));
+}
+
+const Symbol* BoundSymbolManager::FindSymbol(BindId id) const {
+  for (const auto& bound : bound_symbols_) {
+    if (bound.first == id) return bound.second;
+  }
+  return nullptr;
+}
+
+void BoundSymbolManager::BindSymbol(BindId id, const Symbol* symbol) {
+  CHECK(symbol != nullptr);
+  for (auto& bound : bound_symbols_) {
+    if (bound.first == id) {
+      bound.second = symbol;
+      return;
+    }
+  }
+  bound_symbols_.emplace_back(id, symbol);
 }
 
-void BoundSymbolManager::BindSymbol(const std::string& id,
-                                    const Symbol* symbol) {
-  bound_symbols_[id] = ABSL_DIE_IF_NULL(symbol);
+std::map<std::string, const Symbol*> BoundSymbolManager::GetBoundMap() const {
+  std::map<std::string, const Symbol*> result;
+  for (const auto& bound : bound_symbols_) {
+    result.emplace(BindIdName(bound.first), bound.second);
+  }
+  return result;
 }
 
 }  // namespace matcher
@@ -17,15 +17,33 @@
 
 #include <map>
 #include <string>
+#include <utility>
 
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
 #include "common/text/symbol.h"
 #include "common/util/casts.h"
 
 namespace verible {
 namespace matcher {
 
+// Bind ids are interned as small integers, so that binding and looking up
+// symbols during matching neither copies nor compares strings.
+using BindId = int;
+
+// Returns the id of 'name', interning it on first use.
+// Ids are never released.  This is thread-safe.
+BindId InternBindId(absl::string_view name);
+
+// Returns the id of 'name', or -1 if it was never interned.
+BindId FindBindId(absl::string_view name);
+
+// Returns the name of an interned id.
+const std::string& BindIdName(BindId id);
+
 // Manages sets of Bound Symbols created when matching against a syntax tree.
-// Currently is just a simply wrapper around std::map
+// Matchers only bind a handful of symbols, so these are kept in a small
+// inline vector that is cheap to copy for backtracking.
 //
 // TODO(jeremycs): evolve this to allow easier backtracking from
 //   partial/pending matches, that can occur with operators like AllOf().
@@ -36,21 +54,26 @@ namespace matcher {
 class BoundSymbolManager {
  public:
   // True if id is in bound_symbols. False otherwise.
-  bool ContainsSymbol(const std::string& id) const;
+  bool ContainsSymbol(const std::string& id) const {
+    return FindSymbol(id) != nullptr;
+  }
 
   // If id is in bound_symbols, return matching Symbol*.
   // Otherwise, returns nullptr.
   const Symbol* FindSymbol(const std::string& id) const;
+  const Symbol* FindSymbol(BindId id) const;
 
   // Adds symbol to bound_symbols with id as key.
-  void BindSymbol(const std::string& id, const Symbol* symbol);
+  void BindSymbol(const std::string& id, const Symbol* symbol) {
+    BindSymbol(InternBindId(id), symbol);
+  }
+  void BindSymbol(BindId id, const Symbol* symbol);
 
   void Clear() { bound_symbols_.clear(); }
   int Size() const { return bound_symbols_.size(); }
 
-  const std::map<std::string, const Symbol*>& GetBoundMap() const {
-    return bound_symbols_;
-  }
+  // Returns the bound symbols keyed by name.
+  std::map<std::string, const Symbol*> GetBoundMap() const;
 
   template <typename T>
   const T* GetAs(const std::string& key) const {
@@ -58,7 +81,8 @@ class BoundSymbolManager {
   }
 
  private:
-  std::map<std::string, const Symbol*> bound_symbols_;
+  // Bound symbols, in the order their ids were first bound.
+  absl::InlinedVector<std::pair<BindId, const Symbol*>, 4> bound_symbols_;
 };
 
 }  // namespace matcher
@@ -0,0 +1,116 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/matcher/bound_symbol_manager.h"
+
+#include <map>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "common/text/symbol.h"
+#include "common/text/tree_builder_test_util.h"
+
+namespace verible {
+namespace matcher {
+namespace {
+
+TEST(BindIdTest, InternIsStable) {
+  const BindId id = InternBindId("bind-id-test-a");
+  EXPECT_EQ(InternBindId("bind-id-test-a"), id);
+  EXPECT_NE(InternBindId("bind-id-test-b"), id);
+  EXPECT_EQ(FindBindId("bind-id-test-a"), id);
+  EXPECT_EQ(BindIdName(id), "bind-id-test-a");
+}
+
+TEST(BindIdTest, FindUninterned) {
+  EXPECT_EQ(FindBindId("bind-id-test-never-interned"), -1);
+}
+
+// Tests that threads agree on the ids of names that they intern concurrently,
+// including names that other threads interned first.
+TEST(BindIdTest, ConcurrentIntern) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumNames = 50;
+  std::vector<std::vector<BindId>> ids(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([t, &ids]() {
+      for (int i = 0; i < kNumNames; ++i) {
+        const std::string name = "bind-id-test-concurrent-" + std::to_string(i);
+        const BindId id = InternBindId(name);
+        EXPECT_EQ(FindBindId(name), id);
+        EXPECT_EQ(BindIdName(id), name);
+        ids[t].push_back(id);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (int t = 1; t < kNumThreads; ++t) {
+    EXPECT_EQ(ids[t], ids[0]);
+  }
+}
+
+TEST(BoundSymbolManagerTest, BindAndFind) {
+  auto leaf1 = XLeaf(1);
+  auto leaf2 = XLeaf(2);
+  BoundSymbolManager manager;
+  EXPECT_EQ(manager.Size(), 0);
+  EXPECT_EQ(manager.FindSymbol("x"), nullptr);
+  EXPECT_FALSE(manager.ContainsSymbol("x"));
+
+  manager.BindSymbol("x", leaf1.get());
+  manager.BindSymbol(InternBindId("y"), leaf2.get());
+  EXPECT_EQ(manager.Size(), 2);
+  EXPECT_TRUE(manager.ContainsSymbol("x"));
+  EXPECT_EQ(manager.FindSymbol("x"), leaf1.get());
+  EXPECT_EQ(manager.FindSymbol(InternBindId("x")), leaf1.get());
+  EXPECT_EQ(manager.GetAs<Symbol>("y"), leaf2.get());
+  EXPECT_EQ(manager.FindSymbol("z"), nullptr);
+
+  const std::map<std::string, const Symbol*> expected{{"x", leaf1.get()},
+                                                      {"y", leaf2.get()}};
+  EXPECT_EQ(manager.GetBoundMap(), expected);
+
+  manager.Clear();
+  EXPECT_EQ(manager.Size(), 0);
+  EXPECT_EQ(manager.FindSymbol("x"), nullptr);
+}
+
+TEST(BoundSymbolManagerTest, RebindReplaces) {
+  auto leaf1 = XLeaf(1);
+  auto leaf2 = XLeaf(2);
+  BoundSymbolManager manager;
+  manager.BindSymbol("x", leaf1.get());
+  manager.BindSymbol("x", leaf2.get());
+  EXPECT_EQ(manager.Size(), 1);
+  EXPECT_EQ(manager.FindSymbol("x"), leaf2.get());
+}
+
+TEST(BoundSymbolManagerTest, CopyIsIndependent) {
+  auto leaf1 = XLeaf(1);
+  auto leaf2 = XLeaf(2);
+  BoundSymbolManager manager;
+  manager.BindSymbol("x", leaf1.get());
+  const BoundSymbolManager checkpoint(manager);
+  manager.BindSymbol("x", leaf2.get());
+  manager.BindSymbol("y", leaf2.get());
+  EXPECT_EQ(checkpoint.Size(), 1);
+  EXPECT_EQ(checkpoint.FindSymbol("x"), leaf1.get());
+}
+
+}  // namespace
+}  // namespace matcher
+}  // namespace verible
@@ -53,9 +53,7 @@ Matcher AllOf(Args&&... args) {
                 "AllOf requires at least one inner matcher");
 
   // AllOf matcher's behavior is completely determined by its inner_matchers
-  auto predicate = [](const Symbol& symbol) { return true; };
-
-  Matcher matcher(predicate, InnerMatchAll);
+  Matcher matcher(nullptr, InnerMatchAll);
 
   matcher.AddMatchers(std::forward<Args>(args)...);
 
@@ -93,9 +91,7 @@ Matcher AnyOf(Args&&... args) {
                 "AnyOf requires at least one inner matcher");
 
   // AnyOf matcher's behavior is completely determined by its inner_matchers.
-  auto predicate = [](const Symbol& symbol) { return true; };
-
-  Matcher matcher(predicate, InnerMatchAny);
+  Matcher matcher(nullptr, InnerMatchAny);
 
   matcher.AddMatchers(std::forward<Args>(args)...);
 
@@ -132,9 +128,7 @@ Matcher EachOf(Args&&... args) {
                 "EachOf requires at least one inner matcher");
 
   // EachOf matcher's behavior is completely determined by its inner_matchers.
-  auto predicate = [](const Symbol& symbol) { return true; };
-
-  Matcher matcher(predicate, InnerMatchEachOf);
+  Matcher matcher(nullptr, InnerMatchEachOf);
 
   matcher.AddMatchers(std::forward<Args>(args)...);
 
@@ -160,9 +154,7 @@ Matcher EachOf(Args&&... args) {
 template <typename... Args>
 Matcher Unless(const Matcher& inner_matcher) {
   // Unless matcher's behavior is completely determined by its inner_matcher.
-  auto predicate = [](const Symbol& symbol) { return true; };
-
-  Matcher matcher(predicate, InnerMatchUnless);
+  Matcher matcher(nullptr, InnerMatchUnless);
 
   matcher.AddMatchers(inner_matcher);
 
@@ -25,6 +25,7 @@ namespace matcher {
 bool InnerMatchAll(const Symbol& symbol,
                    const std::vector<Matcher>& inner_matchers,
                    BoundSymbolManager* manager) {
+  if (inner_matchers.empty()) return true;
   BoundSymbolManager backtrack_checkpoint(*manager);
 
   for (const auto& matcher : inner_matchers) {
@@ -15,7 +15,6 @@
 // Implementation of matcher.h
 #include "common/analysis/matcher/matcher.h"
 
-#include <optional>
 #include <vector>
 
 #include "common/analysis/matcher/bound_symbol_manager.h"
@@ -25,35 +24,46 @@ namespace verible {
 namespace matcher {
 
 bool Matcher::Matches(const Symbol& symbol, BoundSymbolManager* manager) const {
-  if (predicate_(symbol)) {
-    // If this matcher matches (as in, predicate succeeds), test inner matchers
-    // to see if they also match.
+  // Reject symbols with the wrong tag without calling the predicate.
+  if (required_tag_.has_value() && symbol.Tag() != *required_tag_) {
+    return false;
+  }
+  if (predicate_ && !predicate_(symbol)) return false;
 
-    // Get set of symbols to try inner matchers on.
-    auto next_targets = transformer_(symbol);
+  // If this matcher matches (as in, predicate succeeds), test inner matchers
+  // to see if they also match.
+  if (!transformer_) {
+    // Try inner matchers on the symbol itself.
+    const bool inner_match_result =
+        inner_match_handler_(symbol, inner_matchers_, manager);
+    if (inner_match_result && manager && bind_id_)
+      manager->BindSymbol(*bind_id_, &symbol);
+    return inner_match_result;
+  }
 
-    // If we failed to fnd any next targets, we can't proceed.
-    if (next_targets.empty()) return false;
+  // Get set of symbols to try inner matchers on.
+  const auto next_targets = transformer_(symbol);
 
-    // If any target matches, this is set to true.
-    bool any_target_matches = false;
+  // If we failed to fnd any next targets, we can't proceed.
+  if (next_targets.empty()) return false;
 
-    // TODO(jeremycs): add branching match groups here
+  // If any target matches, this is set to true.
+  bool any_target_matches = false;
 
-    // Try to match inner matches to every target symbol.
-    for (const auto& target_symbol : next_targets) {
-      if (!target_symbol) continue;
-      bool inner_match_result =
-          inner_match_handler_(*target_symbol, inner_matchers_, manager);
-      if (inner_match_result && manager && bind_id_)
-        manager->BindSymbol(bind_id_.value(), target_symbol);
+  // TODO(jeremycs): add branching match groups here
 
-      any_target_matches |= inner_match_result;
-    }
+  // Try to match inner matches to every target symbol.
+  for (const auto& target_symbol : next_targets) {
+    if (!target_symbol) continue;
+    bool inner_match_result =
+        inner_match_handler_(*target_symbol, inner_matchers_, manager);
+    if (inner_match_result && manager && bind_id_)
+      manager->BindSymbol(*bind_id_, target_symbol);
 
-    return any_target_matches;
+    any_target_matches |= inner_match_result;
   }
-  return false;
+
+  return any_target_matches;
 }
 
 }  // namespace matcher
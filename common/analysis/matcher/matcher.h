@@ -34,10 +34,12 @@ using SymbolPredicate = std::function<bool(const Symbol&)>;
 using SymbolTransformer =
     std::function<std::vector<const Symbol*>(const Symbol&)>;
 
-// Manages recursion on symbol for inner_matchers
-using InnerMatchHandler = std::function<bool(
-    const Symbol& symbol, const std::vector<Matcher>& inner_matchers,
-    BoundSymbolManager* manager)>;
+// Manages recursion on symbol for inner_matchers.
+// This is a plain function pointer (see inner_match_handlers.h), which is
+// cheaper to call than a type-erased function.
+using InnerMatchHandler = bool (*)(const Symbol& symbol,
+                                   const std::vector<Matcher>& inner_matchers,
+                                   BoundSymbolManager* manager);
 
 // Matcher provides an interface for creating nested tree pattern matchers.
 //
@@ -52,12 +54,18 @@ using InnerMatchHandler = std::function<bool(
 // Modeled after Clang ASTMatcher's Matcher class
 // See ASTMatchersInternal.h, class Matcher
 //
+// Matching is tuned for the common case of tag-based matchers: a required
+// tag is checked inline before any predicate, an empty predicate always
+// passes, an empty transformer passes the symbol itself to the inner matchers
+// without allocating, and bind ids are interned integers.
+//
 class Matcher {
  public:
-  Matcher(const SymbolPredicate& p, const InnerMatchHandler& handler)
+  // An empty predicate 'p' matches every symbol.
+  Matcher(const SymbolPredicate& p, InnerMatchHandler handler)
       : predicate_(p), inner_match_handler_(handler) {}
 
-  Matcher(const SymbolPredicate& p, const InnerMatchHandler& handler,
+  Matcher(const SymbolPredicate& p, InnerMatchHandler handler,
           const SymbolTransformer& t)
       : predicate_(p), inner_match_handler_(handler), transformer_(t) {}
 
@@ -78,12 +86,21 @@ class Matcher {
     AddMatchers(std::forward<Args>(args)...);
   }
 
+  // Returns the tag that every symbol matched by this must have, if known.
+  // Searches can use this to skip symbols that cannot possibly match.
+  const absl::optional<SymbolTag>& RequiredTag() const { return required_tag_; }
+
+  // Declares that this only matches symbols with the given tag.
+  // The tag is checked before predicate_.
+  void SetRequiredTag(SymbolTag tag) { required_tag_ = tag; }
+
  private:
   // Contains all inner matchers.
   std::vector<Matcher> inner_matchers_;
 
  protected:
   // Determines whether or not this matches against a given symbol.
+  // If empty, every symbol passes.
   SymbolPredicate predicate_;
 
   // Define the recursion strategy that is used for traversing inner matchers.
@@ -91,15 +108,15 @@ class Matcher {
 
   // This transformation is applied to a matched symbol before it is passed
   // to inner matchers.
-  // Default transformation does not modify symbol.
-  SymbolTransformer transformer_ =
-      [](const Symbol& symbol) -> std::vector<const Symbol*> {
-    return {&symbol};
-  };
+  // If empty (default), the symbol itself is passed to inner matchers.
+  SymbolTransformer transformer_;
 
   // If present when Matches is called, symbol will be bound to its value
   // If null_opt, then symbol will not be
-  absl::optional<std::string> bind_id_ = absl::nullopt;
+  absl::optional<BindId> bind_id_ = absl::nullopt;
+
+  // If present, this only matches symbols with this tag.
+  absl::optional<SymbolTag> required_tag_ = absl::nullopt;
 };
 
 // BindableMatcher is a subclass of matcher that enables setting
@@ -126,7 +143,7 @@ class BindableMatcher : public Matcher {
   using Matcher::Matcher;
 
   BindableMatcher& Bind(const std::string& id) {
-    bind_id_ = id;
+    bind_id_ = InternBindId(id);
     return *this;
   }
 };
@@ -84,9 +84,7 @@ class PathMatchBuilder {
     for (auto symbol_tag : path_) local_path.push_back(symbol_tag);
 
     // As long as one of the inner_matchers matches against discovered
-    // descendants, PathMatchBuilder also matches.
-    auto predicate = [](const Symbol& symbol) { return true; };
-
+    // descendants, PathMatchBuilder also matches (the predicate is empty).
     // The transformation that is performed on the symbol before it passed
     // off to the InnerMatchHandler.
     // Each descendant in returned vector is matched seperately.
@@ -95,7 +93,7 @@ class PathMatchBuilder {
       return GetAllDescendantsFromPath(symbol, local_path);
     };
 
-    BindableMatcher matcher(predicate, InnerMatchAll, transformer);
+    BindableMatcher matcher(nullptr, InnerMatchAll, transformer);
     matcher.AddMatchers(std::forward<Args>(args)...);
     return matcher;
   }
@@ -135,8 +133,9 @@ class TagMatchBuilder {
 
   template <typename... Args>
   BindableMatcher operator()(Args... args) const {
-    BindableMatcher matcher(EqualTagPredicate<Kind, EnumType, Tag>,
-                            InnerMatchAll);
+    // The required tag replaces EqualTagPredicate<Kind, EnumType, Tag>.
+    BindableMatcher matcher(nullptr, InnerMatchAll);
+    matcher.SetRequiredTag(SymbolTag{Kind, static_cast<int>(Tag)});
     matcher.AddMatchers(std::forward<Args>(args)...);
     return matcher;
   }
@@ -167,8 +166,9 @@ class DynamicTagMatchBuilder {
 
   template <typename... Args>
   BindableMatcher operator()(Args... args) const {
-    BindableMatcher matcher([this](const Symbol& s) { return s.Tag() == tag_; },
-                            InnerMatchAll);
+    // The required tag is checked by the matcher itself.
+    BindableMatcher matcher(nullptr, InnerMatchAll);
+    matcher.SetRequiredTag(tag_);
     matcher.AddMatchers(std::forward<Args>(args)...);
     return matcher;
   }
@@ -0,0 +1,113 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/syntax_tree_index.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/text/syntax_tree_context.h"
+#include "common/util/logging.h"
+
+namespace verible {
+
+// Indexes activated on this thread, most recent last.
+static thread_local std::vector<const SyntaxTreeIndex*> active_indexes;
+
+SyntaxTreeIndex::SyntaxTreeIndex(const Symbol& root) {
+  // Leaves are not indexed.
+  if (root.Kind() == SymbolKind::kNode) {
+    Add(static_cast<const SyntaxTreeNode&>(root), -1);
+  }
+}
+
+void SyntaxTreeIndex::Add(const SyntaxTreeNode& node, int parent) {
+  const int position = nodes_.size();
+  nodes_.push_back(Entry{&node, parent, 0});
+  positions_.emplace(&node, position);
+  positions_by_tag_[node.Tag().tag].push_back(position);
+  for (const auto& child : node.children()) {
+    if (child != nullptr && child->Kind() == SymbolKind::kNode) {
+      Add(static_cast<const SyntaxTreeNode&>(*child), position);
+    }
+  }
+  nodes_[position].subtree_end = nodes_.size();
+}
+
+void SyntaxTreeIndex::ForEachNodeWithTag(
+    const Symbol& root, int tag,
+    const std::function<void(const SyntaxTreeNode&, const SyntaxTreeContext&)>&
+        visit) const {
+  std::vector<const SyntaxTreeNode*> ancestors;
+  for (const int position : PositionsWithTag(root, tag)) {
+    GetAncestors(root, position, &ancestors);
+    visit(NodeAt(position), SyntaxTreeContext(ancestors));
+  }
+}
+
+absl::Span<const int> SyntaxTreeIndex::PositionsWithTag(const Symbol& root,
+                                                        int tag) const {
+  const auto root_iter = positions_.find(&root);
+  CHECK(root_iter != positions_.end());
+  const auto tagged = positions_by_tag_.find(tag);
+  if (tagged == positions_by_tag_.end()) return {};
+
+  // The subtree of the root is a contiguous range of positions.
+  const int root_position = root_iter->second;
+  const std::vector<int>& positions(tagged->second);
+  const auto begin =
+      std::lower_bound(positions.begin(), positions.end(), root_position);
+  const auto end = std::lower_bound(begin, positions.end(),
+                                    nodes_[root_position].subtree_end);
+  return absl::MakeConstSpan(positions.data() + (begin - positions.begin()),
+                             end - begin);
+}
+
+void SyntaxTreeIndex::GetAncestors(
+    const Symbol& root, int position,
+    std::vector<const SyntaxTreeNode*>* ancestors) const {
+  const auto root_iter = positions_.find(&root);
+  CHECK(root_iter != positions_.end());
+  const int root_position = root_iter->second;
+  // Collect the ancestors up to (and including) the root.
+  ancestors->clear();
+  while (position != root_position) {
+    position = nodes_[position].parent;
+    CHECK_GE(position, 0) << "Node is not in the subtree of the root.";
+    ancestors->push_back(nodes_[position].node);
+  }
+  std::reverse(ancestors->begin(), ancestors->end());
+}
+
+SyntaxTreeIndex::ScopedActivation::ScopedActivation(
+    const SyntaxTreeIndex* index) {
+  active_indexes.push_back(ABSL_DIE_IF_NULL(index));
+}
+
+SyntaxTreeIndex::ScopedActivation::~ScopedActivation() {
+  active_indexes.pop_back();
+}
+
+const SyntaxTreeIndex* SyntaxTreeIndex::FindActive(const Symbol& symbol) {
+  for (auto iter = active_indexes.rbegin(); iter != active_indexes.rend();
+       ++iter) {
+    if ((*iter)->Contains(symbol)) return *iter;
+  }
+  return nullptr;
+}
+
+}  // namespace verible
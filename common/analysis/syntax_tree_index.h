@@ -0,0 +1,121 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_INDEX_H_
+#define VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_INDEX_H_
+
+#include <functional>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/span.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/text/syntax_tree_context.h"
+
+namespace verible {
+
+// SyntaxTreeIndex maps node tags to the nodes of a syntax tree that have
+// them, in document order.  It is built in a single pass over the tree, and
+// then answers queries for the nodes with a given tag in any subtree in
+// O(matches) time (plus the depth of the matches), without re-walking the
+// tree.
+//
+// SearchSyntaxTree() automatically uses an index that is active (see
+// ScopedActivation) on the current thread and covers the searched tree.
+//
+// The indexed tree must outlive the index, and must not be modified while
+// the index is in use.  A constructed index is immutable, and can be used
+// from multiple threads.
+class SyntaxTreeIndex {
+ public:
+  // Indexes all nodes of the tree rooted at 'root'.
+  explicit SyntaxTreeIndex(const Symbol& root);
+
+  SyntaxTreeIndex(const SyntaxTreeIndex&) = delete;
+  SyntaxTreeIndex& operator=(const SyntaxTreeIndex&) = delete;
+
+  // Returns true if 'symbol' is one of the indexed nodes.
+  bool Contains(const Symbol& symbol) const {
+    return positions_.find(&symbol) != positions_.end();
+  }
+
+  // Calls 'visit' on every node with the given (node) 'tag' in the subtree
+  // rooted at 'root', including 'root' itself, in document order.
+  // Each node is given with the context of its ancestors, starting with
+  // 'root', just like TreeContextVisitor would have.
+  // 'root' must be Contains().
+  void ForEachNodeWithTag(
+      const Symbol& root, int tag,
+      const std::function<void(const SyntaxTreeNode&,
+                               const SyntaxTreeContext&)>& visit) const;
+
+  // Returns the positions of the nodes with the given (node) 'tag' in the
+  // subtree rooted at 'root', including 'root' itself, in document order.
+  // Positions are only meaningful to NodeAt() and GetAncestors().
+  // 'root' must be Contains().
+  absl::Span<const int> PositionsWithTag(const Symbol& root, int tag) const;
+
+  // Returns the node at 'position'.
+  const SyntaxTreeNode& NodeAt(int position) const {
+    return *nodes_[position].node;
+  }
+
+  // Replaces 'ancestors' with the ancestors of the node at 'position', from
+  // 'root' (included) down to its parent, like the context of the node in a
+  // TreeContextVisitor that starts at 'root'.  The node must be in the
+  // subtree rooted at 'root'.
+  void GetAncestors(const Symbol& root, int position,
+                    std::vector<const SyntaxTreeNode*>* ancestors) const;
+
+  // While in scope, makes 'index' available to FindActive() on the current
+  // thread.
+  class ScopedActivation {
+   public:
+    explicit ScopedActivation(const SyntaxTreeIndex* index);
+    ~ScopedActivation();
+
+    ScopedActivation(const ScopedActivation&) = delete;
+    ScopedActivation& operator=(const ScopedActivation&) = delete;
+  };
+
+  // Returns the most recently activated index on the current thread that
+  // contains 'symbol', or nullptr if there is none.
+  static const SyntaxTreeIndex* FindActive(const Symbol& symbol);
+
+ private:
+  struct Entry {
+    const SyntaxTreeNode* node;
+    // Position of the parent node, -1 for the root.
+    int parent;
+    // Position past the last node of this subtree.
+    int subtree_end;
+  };
+
+  // Appends 'node' and its subtree in preorder.
+  void Add(const SyntaxTreeNode& node, int parent);
+
+  // All nodes, in preorder (document order).
+  std::vector<Entry> nodes_;
+
+  // Position of every node in nodes_.
+  absl::flat_hash_map<const Symbol*, int> positions_;
+
+  // Positions of the nodes with each tag, in increasing order.
+  absl::flat_hash_map<int, std::vector<int>> positions_by_tag_;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_INDEX_H_
@@ -0,0 +1,163 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/syntax_tree_index.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/syntax_tree_context.h"
+#include "common/text/tree_builder_test_util.h"
+#include "common/text/tree_utils.h"
+
+namespace verible {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+// Returns the nodes with 'tag' under 'root', and the size of their contexts.
+std::vector<std::pair<const Symbol*, size_t>> Collect(
+    const SyntaxTreeIndex& index, const Symbol& root, int tag) {
+  std::vector<std::pair<const Symbol*, size_t>> result;
+  index.ForEachNodeWithTag(
+      root, tag,
+      [&](const SyntaxTreeNode& node, const SyntaxTreeContext& context) {
+        result.emplace_back(&node, context.size());
+      });
+  return result;
+}
+
+TEST(SyntaxTreeIndexTest, LeafRootIsNotIndexed) {
+  auto tree = XLeaf(1);
+  const SyntaxTreeIndex index(*tree);
+  EXPECT_FALSE(index.Contains(*tree));
+}
+
+TEST(SyntaxTreeIndexTest, ContainsOnlyNodes) {
+  auto tree = TNode(1, XLeaf(1), nullptr, TNode(2));
+  const SyntaxTreeIndex index(*tree);
+  const auto& node = SymbolCastToNode(*tree);
+  EXPECT_TRUE(index.Contains(*tree));
+  EXPECT_FALSE(index.Contains(*node[0]));
+  EXPECT_TRUE(index.Contains(*node[2]));
+}
+
+TEST(SyntaxTreeIndexTest, RootOnly) {
+  auto tree = TNode(1);
+  const SyntaxTreeIndex index(*tree);
+  EXPECT_THAT(Collect(index, *tree, 1),
+              ElementsAre(std::make_pair(tree.get(), 0)));
+  EXPECT_THAT(Collect(index, *tree, 2), IsEmpty());
+}
+
+TEST(SyntaxTreeIndexTest, DocumentOrderWithContext) {
+  auto tree = TNode(0,                               //
+                    TNode(1, TNode(2, TNode(1))),    //
+                    XLeaf(1),                        //
+                    TNode(3, TNode(1), TNode(2)));   //
+  const SyntaxTreeIndex index(*tree);
+  const auto& root = SymbolCastToNode(*tree);
+  const Symbol* first = root[0].get();
+  const Symbol* second = SymbolCastToNode(*first)[0].get();
+  const Symbol* nested = SymbolCastToNode(*second)[0].get();
+  const Symbol* last = SymbolCastToNode(*root[2])[0].get();
+  EXPECT_THAT(Collect(index, *tree, 1),
+              ElementsAre(std::make_pair(first, 1), std::make_pair(nested, 3),
+                          std::make_pair(last, 2)));
+}
+
+TEST(SyntaxTreeIndexTest, SubtreeQuery) {
+  auto tree = TNode(0,                             //
+                    TNode(1, TNode(2, TNode(1))),  //
+                    TNode(1));
+  const SyntaxTreeIndex index(*tree);
+  const auto& root = SymbolCastToNode(*tree);
+  const Symbol* subtree = root[0].get();
+  const Symbol* inner = SymbolCastToNode(*subtree)[0].get();
+  const Symbol* nested = SymbolCastToNode(*inner)[0].get();
+  // Context is relative to the subtree root, and excludes later siblings.
+  EXPECT_THAT(Collect(index, *subtree, 1),
+              ElementsAre(std::make_pair(subtree, 0),
+                          std::make_pair(nested, 2)));
+  EXPECT_THAT(Collect(index, *inner, 1),
+              ElementsAre(std::make_pair(nested, 1)));
+}
+
+TEST(SyntaxTreeIndexTest, ContextAncestors) {
+  auto tree = TNode(0, TNode(1, TNode(2)));
+  const SyntaxTreeIndex index(*tree);
+  const auto& root = SymbolCastToNode(*tree);
+  const auto& middle = SymbolCastToNode(*root[0]);
+  index.ForEachNodeWithTag(
+      *tree, 2, [&](const SyntaxTreeNode&, const SyntaxTreeContext& context) {
+        ASSERT_EQ(context.size(), 2);
+        EXPECT_EQ(&context.top(), &middle);
+        EXPECT_EQ(*context.begin(), &root);
+      });
+}
+
+TEST(SyntaxTreeIndexTest, PositionsWithTag) {
+  auto tree = TNode(0,                             //
+                    TNode(1, TNode(2, TNode(1))),  //
+                    TNode(1));
+  const SyntaxTreeIndex index(*tree);
+  const auto& root = SymbolCastToNode(*tree);
+  const Symbol* subtree = root[0].get();
+  const Symbol* inner = SymbolCastToNode(*subtree)[0].get();
+  const Symbol* nested = SymbolCastToNode(*inner)[0].get();
+
+  const auto positions = index.PositionsWithTag(*subtree, 1);
+  ASSERT_EQ(positions.size(), 2);
+  EXPECT_EQ(&index.NodeAt(positions[0]), subtree);
+  EXPECT_EQ(&index.NodeAt(positions[1]), nested);
+  EXPECT_EQ(index.PositionsWithTag(*tree, 1).size(), 3);
+  EXPECT_THAT(index.PositionsWithTag(*inner, 0), IsEmpty());
+  EXPECT_THAT(index.PositionsWithTag(*tree, 5), IsEmpty());
+
+  std::vector<const SyntaxTreeNode*> ancestors;
+  index.GetAncestors(*subtree, positions[1], &ancestors);
+  EXPECT_THAT(ancestors, ElementsAre(subtree, inner));
+  index.GetAncestors(*tree, positions[1], &ancestors);
+  EXPECT_THAT(ancestors, ElementsAre(tree.get(), subtree, inner));
+  index.GetAncestors(*subtree, positions[0], &ancestors);
+  EXPECT_THAT(ancestors, IsEmpty());
+}
+
+TEST(SyntaxTreeIndexTest, FindActive) {
+  auto tree1 = TNode(0, TNode(1));
+  auto tree2 = TNode(0);
+  const SyntaxTreeIndex index1(*tree1);
+  const SyntaxTreeIndex index2(*tree2);
+  EXPECT_EQ(SyntaxTreeIndex::FindActive(*tree1), nullptr);
+  {
+    const SyntaxTreeIndex::ScopedActivation activate1(&index1);
+    EXPECT_EQ(SyntaxTreeIndex::FindActive(*tree1), &index1);
+    EXPECT_EQ(SyntaxTreeIndex::FindActive(*SymbolCastToNode(*tree1)[0]),
+              &index1);
+    EXPECT_EQ(SyntaxTreeIndex::FindActive(*tree2), nullptr);
+    {
+      const SyntaxTreeIndex::ScopedActivation activate2(&index2);
+      EXPECT_EQ(SyntaxTreeIndex::FindActive(*tree1), &index1);
+      EXPECT_EQ(SyntaxTreeIndex::FindActive(*tree2), &index2);
+    }
+    EXPECT_EQ(SyntaxTreeIndex::FindActive(*tree2), nullptr);
+  }
+  EXPECT_EQ(SyntaxTreeIndex::FindActive(*tree1), nullptr);
+}
+
+}  // namespace
+}  // namespace verible
@@ -15,6 +15,8 @@
 #ifndef VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_LINT_RULE_H_
 #define VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_LINT_RULE_H_
 
+#include <vector>
+
 #include "common/analysis/lint_rule.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
@@ -26,7 +28,8 @@ namespace verible {
 // SyntaxTreeLintRule is a base class for analyzing syntax trees for lint
 // violations.  Subclasses of this can be added to a SyntaxTreeLinter and can
 // expect to have their HandleLeaf and HandleNode methods called on every
-// leaf/node in the tree that the linter is run on.
+// leaf/node in the tree that the linter is run on, or only on those with the
+// tags returned by InterestingTags().
 //
 // For usage, see linter.h
 //
@@ -43,6 +46,21 @@ class SyntaxTreeLintRule : public LintRule {
                           const SyntaxTreeContext& context) {}
   virtual void HandleSymbol(const Symbol& node,
                             const SyntaxTreeContext& context) {}
+
+  // Returns the tags of the symbols that this rule needs to handle.
+  // The linter only calls the Handle* methods on symbols with one of these
+  // tags, so rules that look for a few kinds of symbols are not called on
+  // every other symbol.  The default, an empty set, means all symbols.
+  // Rules that keep state across symbols must list every tag they depend on.
+  virtual std::vector<SymbolTag> InterestingTags() const { return {}; }
+
+  // Returns true if the findings of this rule within each child subtree of the
+  // root do not depend on what it saw in any other child subtree.  Separate
+  // instances of such a rule can analyze disjoint sets of children of the root
+  // concurrently (see SyntaxTreeLinter::LintChildren()), and their findings
+  // are merged.  This is opt-in: the default, false, is always correct, and
+  // rules whose state carries over from one symbol to the next must keep it.
+  virtual bool IsSubtreeLocal() const { return false; }
 };
 
 }  // namespace verible
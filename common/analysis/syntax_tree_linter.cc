@@ -17,6 +17,7 @@
 #include <memory>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
 #include "common/text/concrete_syntax_leaf.h"
@@ -27,12 +28,69 @@
 
 namespace verible {
 
+void SyntaxTreeLinter::RuleDispatch::Add(SyntaxTreeLintRule* rule,
+                                         const std::vector<int>& tags) {
+  if (tags.empty()) {
+    all_tags.push_back(rule);
+    for (auto& entry : by_tag) entry.second.push_back(rule);
+    return;
+  }
+  for (const int tag : tags) {
+    // A new list starts with the rules that handle every tag, which were all
+    // added before this rule.
+    auto inserted = by_tag.emplace(tag, all_tags);
+    RuleList& rules(inserted.first->second);
+    // Tolerate duplicate tags.
+    if (rules.empty() || rules.back() != rule) rules.push_back(rule);
+  }
+}
+
+const SyntaxTreeLinter::RuleList& SyntaxTreeLinter::RuleDispatch::RulesFor(
+    int tag) const {
+  const auto found = by_tag.find(tag);
+  return found != by_tag.end() ? found->second : all_tags;
+}
+
+void SyntaxTreeLinter::AddRule(std::unique_ptr<SyntaxTreeLintRule> rule) {
+  SyntaxTreeLintRule* rule_ptr = ABSL_DIE_IF_NULL(rule.get());
+  const std::vector<SymbolTag> tags = rule_ptr->InterestingTags();
+  std::vector<int> node_tags;
+  std::vector<int> leaf_tags;
+  for (const SymbolTag& tag : tags) {
+    (tag.kind == SymbolKind::kNode ? node_tags : leaf_tags).push_back(tag.tag);
+  }
+  if (tags.empty()) {
+    node_rules_.Add(rule_ptr, {});
+    leaf_rules_.Add(rule_ptr, {});
+  } else {
+    // A rule interested in only nodes (or leaves) is not added to the other.
+    if (!node_tags.empty()) node_rules_.Add(rule_ptr, node_tags);
+    if (!leaf_tags.empty()) leaf_rules_.Add(rule_ptr, leaf_tags);
+  }
+  rules_.emplace_back(std::move(rule));
+}
+
 void SyntaxTreeLinter::Lint(const Symbol& root) {
   VLOG(1) << "SyntaxTreeLinter analyzing syntax tree with " << rules_.size()
           << " rules.";
   root.Accept(this);
 }
 
+void SyntaxTreeLinter::LintChildren(const SyntaxTreeNode& root, size_t begin,
+                                    size_t end) {
+  VLOG(1) << "SyntaxTreeLinter analyzing children [" << begin << ", " << end
+          << ") of syntax tree with " << rules_.size() << " rules.";
+  CHECK(Context().empty());
+  CHECK_LE(begin, end);
+  CHECK_LE(end, root.children().size());
+  if (begin == 0) HandleNode(root);
+  const SyntaxTreeContext::AutoPop p(&current_context_, &root);
+  for (size_t i = begin; i < end; ++i) {
+    const auto& child = root.children()[i];
+    if (child) child->Accept(this);
+  }
+}
+
 std::vector<LintRuleStatus> SyntaxTreeLinter::ReportStatus() const {
   std::vector<LintRuleStatus> status;
   for (const auto& rule : rules_) {
@@ -41,27 +99,32 @@ std::vector<LintRuleStatus> SyntaxTreeLinter::ReportStatus() const {
   return status;
 }
 
-// Visits a leaf. Every held rule handles that leaf.
+// Visits a leaf. Every rule interested in its tag handles that leaf.
 void SyntaxTreeLinter::Visit(const SyntaxTreeLeaf& leaf) {
-  for (const auto& rule : rules_) {
+  for (SyntaxTreeLintRule* rule : leaf_rules_.RulesFor(leaf.Tag().tag)) {
     // Have rule handle the leaf as both a leaf and a symbol.
-    ABSL_DIE_IF_NULL(rule)->HandleLeaf(leaf, Context());
+    rule->HandleLeaf(leaf, Context());
     rule->HandleSymbol(leaf, Context());
   }
 }
 
-// Visits a node. First, linter has every rule handle that node
+// Visits a node. First, linter has every rule interested in its tag handle
+// that node.
 // Second, linter recurses on every non-null child of that node in order
 // to visit the entire tree
 void SyntaxTreeLinter::Visit(const SyntaxTreeNode& node) {
-  for (const auto& rule : rules_) {
-    // Have rule handle the node as both a node and a symbol.
-    ABSL_DIE_IF_NULL(rule)->HandleNode(node, Context());
-    rule->HandleSymbol(node, Context());
-  }
+  HandleNode(node);
 
   // Visit subtree children.
   TreeContextVisitor::Visit(node);
 }
 
+void SyntaxTreeLinter::HandleNode(const SyntaxTreeNode& node) {
+  for (SyntaxTreeLintRule* rule : node_rules_.RulesFor(node.Tag().tag)) {
+    // Have rule handle the node as both a node and a symbol.
+    rule->HandleNode(node, Context());
+    rule->HandleSymbol(node, Context());
+  }
+}
+
 }  // namespace verible
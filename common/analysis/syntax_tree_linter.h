@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
 #include "common/text/concrete_syntax_leaf.h"
@@ -46,18 +47,18 @@ namespace verible {
 //  std::vector<LintRuleStatus> status = linter.ReportStatus();
 //
 // Note that the tree is traversed in a preorder traversal.
+// Each symbol is handled only by the rules that are interested in its tag
+// (see SyntaxTreeLintRule::InterestingTags()), in the order they were added.
 //
 class SyntaxTreeLinter : public TreeContextVisitor {
  public:
-  SyntaxTreeLinter() : rules_() {}
+  SyntaxTreeLinter() = default;
 
   void Visit(const SyntaxTreeLeaf& leaf) override;
   void Visit(const SyntaxTreeNode& node) override;
 
   // Transfers ownership of rule into Linter
-  void AddRule(std::unique_ptr<SyntaxTreeLintRule> rule) {
-    rules_.emplace_back(std::move(rule));
-  }
+  void AddRule(std::unique_ptr<SyntaxTreeLintRule> rule);
 
   // Aggregates results of each held LintRule
   std::vector<LintRuleStatus> ReportStatus() const;
@@ -65,10 +66,43 @@ class SyntaxTreeLinter : public TreeContextVisitor {
   // Performs lint analysis on root
   void Lint(const Symbol& root);
 
+  // Performs lint analysis on the children of 'root' in the index range
+  // [begin, end), in the context of 'root', which must be the root of the
+  // whole tree.  'root' itself is only handled when 'begin' is 0.
+  // For subtree-local rules (see SyntaxTreeLintRule::IsSubtreeLocal()),
+  // linting consecutive ranges that cover all children with separate linters
+  // finds the same violations as Lint(root).
+  void LintChildren(const SyntaxTreeNode& root, size_t begin, size_t end);
+
  private:
+  // Has every rule interested in the tag of 'node' handle it.
+  void HandleNode(const SyntaxTreeNode& node);
+
   // List of rules that the linter is using. Rules are responsible for tracking
   // their own internal state.
   std::vector<std::unique_ptr<SyntaxTreeLintRule>> rules_;
+
+  // Rules that handle a symbol, in the order they were added.
+  using RuleList = std::vector<SyntaxTreeLintRule*>;
+
+  // Dispatch table for one kind of symbol.
+  struct RuleDispatch {
+    // Adds 'rule' for the given tags, or for all tags if 'tags' is empty.
+    void Add(SyntaxTreeLintRule* rule, const std::vector<int>& tags);
+
+    // Returns the rules that handle symbols with 'tag'.
+    const RuleList& RulesFor(int tag) const;
+
+    // Rules that handle every tag.
+    RuleList all_tags;
+
+    // Rules for tags that some rule is specifically interested in.
+    // Each list also includes all_tags rules.
+    absl::flat_hash_map<int, RuleList> by_tag;
+  };
+
+  RuleDispatch node_rules_;
+  RuleDispatch leaf_rules_;
 };
 
 }  // namespace verible
@@ -15,8 +15,10 @@
 #include "common/analysis/syntax_tree_linter.h"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "gtest/gtest.h"
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -26,6 +28,7 @@
 #include "common/text/syntax_tree_context.h"
 #include "common/text/token_info.h"
 #include "common/text/tree_builder_test_util.h"
+#include "common/text/tree_utils.h"
 
 namespace verible {
 namespace {
@@ -275,5 +278,95 @@ TEST(SyntaxTreeLinterTest, DepthSuccess) {
   EXPECT_EQ(statuses[0].violations.size(), 0);
 }
 
+// Testing rule that records the tags of the symbols it handles.
+class TagRecorder : public SyntaxTreeLintRule {
+ public:
+  explicit TagRecorder(std::vector<SymbolTag> tags,
+                       std::vector<SymbolTag>* handled)
+      : tags_(std::move(tags)), handled_(handled) {}
+
+  void HandleSymbol(const Symbol& symbol,
+                    const SyntaxTreeContext& context) override {
+    handled_->push_back(symbol.Tag());
+  }
+
+  std::vector<SymbolTag> InterestingTags() const override { return tags_; }
+
+  LintRuleStatus Report() const override { return LintRuleStatus(); }
+
+ private:
+  const std::vector<SymbolTag> tags_;
+  std::vector<SymbolTag>* handled_;
+};
+
+TEST(SyntaxTreeLinterTest, RulesHandleOnlyInterestingTags) {
+  const SymbolPtr root =
+      TNode(1, XLeaf(2), TNode(3, XLeaf(3), TNode(1)), XLeaf(4));
+  std::vector<SymbolTag> all, nodes, leaves, mixed;
+  SyntaxTreeLinter linter;
+  linter.AddRule(
+      absl::make_unique<TagRecorder>(std::vector<SymbolTag>{}, &all));
+  linter.AddRule(absl::make_unique<TagRecorder>(
+      std::vector<SymbolTag>{NodeTag(1), NodeTag(1)}, &nodes));
+  linter.AddRule(absl::make_unique<TagRecorder>(
+      std::vector<SymbolTag>{LeafTag(3)}, &leaves));
+  linter.AddRule(absl::make_unique<TagRecorder>(
+      std::vector<SymbolTag>{NodeTag(3), LeafTag(4), LeafTag(5)}, &mixed));
+  linter.Lint(*root);
+
+  EXPECT_EQ(all.size(), 6);
+  EXPECT_EQ(nodes, (std::vector<SymbolTag>{NodeTag(1), NodeTag(1)}));
+  EXPECT_EQ(leaves, (std::vector<SymbolTag>{LeafTag(3)}));
+  EXPECT_EQ(mixed, (std::vector<SymbolTag>{NodeTag(3), LeafTag(4)}));
+}
+
+TEST(SyntaxTreeLinterTest, LintChildrenShardsMatchWholeTree) {
+  constexpr absl::string_view text("abcdefg");
+  const SymbolPtr root =
+      TNode(7, Leaf(1, text.substr(0, 1)), Leaf(4, text.substr(1, 1)),
+            Node(Leaf(210, text.substr(2, 1)), Leaf(2, text.substr(3, 1))),
+            nullptr, Leaf(1, text.substr(4, 1)),
+            Node(Leaf(9, text.substr(5, 1))), Leaf(3, text.substr(6, 1)));
+  ASSERT_NE(root, nullptr);
+  const auto& root_node = SymbolCastToNode(*root);
+
+  SyntaxTreeLinter whole;
+  whole.AddRule(MakeDepth());
+  whole.Lint(*root);
+  const std::vector<LintRuleStatus> expected = whole.ReportStatus();
+  ASSERT_EQ(expected.size(), 1);
+  EXPECT_EQ(expected[0].violations.size(), 4);
+
+  const size_t num_children = root_node.children().size();
+  for (size_t split = 0; split <= num_children; ++split) {
+    SyntaxTreeLinter first, second;
+    first.AddRule(MakeDepth());
+    second.AddRule(MakeDepth());
+    first.LintChildren(root_node, 0, split);
+    second.LintChildren(root_node, split, num_children);
+    std::set<LintViolation> merged = first.ReportStatus()[0].violations;
+    const auto second_violations = second.ReportStatus()[0].violations;
+    merged.insert(second_violations.begin(), second_violations.end());
+    EXPECT_EQ(merged.size(), expected[0].violations.size()) << split;
+  }
+}
+
+TEST(SyntaxTreeLinterTest, LintChildrenHandlesRootOnlyInFirstRange) {
+  const SymbolPtr root = TNode(1, XLeaf(2), TNode(3, XLeaf(3)), XLeaf(4));
+  const auto& root_node = SymbolCastToNode(*root);
+  std::vector<SymbolTag> first_handled, second_handled;
+  SyntaxTreeLinter first, second;
+  first.AddRule(
+      absl::make_unique<TagRecorder>(std::vector<SymbolTag>{}, &first_handled));
+  second.AddRule(absl::make_unique<TagRecorder>(std::vector<SymbolTag>{},
+                                                &second_handled));
+  first.LintChildren(root_node, 0, 1);
+  second.LintChildren(root_node, 1, 3);
+
+  EXPECT_EQ(first_handled, (std::vector<SymbolTag>{NodeTag(1), LeafTag(2)}));
+  EXPECT_EQ(second_handled,
+            (std::vector<SymbolTag>{NodeTag(3), LeafTag(3), LeafTag(4)}));
+}
+
 }  // namespace
 }  // namespace verible
@@ -15,87 +15,137 @@
 #include "common/analysis/syntax_tree_search.h"
 
 #include <functional>
-#include <memory>
+#include <utility>
 #include <vector>
 
 #include "common/analysis/matcher/bound_symbol_manager.h"
 #include "common/analysis/matcher/matcher.h"
-#include "common/text/concrete_syntax_leaf.h"
+#include "common/analysis/syntax_tree_index.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
-#include "common/text/tree_context_visitor.h"
 
 namespace verible {
-namespace {
 
 using matcher::BoundSymbolManager;
 
-// SyntaxTreeSearcher collects node that match specified criteria
-// from a syntax tree.  Prefer to use the SearchSyntaxTree() function
-// over this class.
-class SyntaxTreeSearcher : public TreeContextVisitor {
- public:
-  SyntaxTreeSearcher(
-      const matcher::Matcher& m,
-      std::function<bool(const SyntaxTreeContext&)> context_predicate)
-      : matcher_(m), context_predicate_(context_predicate) {}
+TreeSearchCursor::TreeSearchCursor(const Symbol& root,
+                                   const verible::matcher::Matcher& matcher)
+    : TreeSearchCursor(root, matcher, nullptr) {}
 
-  void Search(const Symbol& root) { root.Accept(this); }
-
-  const std::vector<TreeSearchMatch> Matches() const { return matches_; }
-
- private:
-  void CheckSymbol(const Symbol&);
-  void Visit(const SyntaxTreeLeaf& leaf) override;
-  void Visit(const SyntaxTreeNode& node) override;
-
-  // Main matcher that finds a particular type of tree node.
-  const verible::matcher::Matcher matcher_;
+TreeSearchCursor::TreeSearchCursor(
+    const Symbol& root, const verible::matcher::Matcher& matcher,
+    std::function<bool(const SyntaxTreeContext&)> context_predicate)
+    : root_(&root),
+      matcher_(matcher),
+      context_predicate_(std::move(context_predicate)) {
+  // When only nodes of one tag can match, and an index of the tree is
+  // available, visit only the candidates with that tag.
+  const auto& required_tag = matcher_.RequiredTag();
+  if (required_tag.has_value() && required_tag->kind == SymbolKind::kNode) {
+    index_ = SyntaxTreeIndex::FindActive(root);
+    if (index_ != nullptr) {
+      candidates_ = index_->PositionsWithTag(root, required_tag->tag);
+      return;
+    }
+  }
+  next_child_.push_back(0);  // before the root
+}
 
-  // Predicate that further qualifies the matches of interest.
-  const std::function<bool(const SyntaxTreeContext&)> context_predicate_;
+bool TreeSearchCursor::Accepts(const Symbol& symbol) const {
+  BoundSymbolManager manager;
+  if (!matcher_.Matches(symbol, &manager)) return false;
+  return context_predicate_ == nullptr || context_predicate_(context_);
+}
 
-  // Accumulated set of matches.
-  std::vector<TreeSearchMatch> matches_;
-};
+bool TreeSearchCursor::Next() {
+  return index_ != nullptr ? NextInIndex() : NextInTree();
+}
 
-// Checks if leaf matches critera.
-void SyntaxTreeSearcher::CheckSymbol(const Symbol& symbol) {
-  BoundSymbolManager manager;
-  if (matcher_.Matches(symbol, &manager)) {
-    if (context_predicate_(Context())) {
-      matches_.push_back(TreeSearchMatch{&symbol, Context()});
+bool TreeSearchCursor::NextInTree() {
+  // Symbols are visited in preorder, like a TreeContextVisitor would, and
+  // context_ holds the ancestors of the visited symbol.
+  // Descend into the current match, if it is a node.
+  if (current_ != nullptr && current_->Kind() == SymbolKind::kNode) {
+    context_.Push(static_cast<const SyntaxTreeNode*>(current_));
+    next_child_.push_back(0);
+  }
+  current_ = nullptr;
+  while (!next_child_.empty()) {
+    size_t& next_child = next_child_.back();
+    const Symbol* symbol = nullptr;
+    if (context_.empty()) {
+      // Only the root is at the top level.
+      if (next_child++ == 0) symbol = root_;
+    } else {
+      const auto& children = Context().top().children();
+      while (symbol == nullptr && next_child < children.size()) {
+        symbol = children[next_child++].get();
+      }
+    }
+    if (symbol == nullptr) {
+      // Done with the node on top of the context.
+      next_child_.pop_back();
+      if (!context_.empty()) context_.Pop();
+      continue;
+    }
+    if (Accepts(*symbol)) {
+      current_ = symbol;
+      return true;
+    }
+    if (symbol->Kind() == SymbolKind::kNode) {
+      context_.Push(static_cast<const SyntaxTreeNode*>(symbol));
+      next_child_.push_back(0);
     }
   }
-}
-//
-// Checks if leaf matches critera.
-void SyntaxTreeSearcher::Visit(const SyntaxTreeLeaf& leaf) {
-  CheckSymbol(leaf);
+  return false;
 }
 
-// Checks if node matches criteria.
-// Then recursively search subtree.
-void SyntaxTreeSearcher::Visit(const SyntaxTreeNode& node) {
-  CheckSymbol(node);
-  TreeContextVisitor::Visit(node);
+bool TreeSearchCursor::NextInIndex() {
+  current_ = nullptr;
+  while (!candidates_.empty()) {
+    const int position = candidates_.front();
+    candidates_.remove_prefix(1);
+    const SyntaxTreeNode& node = index_->NodeAt(position);
+    BoundSymbolManager manager;
+    if (!matcher_.Matches(node, &manager)) continue;
+    // Only the context of nodes that match is reconstructed.
+    index_->GetAncestors(*root_, position, &ancestors_);
+    while (!context_.empty()) context_.Pop();
+    for (const SyntaxTreeNode* ancestor : ancestors_) context_.Push(ancestor);
+    if (context_predicate_ == nullptr || context_predicate_(context_)) {
+      current_ = &node;
+      return true;
+    }
+  }
+  return false;
 }
 
-}  // namespace
-
 std::vector<TreeSearchMatch> SearchSyntaxTree(
     const Symbol& root, const verible::matcher::Matcher& matcher,
     std::function<bool(const SyntaxTreeContext&)> context_predicate) {
-  SyntaxTreeSearcher searcher(matcher, context_predicate);
-  searcher.Search(root);
-  return searcher.Matches();
+  std::vector<TreeSearchMatch> matches;
+  TreeSearchCursor cursor(root, matcher, std::move(context_predicate));
+  while (cursor.Next()) matches.push_back(cursor.ToTreeSearchMatch());
+  return matches;
 }
 
 std::vector<TreeSearchMatch> SearchSyntaxTree(
     const Symbol& root, const verible::matcher::Matcher& matcher) {
-  return SearchSyntaxTree(root, matcher,
-                          [](const SyntaxTreeContext&) { return true; });
+  return SearchSyntaxTree(root, matcher, nullptr);
+}
+
+TreeSearchRange SearchSyntaxTreeLazily(
+    const Symbol& root, const verible::matcher::Matcher& matcher,
+    std::function<bool(const SyntaxTreeContext&)> context_predicate) {
+  return TreeSearchRange(root, matcher, std::move(context_predicate));
+}
+
+const Symbol* FindFirstMatch(
+    const Symbol& root, const verible::matcher::Matcher& matcher,
+    std::function<bool(const SyntaxTreeContext&)> context_predicate) {
+  TreeSearchCursor cursor(root, matcher, std::move(context_predicate));
+  return cursor.Next() ? &cursor.Match() : nullptr;
 }
 
 }  // namespace verible
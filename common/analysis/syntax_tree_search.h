@@ -15,10 +15,16 @@
 #ifndef VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_SEARCH_H_
 #define VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_SEARCH_H_
 
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <utility>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "common/analysis/matcher/matcher.h"
+#include "common/analysis/syntax_tree_index.h"
+#include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 
@@ -43,6 +49,8 @@ struct TreeSearchMatch {
 // SearchSyntaxTree collects nodes that match the specified criteria into a
 // vector.  This is useful for analyses that need to look at a collection
 // of related nodes together, rather than as each one is encountered.
+// To look at each match only once, or to stop at the first one, prefer
+// SearchSyntaxTreeLazily() or FindFirstMatch(), which do not copy contexts.
 std::vector<TreeSearchMatch> SearchSyntaxTree(
     const Symbol& root, const verible::matcher::Matcher& matcher,
     std::function<bool(const SyntaxTreeContext&)> context_predicate);
@@ -51,6 +59,162 @@ std::vector<TreeSearchMatch> SearchSyntaxTree(
 std::vector<TreeSearchMatch> SearchSyntaxTree(
     const Symbol& root, const verible::matcher::Matcher& matcher);
 
+// TreeSearchCursor finds the same matches as SearchSyntaxTree(), in the same
+// order, but one at a time, so the search can stop at any match.  The
+// context of the current match is kept in a single stack that is updated as
+// the search advances, instead of being copied for every match.
+//
+// Example:
+//   TreeSearchCursor cursor(root, matcher);
+//   while (cursor.Next()) {
+//     ... cursor.Match() ... cursor.Context() ...
+//   }
+//
+// The searched tree must outlive the cursor, and must not be modified while
+// it is in use.  If an index of the tree is active when the cursor is
+// constructed (see SyntaxTreeIndex::ScopedActivation), the cursor searches
+// the index instead of walking the tree, and keeps pointers into it: then
+// the index and its ScopedActivation must outlive the cursor as well.
+class TreeSearchCursor {
+ public:
+  TreeSearchCursor(const Symbol& root,
+                   const verible::matcher::Matcher& matcher);
+
+  // A null 'context_predicate' accepts every context.
+  TreeSearchCursor(
+      const Symbol& root, const verible::matcher::Matcher& matcher,
+      std::function<bool(const SyntaxTreeContext&)> context_predicate);
+
+  // Advances to the next match.  Returns false when there are no more.
+  bool Next();
+
+  // Returns the current match.  Only valid after Next() returned true.
+  const Symbol& Match() const { return *current_; }
+
+  // Returns the ancestors of the current match, up to (and including) the
+  // root of the search.  Only valid until the next call to Next().
+  const SyntaxTreeContext& Context() const { return context_; }
+
+  // Returns a copy of the current match and its context, which remains valid
+  // after the search advances.
+  TreeSearchMatch ToTreeSearchMatch() const {
+    return TreeSearchMatch{current_, context_};
+  }
+
+ private:
+  // SyntaxTreeContext that is updated without scoped AutoPop objects.
+  class MutableContext : public SyntaxTreeContext {
+   public:
+    using SyntaxTreeContext::Pop;
+    using SyntaxTreeContext::Push;
+  };
+
+  // Returns true if 'symbol' matches, given its context.
+  bool Accepts(const Symbol& symbol) const;
+
+  // Next() that walks the tree in preorder.
+  bool NextInTree();
+
+  // Next() that only visits candidates of an index.
+  bool NextInIndex();
+
+  const Symbol* const root_;
+
+  // Main matcher that finds a particular type of tree node.
+  const verible::matcher::Matcher matcher_;
+
+  // Predicate that further qualifies the matches of interest, or null.
+  const std::function<bool(const SyntaxTreeContext&)> context_predicate_;
+
+  // The current match, or null.
+  const Symbol* current_ = nullptr;
+
+  // Ancestors of the current symbol.
+  MutableContext context_;
+
+  // When walking the tree: for every node of context_, the position of the
+  // next child to visit.  The first element is the position before the root.
+  std::vector<size_t> next_child_;
+
+  // When searching an index: the candidate nodes that are not visited yet,
+  // and a buffer for the ancestors of a candidate.
+  const SyntaxTreeIndex* index_ = nullptr;
+  absl::Span<const int> candidates_;
+  std::vector<const SyntaxTreeNode*> ancestors_;
+};
+
+// Reference to a match of a lazy search, with the same members as
+// TreeSearchMatch.  It is only valid until the search advances.
+struct TreeSearchMatchView {
+  const Symbol* match;
+  const SyntaxTreeContext& context;
+};
+
+// TreeSearchRange adapts a TreeSearchCursor to range-based for loops.
+// It can only be iterated once.  The tree, and any index that is active when
+// the range is constructed, must outlive it, like for TreeSearchCursor.
+class TreeSearchRange {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = TreeSearchMatchView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = TreeSearchMatchView;
+
+    TreeSearchMatchView operator*() const {
+      return TreeSearchMatchView{&cursor_->Match(), cursor_->Context()};
+    }
+
+    iterator& operator++() {
+      if (!cursor_->Next()) cursor_ = nullptr;
+      return *this;
+    }
+
+    bool operator==(const iterator& other) const {
+      return cursor_ == other.cursor_;
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+   private:
+    friend class TreeSearchRange;
+    explicit iterator(TreeSearchCursor* cursor) : cursor_(cursor) {}
+
+    // Null at the end.
+    TreeSearchCursor* cursor_;
+  };
+
+  TreeSearchRange(
+      const Symbol& root, const verible::matcher::Matcher& matcher,
+      std::function<bool(const SyntaxTreeContext&)> context_predicate)
+      : cursor_(root, matcher, std::move(context_predicate)) {}
+
+  // Finds the first match.
+  iterator begin() { return ++iterator(&cursor_); }
+  iterator end() { return iterator(nullptr); }
+
+ private:
+  TreeSearchCursor cursor_;
+};
+
+// Returns the matches of SearchSyntaxTree(), found lazily, as the returned
+// range is iterated.  Breaking out of the loop ends the search.
+//
+// Example:
+//   for (const auto& match : SearchSyntaxTreeLazily(root, matcher)) {
+//     ... match.match ... match.context ...
+//   }
+TreeSearchRange SearchSyntaxTreeLazily(
+    const Symbol& root, const verible::matcher::Matcher& matcher,
+    std::function<bool(const SyntaxTreeContext&)> context_predicate = nullptr);
+
+// Returns the first match of SearchSyntaxTree(), without looking any
+// further, or nullptr if there is none.
+const Symbol* FindFirstMatch(
+    const Symbol& root, const verible::matcher::Matcher& matcher,
+    std::function<bool(const SyntaxTreeContext&)> context_predicate = nullptr);
+
 }  // namespace verible
 
 #endif  // VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_SEARCH_H_
@@ -14,12 +14,16 @@
 
 #include "common/analysis/syntax_tree_search.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
+#include "common/analysis/syntax_tree_index.h"
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "common/text/tree_builder_test_util.h"
@@ -134,5 +138,163 @@ TEST(SearchSyntaxTreeTest, RootOnlyNodeMatchTruePredicate) {
   EXPECT_EQ(&SymbolCastToNode(*matches.front().match), tree.get());
 }
 
+// Expects equal matches, including their contexts.
+void ExpectSameMatches(const std::vector<TreeSearchMatch>& matches,
+                       const std::vector<TreeSearchMatch>& expected) {
+  ASSERT_EQ(matches.size(), expected.size());
+  for (size_t i = 0; i < matches.size(); ++i) {
+    EXPECT_EQ(matches[i].match, expected[i].match);
+    EXPECT_TRUE(std::equal(matches[i].context.begin(),
+                           matches[i].context.end(),
+                           expected[i].context.begin(),
+                           expected[i].context.end()));
+  }
+}
+
+// Tests that searches using an active index find the same matches, with the
+// same contexts, as searches that walk the tree.
+TEST(SearchSyntaxTreeTest, IndexedSearchMatchesTreeWalk) {
+  auto tree = Node(TNode(1, TNode(3), TNode(1, XLeaf(1), TNode(1))),
+                   Node(XLeaf(4), TNode(3, TNode(1))));
+  auto matcher_builder = NodeMatcher<1>();
+  auto matcher = matcher_builder();
+  const auto predicate = [](const SyntaxTreeContext& context) {
+    return context.size() != 2;
+  };
+  const Symbol* subtree = DescendPath(*tree, {0});
+  const auto expected = SearchSyntaxTree(*tree, matcher, predicate);
+  const auto expected_subtree = SearchSyntaxTree(*subtree, matcher);
+  ASSERT_EQ(expected.size(), 3);
+  ASSERT_EQ(expected_subtree.size(), 3);
+
+  const SyntaxTreeIndex index(*tree);
+  const SyntaxTreeIndex::ScopedActivation activate(&index);
+  ExpectSameMatches(SearchSyntaxTree(*tree, matcher, predicate), expected);
+  ExpectSameMatches(SearchSyntaxTree(*subtree, matcher), expected_subtree);
+}
+
+// Returns the matches of a TreeSearchCursor, with copies of their contexts.
+std::vector<TreeSearchMatch> CollectWithCursor(
+    const Symbol& root, const matcher::Matcher& matcher,
+    std::function<bool(const SyntaxTreeContext&)> predicate = nullptr) {
+  std::vector<TreeSearchMatch> matches;
+  TreeSearchCursor cursor(root, matcher, predicate);
+  while (cursor.Next()) {
+    matches.push_back(TreeSearchMatch{&cursor.Match(), cursor.Context()});
+  }
+  return matches;
+}
+
+// Tests that cursors find the same matches, with the same contexts, as
+// SearchSyntaxTree(), with and without an active index.
+TEST(TreeSearchCursorTest, SameAsSearchSyntaxTree) {
+  auto tree = Node(TNode(1, TNode(3), nullptr, TNode(1, XLeaf(1), TNode(1))),
+                   Node(XLeaf(4), TNode(3, TNode(1))));
+  auto node_matcher_builder = NodeMatcher<1>();
+  auto leaf_matcher_builder = LeafMatcher<1>();
+  const matcher::Matcher matchers[] = {node_matcher_builder(),
+                                       leaf_matcher_builder()};
+  const auto predicate = [](const SyntaxTreeContext& context) {
+    return context.size() != 2;
+  };
+  const Symbol* subtree = DescendPath(*tree, {0});
+  for (const auto& matcher : matchers) {
+    const auto expected = SearchSyntaxTree(*tree, matcher);
+    const auto expected_filtered = SearchSyntaxTree(*tree, matcher, predicate);
+    const auto expected_subtree = SearchSyntaxTree(*subtree, matcher);
+    ExpectSameMatches(CollectWithCursor(*tree, matcher), expected);
+    ExpectSameMatches(CollectWithCursor(*tree, matcher, predicate),
+                      expected_filtered);
+    ExpectSameMatches(CollectWithCursor(*subtree, matcher), expected_subtree);
+
+    const SyntaxTreeIndex index(*tree);
+    const SyntaxTreeIndex::ScopedActivation activate(&index);
+    ExpectSameMatches(CollectWithCursor(*tree, matcher), expected);
+    ExpectSameMatches(CollectWithCursor(*tree, matcher, predicate),
+                      expected_filtered);
+    ExpectSameMatches(CollectWithCursor(*subtree, matcher), expected_subtree);
+  }
+}
+
+// Tests a search of a single leaf.
+TEST(TreeSearchCursorTest, RootOnlyLeaf) {
+  auto tree = XLeaf(0);
+  auto matcher_builder = LeafMatcher<0>();
+  TreeSearchCursor cursor(*tree, matcher_builder());
+  ASSERT_TRUE(cursor.Next());
+  EXPECT_EQ(&cursor.Match(), tree.get());
+  EXPECT_TRUE(cursor.Context().empty());
+  EXPECT_FALSE(cursor.Next());
+  EXPECT_FALSE(cursor.Next());
+}
+
+// Tests that the context of a match is updated as the cursor advances.
+TEST(TreeSearchCursorTest, ContextFollowsMatches) {
+  auto tree = TNode(0, TNode(1, TNode(2)), TNode(2));
+  auto matcher_builder = NodeMatcher<2>();
+  TreeSearchCursor cursor(*tree, matcher_builder());
+  ASSERT_TRUE(cursor.Next());
+  EXPECT_EQ(&cursor.Match(), DescendPath(*tree, {0, 0}));
+  EXPECT_EQ(cursor.Context().size(), 2);
+  const TreeSearchMatch first = cursor.ToTreeSearchMatch();
+  ASSERT_TRUE(cursor.Next());
+  EXPECT_EQ(&cursor.Match(), DescendPath(*tree, {1}));
+  EXPECT_EQ(cursor.Context().size(), 1);
+  EXPECT_FALSE(cursor.Next());
+  // The copy is unaffected.
+  EXPECT_EQ(first.match, DescendPath(*tree, {0, 0}));
+  EXPECT_EQ(first.context.size(), 2);
+}
+
+// Tests that lazy searches do not look past the matches they are asked for.
+TEST(TreeSearchCursorTest, StopsEarly) {
+  auto tree = Node(TNode(1), TNode(1), TNode(1));
+  auto matcher_builder = NodeMatcher<1>();
+  const auto matcher = matcher_builder();
+  int predicate_calls = 0;
+  const auto predicate = [&predicate_calls](const SyntaxTreeContext&) {
+    ++predicate_calls;
+    return true;
+  };
+  EXPECT_EQ(FindFirstMatch(*tree, matcher, predicate), DescendPath(*tree, {0}));
+  EXPECT_EQ(predicate_calls, 1);
+
+  predicate_calls = 0;
+  for (const auto& match : SearchSyntaxTreeLazily(*tree, matcher, predicate)) {
+    if (match.match == DescendPath(*tree, {1})) break;
+  }
+  EXPECT_EQ(predicate_calls, 2);
+}
+
+TEST(TreeSearchCursorTest, FindFirstMatchNone) {
+  auto tree = Node(TNode(1), XLeaf(2));
+  auto matcher_builder = NodeMatcher<2>();
+  EXPECT_EQ(FindFirstMatch(*tree, matcher_builder()), nullptr);
+}
+
+// Tests that range-based for loops visit all matches.
+TEST(TreeSearchCursorTest, RangeBasedFor) {
+  auto tree = Node(TNode(1, TNode(1)), XLeaf(1), TNode(1));
+  auto matcher_builder = NodeMatcher<1>();
+  std::vector<std::pair<const Symbol*, size_t>> found;
+  for (const auto& match : SearchSyntaxTreeLazily(*tree, matcher_builder())) {
+    found.emplace_back(match.match, match.context.size());
+  }
+  const std::vector<std::pair<const Symbol*, size_t>> expected = {
+      {DescendPath(*tree, {0}), 1},
+      {DescendPath(*tree, {0, 0}), 2},
+      {DescendPath(*tree, {2}), 1},
+  };
+  EXPECT_EQ(found, expected);
+}
+
+// Tests iterating a range without matches.
+TEST(TreeSearchCursorTest, EmptyRange) {
+  auto tree = Node(TNode(1), XLeaf(2));
+  auto matcher_builder = NodeMatcher<2>();
+  auto range = SearchSyntaxTreeLazily(*tree, matcher_builder());
+  EXPECT_TRUE(range.begin() == range.end());
+}
+
 }  // namespace
 }  // namespace verible
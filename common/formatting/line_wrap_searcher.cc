@@ -14,8 +14,8 @@
 
 #include "common/formatting/line_wrap_searcher.h"
 
-#include <memory>
 #include <queue>
+#include <set>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -32,21 +32,40 @@ namespace {
 
 // Wrapped class around StateNode for the sake of adapting to a
 // std::priority_queue interface.
-// TODO(fangism): if performance of memory allocations is an issue,
-// use some sort of pool-allocator.
 struct SearchState {
-  std::shared_ptr<const StateNode> state;
+  const StateNode* state;
 
-  explicit SearchState(const std::shared_ptr<const StateNode>& s) : state(s) {}
+  explicit SearchState(const StateNode* s) : state(s) {}
 
   // Inverted to min-heap: *lowest* penalty has the highest search priority.
   bool operator<(const SearchState& r) const { return *r.state < *state; }
 };
+
+// Orders states by everything that determines their successors: the position
+// in the token sequence, the column position, the stack of wrap column
+// positions, and whether the current token was wrapped.
+// States that compare equivalent lead to the same formatting of the remaining
+// tokens, at the same additional costs.
+struct EquivalentStateLess {
+  bool operator()(const StateNode* left, const StateNode* right) const {
+    const auto left_position = left->undecided_path.begin();
+    const auto right_position = right->undecided_path.begin();
+    if (left_position != right_position) return left_position < right_position;
+    if (left->current_column != right->current_column) {
+      return left->current_column < right->current_column;
+    }
+    const bool left_wrapped = left->spacing_choice == SpacingDecision::Wrap;
+    const bool right_wrapped = right->spacing_choice == SpacingDecision::Wrap;
+    if (left_wrapped != right_wrapped) return right_wrapped;
+    return left->wrap_column_positions < right->wrap_column_positions;
+  }
+};
 }  // namespace
 
 std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
                                               const BasicFormatStyle& style,
-                                              int max_search_states) {
+                                              int max_search_states,
+                                              LineWrapSearchStatistics* stats) {
   // Dijkstra's algorithm for now: prioritize searching minimum penalty path
   // until destination is reached.
 
@@ -62,23 +81,33 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
   // important, consider switching to a std::map.
   std::priority_queue<SearchState> worklist;
 
+  // Owns all search states, which are freed together when the search is done.
+  StateNodePool pool;
+
+  // States that have been expanded.  Because states are expanded in order of
+  // increasing cost, any state equivalent to one of these can be dropped.
+  std::set<const StateNode*, EquivalentStateLess> expanded_states;
+  int pruned_count = 0;
+
+  // Adds 'state' to the worklist, unless it is already dominated.
+  const auto push = [&](const StateNode* state) {
+    if (expanded_states.find(state) != expanded_states.end()) {
+      ++pruned_count;
+      return;
+    }
+    worklist.push(SearchState(state));
+  };
+
   // Seed worklist with a NodeState that should have 0 penalty.
-  SearchState seed(std::make_shared<StateNode>(uwline, style));
-  worklist.push(seed);
+  push(pool.Create(uwline, style));
 
   bool aborted_search = false;
-  std::vector<std::shared_ptr<const StateNode>> winning_paths;
+  std::vector<const StateNode*> winning_paths;
   int state_count = 0;
   while (!worklist.empty()) {
-    ++state_count;
-
     SearchState next(worklist.top());
     worklist.pop();
 
-    VLOG(4) << "\n---- line wrapping search state " << state_count << " ----"
-            << "\ncurrent cost: " << next.state->cumulative_cost
-            << "\ncurrent column: " << next.state->current_column;
-
     if (!winning_paths.empty()) {
       // We already found at least one winning solution.
       // As soon as the current cost exceeds the optimal (by 1 or tie-breaker),
@@ -101,10 +130,22 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
       continue;
     }
 
+    // An equivalent state may have been expanded after this one was queued.
+    if (!expanded_states.insert(next.state).second) {
+      ++pruned_count;
+      continue;
+    }
+
+    ++state_count;
+    VLOG(4) << "\n---- line wrapping search state " << state_count << " ----"
+            << "\ncurrent cost: " << next.state->cumulative_cost
+            << "\ncurrent column: " << next.state->current_column;
+
     if (state_count >= max_search_states) {
       // Search limit exceeded, abandon search.
       // Greedily finish formatting this partition, and return it.
-      winning_paths.push_back(StateNode::QuickFinish(next.state, style));
+      winning_paths.push_back(
+          StateNode::QuickFinish(&pool, next.state, style));
       aborted_search = true;
       break;
     }
@@ -115,29 +156,27 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
     const auto& token = next.state->GetNextToken();
     if (token.before.break_decision == SpacingOptions::Preserve) {
       VLOG(4) << "preserving spaces before \'" << token.token->text() << '\'';
-      SearchState preserved(std::make_shared<StateNode>(
-          next.state, style, SpacingDecision::Preserve));
-      worklist.push(preserved);
+      push(pool.Create(next.state, style, SpacingDecision::Preserve));
     } else {
       // Remaining options are: Undecided, MustWrap, MustAppend
       // Explore one or both: SpacingDecision::Wrap/Append
       if (token.before.break_decision != SpacingOptions::MustWrap) {
         VLOG(4) << "considering appending \'" << token.token->text() << '\'';
         // Consider cost of appending token to current line.
-        SearchState appended(std::make_shared<StateNode>(
-            next.state, style, SpacingDecision::Append));
-        worklist.push(appended);
-        VLOG(4) << "  cost: " << appended.state->cumulative_cost;
-        VLOG(4) << "  column: " << appended.state->current_column;
+        const StateNode* appended =
+            pool.Create(next.state, style, SpacingDecision::Append);
+        VLOG(4) << "  cost: " << appended->cumulative_cost;
+        VLOG(4) << "  column: " << appended->current_column;
+        push(appended);
       }
       if (token.before.break_decision != SpacingOptions::MustAppend) {
         VLOG(4) << "considering wrapping \'" << token.token->text() << '\'';
         // Consider cost of line wrapping here.
-        SearchState wrapped(std::make_shared<StateNode>(next.state, style,
-                                                        SpacingDecision::Wrap));
-        worklist.push(wrapped);
-        VLOG(4) << "  cost: " << wrapped.state->cumulative_cost;
-        VLOG(4) << "  column: " << wrapped.state->current_column;
+        const StateNode* wrapped =
+            pool.Create(next.state, style, SpacingDecision::Wrap);
+        VLOG(4) << "  cost: " << wrapped->cumulative_cost;
+        VLOG(4) << "  column: " << wrapped->current_column;
+        push(wrapped);
       }
     }
 
@@ -149,6 +188,15 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
 
   CHECK_GE(winning_paths.size(), 1);
 
+  VLOG(2) << "line wrap search expanded " << state_count << " states, pruned "
+          << pruned_count << " equivalent states"
+          << (aborted_search ? " (aborted)" : "");
+  if (stats != nullptr) {
+    stats->expanded_states += state_count;
+    stats->pruned_states += pruned_count;
+    if (aborted_search) ++stats->aborted_searches;
+  }
+
   // Reconstruct the unwrapped_line to reflect the decisions made to reach the
   // winning_paths.  Return a modified copy of the original UnwrappedLine.
   std::vector<FormattedExcerpt> results;
@@ -189,7 +237,8 @@ FitResult FitsOnLine(const UnwrappedLine& uwline,
 
   // Initialize on first token.
   // This accounts for space consumed by left-indentation.
-  auto state = std::make_shared<const StateNode>(uwline, style);
+  StateNodePool pool;
+  const StateNode* state = pool.Create(uwline, style);
 
   while (!state->Done()) {
     const auto& token = state->GetNextToken();
@@ -199,7 +248,7 @@ FitResult FitsOnLine(const UnwrappedLine& uwline,
     }
 
     // Append token onto same line while it fits.
-    state = std::make_shared<StateNode>(state, style, SpacingDecision::Append);
+    state = pool.Create(state, style, SpacingDecision::Append);
     if (state->current_column > style.column_limit) {
       return {false, state->current_column};
     }
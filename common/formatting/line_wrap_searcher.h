@@ -15,6 +15,7 @@
 #ifndef VERIBLE_COMMON_FORMATTING_LINE_WRAP_SEARCHER_H_
 #define VERIBLE_COMMON_FORMATTING_LINE_WRAP_SEARCHER_H_
 
+#include <cstdint>
 #include <iosfwd>
 #include <vector>
 
@@ -23,19 +24,37 @@
 
 namespace verible {
 
+// Counters collected by SearchLineWraps(), for performance analysis.
+// These accumulate over multiple searches.
+struct LineWrapSearchStatistics {
+  // Number of search states that were expanded.
+  int64_t expanded_states = 0;
+  // Number of search states that were dropped because an equivalent state
+  // (see SearchLineWraps) had already been expanded at no higher cost.
+  int64_t pruned_states = 0;
+  // Number of searches that exceeded max_search_states.
+  int64_t aborted_searches = 0;
+};
+
 // SearchLineWraps takes an UnwrappedLine with formatting annotations,
 // and a style structure, and returns equally-good FormattedExcerpts with
 // formatting decisions (wraps, spaces) committed.
 // This minimizes the numeric penalty during search to yield optimal results,
 // which can result in multiple optimal formattings.
+// Search states that are at the same token with the same column position,
+// wrap column positions and wrap decision are equivalent: the remaining
+// decisions are independent of how they were reached.  Only the first (least
+// costly) of equivalent states is explored, so equally optimal results that
+// differ only before such a state are not reported separately.
 // max_search_states limits the size of the optimization search.
 // When the number of states evaluated exceeds this, this will abort by
 // returning a greedily formatted result (which can still be rendered)
 // that will be marked as !CompletedFormatting().
 // This is guaranteed to return at least one result.
-std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
-                                              const BasicFormatStyle& style,
-                                              int max_search_states);
+// If 'stats' is not nullptr, search counters are added to it.
+std::vector<FormattedExcerpt> SearchLineWraps(
+    const UnwrappedLine& uwline, const BasicFormatStyle& style,
+    int max_search_states, LineWrapSearchStatistics* stats = nullptr);
 
 // Diagnostic helper for displaying when multiple optimal wrappings are found
 // by SearchLineWraps.  This aids in development around wrap penalty tuning.
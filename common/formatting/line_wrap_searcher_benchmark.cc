@@ -0,0 +1,84 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures SearchLineWraps() on a synthetic call-like line
+// "function_name(argument_0, argument_1, ...);" that needs to be wrapped.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "benchmark/benchmark.h"
+#include "common/formatting/basic_format_style.h"
+#include "common/formatting/format_token.h"
+#include "common/formatting/line_wrap_searcher.h"
+#include "common/formatting/unwrapped_line.h"
+#include "common/formatting/unwrapped_line_test_utils.h"
+#include "common/text/token_info.h"
+
+namespace verible {
+namespace {
+
+// Same limit as the Verilog formatter's default.
+constexpr int kMaxSearchStates = 10000;
+
+void BM_SearchLineWraps(benchmark::State& state) {
+  const int num_arguments = state.range(0);
+  std::vector<std::string> texts = {"function_name", "("};
+  for (int i = 0; i < num_arguments; ++i) {
+    texts.push_back(absl::StrCat("argument_", i));
+    texts.push_back(i + 1 < num_arguments ? "," : ")");
+  }
+  texts.push_back(";");
+  std::vector<TokenInfo> tokens;
+  for (const auto& text : texts) tokens.emplace_back(0, text);
+
+  UnwrappedLineMemoryHandler handler;
+  handler.CreateTokenInfos(tokens);
+  UnwrappedLine uwline(0, handler.GetPreFormatTokensBegin());
+  handler.AddFormatTokens(&uwline);
+  size_t num_bytes = 0;
+  for (auto& ftoken : handler.pre_format_tokens_) {
+    const absl::string_view text(ftoken.token->text());
+    num_bytes += text.length();
+    // Prefer breaking after open-parentheses and commas.
+    const bool closes = text == "," || text == ")" || text == ";";
+    ftoken.before.spaces_required = closes ? 0 : 1;
+    ftoken.before.break_penalty = closes ? 50 : 2;
+  }
+
+  const BasicFormatStyle style;
+  LineWrapSearchStatistics stats;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        SearchLineWraps(uwline, style, kMaxSearchStates, &stats));
+  }
+  state.SetBytesProcessed(state.iterations() * num_bytes);
+  state.counters["tokens"] = benchmark::Counter(
+      tokens.size(), benchmark::Counter::kIsIterationInvariantRate);
+  // Per search:
+  state.counters["expanded"] = benchmark::Counter(
+      stats.expanded_states, benchmark::Counter::kAvgIterations);
+  state.counters["pruned"] = benchmark::Counter(
+      stats.pruned_states, benchmark::Counter::kAvgIterations);
+  state.counters["aborted"] = benchmark::Counter(
+      stats.aborted_searches, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_SearchLineWraps)->RangeMultiplier(2)->Range(4, 256);
+
+}  // namespace
+}  // namespace verible
@@ -14,6 +14,7 @@
 
 #include "common/formatting/line_wrap_searcher.h"
 
+#include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -398,6 +399,34 @@ TEST_F(SearchLineWrapsTestFixture, FitsOnLine) {
   EXPECT_EQ(FitsOnLine(uwline_in, style_).final_column, 14);
 }
 
+// Test that equivalent search states are explored only once, which keeps
+// search on long lines within bounds.
+TEST_F(SearchLineWrapsTestFixture, PrunesEquivalentStates) {
+  const std::vector<TokenInfo> tokens(40, {0, "xxx"});
+  CreateTokenInfos(tokens);
+  UnwrappedLine uwline_in(LevelsToSpaces(1), pre_format_tokens_.begin());
+  AddFormatTokens(&uwline_in);
+  for (auto& ftoken : pre_format_tokens_) {
+    ftoken.before.break_penalty = 1;
+    ftoken.before.spaces_required = 1;
+  }
+  LineWrapSearchStatistics stats;
+  const auto formatted_lines =
+      verible::SearchLineWraps(uwline_in, style_, 1000, &stats);
+  ASSERT_FALSE(formatted_lines.empty());
+  const FormattedExcerpt& formatted_line = formatted_lines.front();
+  EXPECT_TRUE(formatted_line.CompletedFormatting());
+  EXPECT_EQ(stats.aborted_searches, 0);
+  EXPECT_LT(stats.expanded_states, 1000);
+  EXPECT_GT(stats.pruned_states, 0);
+  // 4 tokens on the first line, then 3 tokens on each wrapped line.
+  std::string expected = "   xxx xxx xxx xxx";
+  for (int i = 4; i < 40; ++i) {
+    expected += (i - 4) % 3 == 0 ? "\n         xxx" : " xxx";
+  }
+  EXPECT_EQ(formatted_line.Render(), expected);
+}
+
 // Test that aborted wrap search works returns a result marked as incomplete.
 TEST_F(SearchLineWrapsTestFixture, AbortedSearch) {
   const std::vector<TokenInfo> tokens = {
@@ -417,10 +446,13 @@ TEST_F(SearchLineWrapsTestFixture, AbortedSearch) {
   ftokens_in[2].before.break_penalty = 1;
   ftokens_in[2].before.spaces_required = 1;
   // Intentionally limit search space to a small count to force early abort.
-  const auto formatted_lines = verible::SearchLineWraps(uwline_in, style_, 2);
+  LineWrapSearchStatistics stats;
+  const auto formatted_lines =
+      verible::SearchLineWraps(uwline_in, style_, 2, &stats);
   const FormattedExcerpt& formatted_line = formatted_lines.front();
   EXPECT_EQ(formatted_line.Tokens().size(), tokens.size());
   EXPECT_FALSE(formatted_line.CompletedFormatting());
+  EXPECT_EQ(stats.aborted_searches, 1);
   // The resulting state is unpredictable, because the search terminated early.
   // So we don't check any other properties of the formatted_line.
 }
@@ -16,7 +16,6 @@
 
 #include <cstddef>
 #include <iterator>
-#include <memory>
 #include <stack>
 #include <vector>
 
@@ -76,8 +75,7 @@ StateNode::StateNode(const UnwrappedLine& uwline, const BasicFormatStyle& style)
   VLOG(4) << "root: " << *this;
 }
 
-StateNode::StateNode(const std::shared_ptr<const StateNode>& parent,
-                     const BasicFormatStyle& style,
+StateNode::StateNode(const StateNode* parent, const BasicFormatStyle& style,
                      SpacingDecision spacing_choice)
     : prev_state(ABSL_DIE_IF_NULL(parent)),
       undecided_path(prev_state->undecided_path.begin() + 1,  // pop_front()
@@ -315,8 +313,8 @@ void StateNode::_CloseGroupBalance() {
   //     ) <-- aligned with (
 }
 
-std::shared_ptr<const StateNode> StateNode::AppendIfItFits(
-    const std::shared_ptr<const StateNode>& current_state,
+const StateNode* StateNode::AppendIfItFits(
+    StateNodePool* pool, const StateNode* current_state,
     const verible::BasicFormatStyle& style) {
   if (current_state->Done()) return current_state;
   const auto& token = current_state->GetNextToken();
@@ -324,10 +322,10 @@ std::shared_ptr<const StateNode> StateNode::AppendIfItFits(
   // returned, but compiler optimization should be able to leverage this.
   // In any case, this is not a critical path operation, so we're not going to
   // worry about it.
-  const auto wrapped =
-      std::make_shared<StateNode>(current_state, style, SpacingDecision::Wrap);
-  const auto appended = std::make_shared<StateNode>(current_state, style,
-                                                    SpacingDecision::Append);
+  const auto* wrapped =
+      pool->Create(current_state, style, SpacingDecision::Wrap);
+  const auto* appended =
+      pool->Create(current_state, style, SpacingDecision::Append);
   if (token.before.break_decision == SpacingOptions::MustWrap ||
       appended->current_column > style.column_limit) {
     return wrapped;
@@ -336,14 +334,14 @@ std::shared_ptr<const StateNode> StateNode::AppendIfItFits(
   }
 }
 
-std::shared_ptr<const StateNode> StateNode::QuickFinish(
-    const std::shared_ptr<const StateNode>& current_state,
+const StateNode* StateNode::QuickFinish(
+    StateNodePool* pool, const StateNode* current_state,
     const verible::BasicFormatStyle& style) {
-  std::shared_ptr<const StateNode> latest(current_state);
-  // Construct a chain of reference-counted states where the returned pointer
-  // "holds on" to all of its ancestors like a singly-linked-list.
+  const StateNode* latest = current_state;
+  // Construct a chain of states where the returned pointer leads to all of its
+  // ancestors like a singly-linked-list.
   while (!latest->Done()) {
-    latest = AppendIfItFits(latest, style);
+    latest = AppendIfItFits(pool, latest, style);
   }
   return latest;
 }
@@ -18,8 +18,8 @@
 #include <cstddef>
 #include <iosfwd>
 #include <iterator>
-#include <memory>
 #include <stack>
+#include <utility>
 #include <vector>
 
 #include "common/formatting/basic_format_style.h"
@@ -29,19 +29,23 @@
 
 namespace verible {
 
+class StateNodePool;
+
 // A StateNode is used to keep a formatting state as the tokens of an
 // UnwrappedLine are searched left to right.  Each StateNode represents one
 // formatting decision: wrap or not-wrap.  Each StateNode maintains a pointer
 // to its parent state, which is used for backtracking once a solution
 // is reached.  StateNode is language-agnostic.
 // StateNode is purely an implementation detail of line_wrap_searcher.cc.
+// StateNodes do not own their parents; all nodes of a search are owned by a
+// StateNodePool.
 struct StateNode {
   typedef std::vector<PreFormatToken> path_type;
   typedef container_iterator_range<path_type::const_iterator> range_type;
 
   // The StateNode that has an edge to this StateNode, to backtrack once a final
-  // state is reached.
-  std::shared_ptr<const StateNode> prev_state;
+  // state is reached.  Not owned.
+  const StateNode* prev_state;
 
   // Iterator range marking the unexplored decisions beyond the current token.
   // TODO(fangism): make the iterator type a template parameter.  Might help
@@ -74,9 +78,11 @@ struct StateNode {
   // These column positions correspond to either the current indentation level
   // plus wrapping or the column position of the nearest group-opening
   // delimiter.
+  // This is copied into every new state, so it is backed by a vector, which
+  // takes a single small allocation (vs. std::deque).
   // TODO(b/135730018): re-implement to minimize copying of stacks.
   // For example, use pointer or iterator to previous stack update.
-  std::stack<int> wrap_column_positions;
+  std::stack<int, std::vector<int>> wrap_column_positions;
 
   // Constructor for the root node of the search path, with no parent.
   // This automatically places the first token at the beginning of a new line
@@ -88,8 +94,9 @@ struct StateNode {
   // Constructor for nodes that represent new wrap decision trees to explore.
   // 'spacing_choice' reflects the decision being explored, e.g. append, wrap,
   // preserve.
-  StateNode(const std::shared_ptr<const StateNode>& parent,
-            const BasicFormatStyle& style, SpacingDecision spacing_choice);
+  // 'parent' must outlive this node.
+  StateNode(const StateNode* parent, const BasicFormatStyle& style,
+            SpacingDecision spacing_choice);
 
   // Returns true when the undecided_path is empty.
   // The search is over when there are no more decisions to explore.
@@ -110,7 +117,7 @@ struct StateNode {
 
   // Returns pointer to previous state before this decision node.
   // This functions as a forward-iterator going up the state ancestry chain.
-  const StateNode* next() const { return prev_state.get(); }
+  const StateNode* next() const { return prev_state; }
 
   // Returns true if this state was initialized with an unwrapped line and
   // has no parent state.
@@ -123,22 +130,23 @@ struct StateNode {
     const auto* iter = this;
     while (!iter->IsRootState()) {
       ++depth;
-      iter = iter->prev_state.get();
+      iter = iter->prev_state;
     }
     return depth;
   }
 
   // Produce next state by appending a token if the result stays under the
   // column limit, or breaking onto a new line if required.
-  static std::shared_ptr<const StateNode> AppendIfItFits(
-      const std::shared_ptr<const StateNode>& current_state,
-      const BasicFormatStyle& style);
+  // New states are allocated from 'pool'.
+  static const StateNode* AppendIfItFits(StateNodePool* pool,
+                                         const StateNode* current_state,
+                                         const BasicFormatStyle& style);
 
   // Repeatedly apply AppendIfItFits() until Done() with formatting.
   // TODO(b/134711965): We may want a variant that preserves spaces too.
-  static std::shared_ptr<const StateNode> QuickFinish(
-      const std::shared_ptr<const StateNode>& current_state,
-      const BasicFormatStyle& style);
+  static const StateNode* QuickFinish(StateNodePool* pool,
+                                      const StateNode* current_state,
+                                      const BasicFormatStyle& style);
 
   // Comparator provides an ordering of which paths should be explored
   // when maintained in a priority queue.  For Dijsktra-style algorithms,
@@ -173,6 +181,41 @@ struct StateNode {
 // Human-readable representation for debugging only.
 std::ostream& operator<<(std::ostream&, const StateNode&);
 
+// StateNodePool owns all the StateNodes created during one search, and frees
+// them all at once when it is destroyed.  Nodes are allocated in chunks, and
+// never move, so they can point to each other.
+class StateNodePool {
+ public:
+  StateNodePool() = default;
+
+  StateNodePool(const StateNodePool&) = delete;
+  StateNodePool& operator=(const StateNodePool&) = delete;
+
+  // Constructs a new StateNode, forwarding 'args' to its constructor.
+  template <typename... Args>
+  const StateNode* Create(Args&&... args) {
+    if (chunks_.empty() || chunks_.back().size() == chunks_.back().capacity()) {
+      chunks_.emplace_back();
+      chunks_.back().reserve(kChunkSize);
+    }
+    chunks_.back().emplace_back(std::forward<Args>(args)...);
+    ++size_;
+    return &chunks_.back().back();
+  }
+
+  // Returns the number of nodes created.
+  size_t size() const { return size_; }
+
+ private:
+  // Number of StateNodes per allocation.
+  enum { kChunkSize = 1024 };
+
+  // Each chunk is filled up to its reserved capacity, and never reallocated.
+  std::vector<std::vector<StateNode>> chunks_;
+
+  size_t size_ = 0;
+};
+
 }  // namespace verible
 
 #endif  // VERIBLE_COMMON_FORMATTING_STATE_NODE_H_
@@ -149,7 +149,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevState) {
   const auto& child_state = parent_state;
   {
     // Second token, also appended to same line as first:
-    auto child2_state = std::make_shared<StateNode>(child_state, style,
+    auto child2_state = std::make_shared<StateNode>(child_state.get(), style,
                                                     SpacingDecision::Append);
     EXPECT_EQ(child2_state->next(), child_state.get());
     EXPECT_EQ(child2_state->current_column,
@@ -163,8 +163,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevState) {
   }
   {
     // Second token, but wrapped onto next line:
-    auto child2_state =
-        std::make_shared<StateNode>(child_state, style, SpacingDecision::Wrap);
+    auto child2_state = std::make_shared<StateNode>(child_state.get(), style,
+                                                    SpacingDecision::Wrap);
     EXPECT_EQ(child2_state->next(), child_state.get());
     EXPECT_EQ(child2_state->current_column,
               initial_column +               // 2 +
@@ -199,7 +199,7 @@ TEST_F(StateNodeTestFixture, ConstructionPreserveSpacesFromPrevStateNoGap) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Appended with preserved spaces from original text.
-  auto child_state = std::make_shared<StateNode>(parent_state, style,
+  auto child_state = std::make_shared<StateNode>(parent_state.get(), style,
                                                  SpacingDecision::Preserve);
   EXPECT_EQ(child_state->next(), parent_state.get());
   EXPECT_EQ(child_state->current_column,
@@ -233,7 +233,7 @@ TEST_F(StateNodeTestFixture, ConstructionPreserveSpacesFromPrevStateSpaces) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Appended with preserved spaces from original text.
-  auto child_state = std::make_shared<StateNode>(parent_state, style,
+  auto child_state = std::make_shared<StateNode>(parent_state.get(), style,
                                                  SpacingDecision::Preserve);
   EXPECT_EQ(child_state->next(), parent_state.get());
   EXPECT_EQ(child_state->current_column,
@@ -267,7 +267,7 @@ TEST_F(StateNodeTestFixture, ConstructionPreserveSpacesFromPrevStateNewline) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Appended with preserved spaces from original text.
-  auto child_state = std::make_shared<StateNode>(parent_state, style,
+  auto child_state = std::make_shared<StateNode>(parent_state.get(), style,
                                                  SpacingDecision::Preserve);
   EXPECT_EQ(child_state->next(), parent_state.get());
   EXPECT_EQ(child_state->current_column,
@@ -311,7 +311,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
     // Second token, also appended to same line as first:
     // > function_caller (
     // >     ^-- next wrap should be here
-    auto child2_state = std::make_shared<StateNode>(child_state, style,
+    auto child2_state = std::make_shared<StateNode>(child_state.get(), style,
                                                     SpacingDecision::Append);
     EXPECT_EQ(child2_state->next(), child_state.get());
     EXPECT_EQ(child2_state->current_column,
@@ -328,7 +328,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
       // Third token, also appended to same line:
       // > function_caller ( 11
       // >                  ^-- next wrap should be here
-      auto child3_state = std::make_shared<StateNode>(child2_state, style,
+      auto child3_state = std::make_shared<StateNode>(child2_state.get(), style,
                                                       SpacingDecision::Append);
       EXPECT_EQ(child3_state->next(), child2_state.get());
       EXPECT_EQ(child3_state->current_column,
@@ -346,7 +346,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // > function_caller ( 11 )
         // >     ^-- next wrap should be here, after closing balance group
         auto child4_state = std::make_shared<StateNode>(
-            child3_state, style, SpacingDecision::Append);
+            child3_state.get(), style, SpacingDecision::Append);
         EXPECT_EQ(child4_state->next(), child3_state.get());
         EXPECT_EQ(child4_state->current_column,
                   child3_state->current_column +           // 22 +
@@ -368,8 +368,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >                 )  // aligned with open-group
         // As-is, it is not because we pop the column stack on close-group
         // first, which is not an unreasonable choice.
-        auto child4_state = std::make_shared<StateNode>(child3_state, style,
-                                                        SpacingDecision::Wrap);
+        auto child4_state = std::make_shared<StateNode>(
+            child3_state.get(), style, SpacingDecision::Wrap);
         EXPECT_EQ(child4_state->next(), child3_state.get());
         EXPECT_EQ(child4_state->current_column,
                   child2_state->wrap_column_positions
@@ -390,7 +390,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
       // > function_caller (
       // >     11
       // >         ^-- next wrap should be here
-      auto child3_state = std::make_shared<StateNode>(child2_state, style,
+      auto child3_state = std::make_shared<StateNode>(child2_state.get(), style,
                                                       SpacingDecision::Wrap);
       EXPECT_EQ(child3_state->next(), child2_state.get());
       EXPECT_EQ(child3_state->current_column,
@@ -408,7 +408,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >     11 )
         // >     ^-- next wrap should be here
         auto child4_state = std::make_shared<StateNode>(
-            child3_state, style, SpacingDecision::Append);
+            child3_state.get(), style, SpacingDecision::Append);
         EXPECT_EQ(child4_state->next(), child3_state.get());
         EXPECT_EQ(child4_state->current_column,
                   child3_state->current_column +           // 8
@@ -429,8 +429,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >     11
         // >     )
         // >     ^-- next wrap should be here
-        auto child4_state = std::make_shared<StateNode>(child3_state, style,
-                                                        SpacingDecision::Wrap);
+        auto child4_state = std::make_shared<StateNode>(
+            child3_state.get(), style, SpacingDecision::Wrap);
         EXPECT_EQ(child4_state->next(), child3_state.get());
         EXPECT_EQ(
             child4_state->current_column,
@@ -453,8 +453,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
     // > function_caller
     // >     (
     // >     ^-- next wrap should be here
-    auto child2_state =
-        std::make_shared<StateNode>(child_state, style, SpacingDecision::Wrap);
+    auto child2_state = std::make_shared<StateNode>(child_state.get(), style,
+                                                    SpacingDecision::Wrap);
     EXPECT_EQ(child2_state->next(), child_state.get());
     EXPECT_EQ(child2_state->current_column,
               initial_column +               // 2 +
@@ -474,7 +474,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
       // > function_caller
       // >     ( 11
       // >     ^-- next wrap should be here
-      auto child3_state = std::make_shared<StateNode>(child2_state, style,
+      auto child3_state = std::make_shared<StateNode>(child2_state.get(), style,
                                                       SpacingDecision::Append);
       EXPECT_EQ(child3_state->next(), child2_state.get());
       EXPECT_EQ(child3_state->current_column,
@@ -495,7 +495,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >     ( 11 )
         // >     ^-- next wrap should be here
         auto child4_state = std::make_shared<StateNode>(
-            child3_state, style, SpacingDecision::Append);
+            child3_state.get(), style, SpacingDecision::Append);
         EXPECT_EQ(child4_state->next(), child3_state.get());
         EXPECT_EQ(child4_state->current_column,
                   child3_state->current_column +           // 10
@@ -516,8 +516,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >     ( 11
         // >     )
         // >     ^-- next wrap should be here
-        auto child4_state = std::make_shared<StateNode>(child3_state, style,
-                                                        SpacingDecision::Wrap);
+        auto child4_state = std::make_shared<StateNode>(
+            child3_state.get(), style, SpacingDecision::Wrap);
         EXPECT_EQ(child4_state->next(), child3_state.get());
         EXPECT_EQ(child4_state->current_column,
                   child2_state->wrap_column_positions.top() +
@@ -541,7 +541,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
       // >     (
       // >         11
       // >         ^-- next wrap should be here
-      auto child3_state = std::make_shared<StateNode>(child2_state, style,
+      auto child3_state = std::make_shared<StateNode>(child2_state.get(), style,
                                                       SpacingDecision::Wrap);
       EXPECT_EQ(child3_state->next(), child2_state.get());
       EXPECT_EQ(child3_state->current_column,
@@ -565,7 +565,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >         11 )
         // >     ^-- next wrap should be here
         auto child4_state = std::make_shared<StateNode>(
-            child3_state, style, SpacingDecision::Append);
+            child3_state.get(), style, SpacingDecision::Append);
         EXPECT_EQ(child4_state->next(), child3_state.get());
         EXPECT_EQ(child4_state->current_column,
                   child3_state->current_column +           // 10
@@ -588,8 +588,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >         11
         // >     )
         // >     ^-- next wrap should be here
-        auto child4_state = std::make_shared<StateNode>(child3_state, style,
-                                                        SpacingDecision::Wrap);
+        auto child4_state = std::make_shared<StateNode>(
+            child3_state.get(), style, SpacingDecision::Wrap);
         EXPECT_EQ(child4_state->next(), child3_state.get());
         EXPECT_EQ(child4_state->current_column,
                   child_state->wrap_column_positions.top() +
@@ -634,7 +634,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateOverflow) {
 
   {
     // Second token, also appended to same line as first:
-    auto child2_state = std::make_shared<StateNode>(child_state, style,
+    auto child2_state = std::make_shared<StateNode>(child_state.get(), style,
                                                     SpacingDecision::Append);
     EXPECT_EQ(child2_state->next(), child_state.get());
     EXPECT_EQ(child2_state->current_column,
@@ -648,8 +648,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateOverflow) {
   }
   {
     // Second token, but wrapped onto a new line:
-    auto child2_state =
-        std::make_shared<StateNode>(child_state, style, SpacingDecision::Wrap);
+    auto child2_state = std::make_shared<StateNode>(child_state.get(), style,
+                                                    SpacingDecision::Wrap);
     EXPECT_EQ(child2_state->next(), child_state.get());
     EXPECT_EQ(child2_state->current_column,
               initial_column +         // 2 +
@@ -695,7 +695,7 @@ TEST_F(StateNodeTestFixture, MultiLineToken) {
 
   {
     // Second token, also appended to same line as first:
-    auto child_state = std::make_shared<StateNode>(parent_state, style,
+    auto child_state = std::make_shared<StateNode>(parent_state.get(), style,
                                                    SpacingDecision::Append);
     EXPECT_EQ(child_state->next(), parent_state.get());
     EXPECT_EQ(child_state->current_column,
@@ -708,8 +708,8 @@ TEST_F(StateNodeTestFixture, MultiLineToken) {
   }
   {
     // Second token, but wrapped onto a new line:
-    auto child_state =
-        std::make_shared<StateNode>(parent_state, style, SpacingDecision::Wrap);
+    auto child_state = std::make_shared<StateNode>(parent_state.get(), style,
+                                                   SpacingDecision::Wrap);
     EXPECT_EQ(child_state->next(), parent_state.get());
     EXPECT_EQ(child_state->current_column,
               13  // length("c2345...."), no wrapping indentation
@@ -742,7 +742,7 @@ TEST_F(StateNodeTestFixture, MultiLineTokenOverflow) {
 
   {
     // Second token, also appended to same line as first:
-    auto child_state = std::make_shared<StateNode>(parent_state, style,
+    auto child_state = std::make_shared<StateNode>(parent_state.get(), style,
                                                    SpacingDecision::Append);
     EXPECT_EQ(child_state->next(), parent_state.get());
     EXPECT_EQ(child_state->current_column,
@@ -758,8 +758,8 @@ TEST_F(StateNodeTestFixture, MultiLineTokenOverflow) {
   }
   {
     // Second token, but wrapped onto a new line:
-    auto child_state =
-        std::make_shared<StateNode>(parent_state, style, SpacingDecision::Wrap);
+    auto child_state = std::make_shared<StateNode>(parent_state.get(), style,
+                                                   SpacingDecision::Wrap);
     EXPECT_EQ(child_state->next(), parent_state.get());
     EXPECT_EQ(child_state->current_column,
               10  // length("c2345...."), no wrapping indentation
@@ -787,8 +787,8 @@ TEST_F(StateNodeTestFixture, ConstructionWrappingLinePrevState) {
   EXPECT_EQ(parent_state->cumulative_cost, 0);
 
   // Wrap the next token onto a new line.
-  auto child_state =
-      std::make_shared<StateNode>(parent_state, style, SpacingDecision::Wrap);
+  auto child_state = std::make_shared<StateNode>(parent_state.get(), style,
+                                                 SpacingDecision::Wrap);
   EXPECT_EQ(child_state->next(), parent_state.get());
   EXPECT_EQ(child_state->current_column,
             initial_column + style.wrap_spaces + tokens[1].text().length());
@@ -813,7 +813,8 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsTryToAppend) {
   ftokens[0].before.spaces_required = 1;
   ftokens[1].before.spaces_required = 1;
   ftokens[2].before.spaces_required = 1;
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  StateNodePool pool;
+  const auto* parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text().length());
@@ -823,9 +824,9 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsTryToAppend) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Second token, also appended to same line as first:
-  auto child_state = StateNode::AppendIfItFits(parent_state, style);
+  auto child_state = StateNode::AppendIfItFits(&pool, parent_state, style);
   EXPECT_EQ(child_state->spacing_choice, SpacingDecision::Append);
-  EXPECT_EQ(child_state->next(), parent_state.get());
+  EXPECT_EQ(child_state->next(), parent_state);
   EXPECT_EQ(child_state->current_column,
             parent_state->current_column +           // 12 +
                 ftokens[1].before.spaces_required +  // 1 +
@@ -834,9 +835,9 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsTryToAppend) {
   EXPECT_FALSE(child_state->IsRootState());
 
   // Third token, doesn't fit, and will be wrapped.
-  auto child2_state = StateNode::AppendIfItFits(child_state, style);
+  auto child2_state = StateNode::AppendIfItFits(&pool, child_state, style);
   EXPECT_EQ(child2_state->spacing_choice, SpacingDecision::Wrap);
-  EXPECT_EQ(child2_state->next(), child_state.get());
+  EXPECT_EQ(child2_state->next(), child_state);
   EXPECT_EQ(child2_state->current_column,
             initial_column + style.wrap_spaces + tokens[2].text().length());
 }
@@ -854,7 +855,8 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsForcedWrap) {
   ftokens[1].before.spaces_required = 1;
   // Tokens stay under column limit, but here, we force a wrap.
   ftokens[1].before.break_decision = SpacingOptions::MustWrap;
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  StateNodePool pool;
+  const auto* parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text().length());
@@ -864,9 +866,9 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsForcedWrap) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Second token, forced to wrap onto new line.
-  auto child_state = StateNode::AppendIfItFits(parent_state, style);
+  auto child_state = StateNode::AppendIfItFits(&pool, parent_state, style);
   EXPECT_EQ(child_state->spacing_choice, SpacingDecision::Wrap);
-  EXPECT_EQ(child_state->next(), parent_state.get());
+  EXPECT_EQ(child_state->next(), parent_state);
   EXPECT_EQ(child_state->current_column,
             initial_column + style.wrap_spaces + tokens[0].text().length());
   EXPECT_FALSE(child_state->IsRootState());
@@ -886,7 +888,8 @@ TEST_F(StateNodeTestFixture, QuickFinish) {
   ftokens[0].before.spaces_required = 1;
   ftokens[1].before.spaces_required = 1;
   ftokens[2].before.spaces_required = 1;
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  StateNodePool pool;
+  const auto* parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text().length());
@@ -895,7 +898,7 @@ TEST_F(StateNodeTestFixture, QuickFinish) {
             initial_column + style.wrap_spaces);
   EXPECT_TRUE(parent_state->IsRootState());
 
-  auto final_state = StateNode::QuickFinish(parent_state, style);
+  auto final_state = StateNode::QuickFinish(&pool, parent_state, style);
 
   // Checking up the ancestry chain of previous states
   // Third token, doesn't fit, and will be wrapped.
@@ -906,7 +909,7 @@ TEST_F(StateNodeTestFixture, QuickFinish) {
   EXPECT_EQ(child_state->spacing_choice, SpacingDecision::Append);
 
   // Second state is decended from initial state.
-  EXPECT_EQ(child_state->next(), parent_state.get());
+  EXPECT_EQ(child_state->next(), parent_state);
 }
 
 // Tests that equal cumulative penalty does not count as less.
@@ -944,5 +947,23 @@ TEST_F(StateNodeTestFixture, Stringify) {
   EXPECT_EQ(stream.str(), "spacing:wrap, col@7, cost=11, [...3]");
 }
 
+// Tests that pooled states stay in place as the pool grows.
+TEST_F(StateNodeTestFixture, PoolStatesDoNotMove) {
+  const std::vector<TokenInfo> tokens = {{0, "aaa"}, {1, "bbb"}};
+  Initialize(0, tokens);
+  StateNodePool pool;
+  const auto* root = pool.Create(*uwline, style);
+  std::vector<const StateNode*> children;
+  for (int i = 0; i < 3000; ++i) {
+    children.push_back(pool.Create(root, style, SpacingDecision::Wrap));
+  }
+  EXPECT_EQ(pool.size(), 3001);
+  for (const auto* child : children) {
+    EXPECT_EQ(child->next(), root);
+    EXPECT_EQ(child->spacing_choice, SpacingDecision::Wrap);
+    EXPECT_EQ(child->current_column, children.front()->current_column);
+  }
+}
+
 }  // namespace
 }  // namespace verible
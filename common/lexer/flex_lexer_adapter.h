@@ -32,9 +32,12 @@
 #ifndef VERIBLE_COMMON_LEXER_FLEX_LEXER_ADAPTER_H_
 #define VERIBLE_COMMON_LEXER_FLEX_LEXER_ADAPTER_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <sstream>  // IWYU pragma: keep  // for ostringstream
+#include <sstream>  // IWYU pragma: keep  // for istringstream
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -51,12 +54,9 @@ namespace verible {
 // ordered before "L" in FlexLexerAdaptor's base classes.
 class CodeStreamHolder {
  protected:
-  // The stream object conforms to the FlexLexer input interface.
-  // Even though scanning is done on the stream's internal copy of the input
-  // string, the byte offsets being tracked can be used to construct
-  // string_views based on the original string's start address.
-  // Using the standard istream interface also lets us switch buffers, e.g.
-  // during preprocessing.
+  // The stream object conforms to the FlexLexer input interface, but always
+  // remains empty: FlexLexerAdapter overrides LexerInput() to read directly
+  // from the original text, without copying it into the stream first.
   std::istringstream code_stream_;
 };
 
@@ -68,10 +68,7 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
       : L(&code_stream_),
         code_(code),
         // last_token_ points to the beginning of the code_ buffer
-        last_token_(0 /* enum doesn't matter */, code_.substr(0, 0)) {
-    code_stream_.str(std::string(code));
-    // istringstream copies text into its own internal buffer.
-  }
+        last_token_(0 /* enum doesn't matter */, code_.substr(0, 0)) {}
 
   // Returns the token associated with the last UpdateLocation() call.
   const TokenInfo& GetLastToken() const override { return last_token_; }
@@ -111,7 +108,7 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
   void Restart(absl::string_view code) override {
     at_eof_ = false;
     code_ = code;
-    code_stream_.str(std::string(code_));
+    input_offset_ = 0;
     last_token_ = TokenInfo(0, code_.substr(0, 0));
 
     // Reset buffer stack.
@@ -128,6 +125,16 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
     }
   }
 
+  // Overrides yyFlexLexer's implementation to feed the scanner directly from
+  // code_, instead of from the (istream) yyin.
+  int LexerInput(char* buf, int max_size) override {
+    const size_t size =
+        std::min<size_t>(max_size, code_.length() - input_offset_);
+    memcpy(buf, code_.data() + input_offset_, size);
+    input_offset_ += size;
+    return size;
+  }
+
   // Overrides yyFlexLexer's implementation to handle unrecognized chars.
   void LexerOutput(const char* buf, int size) override {
     VLOG(1) << "LexerOutput: rejected text: \"" << std::string(buf, size)
@@ -152,6 +159,10 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
   // A read-only view of the entire text to be scanned.
   absl::string_view code_;
 
+  // Number of bytes of code_ that have already been handed to the scanner
+  // by LexerInput().
+  size_t input_offset_ = 0;
+
   // Contains the enumeration and the substring slice of the last lexed token.
   TokenInfo last_token_;
 
@@ -0,0 +1,103 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/strings/fingerprint.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+
+namespace verible {
+
+static constexpr uint64_t kMul1 = 0x87c37b91114253d5ULL;
+static constexpr uint64_t kMul2 = 0x4cf5ad432745937fULL;
+
+static inline uint64_t Rotate(uint64_t x, int bits) {
+  return (x << bits) | (x >> (64 - bits));
+}
+
+// Final avalanche of MurmurHash3.
+static inline uint64_t Mix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+// Reads 8 bytes in little-endian order, independent of the host.
+static inline uint64_t LoadWord(const unsigned char* p) {
+  uint64_t word = 0;
+  for (int i = 7; i >= 0; --i) word = (word << 8) | p[i];
+  return word;
+}
+
+std::string Fingerprint::ToHex() const {
+  return absl::StrFormat("%016x%016x", high, low);
+}
+
+// Processes 16 bytes per step in two lanes, like MurmurHash3_x64_128.
+Fingerprint FingerprintOf(absl::string_view data) {
+  const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  const size_t length = data.length();
+  uint64_t h1 = 0x9e3779b97f4a7c15ULL;
+  uint64_t h2 = 0x7f4a7c159e3779b9ULL;
+
+  const auto absorb = [&h1, &h2](uint64_t k1, uint64_t k2) {
+    h1 ^= Rotate(k1 * kMul1, 31) * kMul2;
+    h1 = (Rotate(h1, 27) + h2) * 5 + 0x52dce729;
+    h2 ^= Rotate(k2 * kMul2, 33) * kMul1;
+    h2 = (Rotate(h2, 31) + h1) * 5 + 0x38495ab5;
+  };
+
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    absorb(LoadWord(p + i), LoadWord(p + i + 8));
+  }
+  // Zero-pad the tail.  The length, mixed in below, tells apart trailing
+  // zero bytes from padding.
+  if (i < length) {
+    unsigned char tail[16] = {};
+    std::memcpy(tail, p + i, length - i);
+    absorb(LoadWord(tail), LoadWord(tail + 8));
+  }
+
+  h1 ^= length;
+  h2 ^= length;
+  h1 += h2;
+  h2 += h1;
+  h1 = Mix(h1);
+  h2 = Mix(h2);
+  h1 += h2;
+  h2 += h1;
+  return {h1, h2};
+}
+
+Fingerprint CombineFingerprints(const Fingerprint& a, const Fingerprint& b) {
+  unsigned char bytes[32];
+  for (int i = 0; i < 8; ++i) {
+    bytes[i] = a.high >> (8 * i);
+    bytes[8 + i] = a.low >> (8 * i);
+    bytes[16 + i] = b.high >> (8 * i);
+    bytes[24 + i] = b.low >> (8 * i);
+  }
+  return FingerprintOf(
+      absl::string_view(reinterpret_cast<const char*>(bytes), sizeof(bytes)));
+}
+
+}  // namespace verible
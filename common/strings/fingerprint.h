@@ -0,0 +1,52 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_STRINGS_FINGERPRINT_H_
+#define VERIBLE_COMMON_STRINGS_FINGERPRINT_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace verible {
+
+// Fingerprint is a 128-bit, non-cryptographic hash of a string.
+// Unlike absl::Hash, fingerprints are the same in every process, so they can
+// be persisted, e.g. as keys of an on-disk cache.
+struct Fingerprint {
+  uint64_t high = 0;
+  uint64_t low = 0;
+
+  bool operator==(const Fingerprint& other) const {
+    return high == other.high && low == other.low;
+  }
+  bool operator!=(const Fingerprint& other) const { return !(*this == other); }
+
+  // Returns 32 lower-case hexadecimal digits.
+  std::string ToHex() const;
+};
+
+// Returns the fingerprint of 'data'.
+Fingerprint FingerprintOf(absl::string_view data);
+
+// Returns the fingerprint of the sequence of fingerprints ('a', 'b').
+// This is not commutative.  Since the fingerprint of a string depends on its
+// length, combining the fingerprints of the parts of a sequence of strings
+// distinguishes {"ab", "c"} from {"a", "bc"}.
+Fingerprint CombineFingerprints(const Fingerprint& a, const Fingerprint& b);
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_STRINGS_FINGERPRINT_H_
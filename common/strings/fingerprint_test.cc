@@ -0,0 +1,61 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/strings/fingerprint.h"
+
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace verible {
+namespace {
+
+TEST(FingerprintTest, Deterministic) {
+  EXPECT_EQ(FingerprintOf("hello"), FingerprintOf(std::string("hello")));
+  EXPECT_EQ(FingerprintOf(""), FingerprintOf(""));
+}
+
+// Fingerprints are persisted, so they must never change.
+TEST(FingerprintTest, StableValues) {
+  EXPECT_EQ(FingerprintOf("").ToHex(), "071348cf74af280ce3432ede9e0385d8");
+  EXPECT_EQ(FingerprintOf("verible").ToHex(),
+            "a43d93fb7011cf6169472214fdf9a559");
+}
+
+TEST(FingerprintTest, DistinguishesLengthAndContent) {
+  std::set<std::string> seen;
+  std::string text;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(seen.insert(FingerprintOf(text).ToHex()).second) << i;
+    text.push_back('\0');
+  }
+  text = "abcdefghijklmnopqrstuvwxyz0123456789";
+  for (size_t i = 0; i < text.length(); ++i) {
+    std::string changed(text);
+    changed[i] ^= 1;
+    EXPECT_NE(FingerprintOf(changed), FingerprintOf(text)) << i;
+  }
+}
+
+TEST(FingerprintTest, CombineIsOrderSensitive) {
+  const Fingerprint a = FingerprintOf("a");
+  const Fingerprint bc = FingerprintOf("bc");
+  EXPECT_NE(CombineFingerprints(a, bc), CombineFingerprints(bc, a));
+  EXPECT_NE(CombineFingerprints(a, bc),
+            CombineFingerprints(FingerprintOf("ab"), FingerprintOf("c")));
+}
+
+}  // namespace
+}  // namespace verible
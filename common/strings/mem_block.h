@@ -0,0 +1,59 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_STRINGS_MEM_BLOCK_H_
+#define VERIBLE_COMMON_STRINGS_MEM_BLOCK_H_
+
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+
+namespace verible {
+
+// MemBlock is an abstract owner of a contiguous, read-only block of text,
+// such as the contents of a file.  Implementations may hold the text in a
+// string, or in memory mapped from a file.
+// Users should only depend on the lifetime of the MemBlock object, and not
+// on how the memory is held.
+class MemBlock {
+ public:
+  virtual ~MemBlock() {}
+
+  // Returns a view of the whole block.  The view is valid for the lifetime of
+  // this object.
+  virtual absl::string_view AsStringView() const = 0;
+};
+
+// StringMemBlock is a MemBlock backed by an owned std::string.
+class StringMemBlock final : public MemBlock {
+ public:
+  StringMemBlock() {}
+  explicit StringMemBlock(std::string content) : content_(std::move(content)) {}
+  explicit StringMemBlock(absl::string_view content)
+      : content_(content.begin(), content.end()) {}
+
+  // Allows filling the block in-place, e.g. when reading a stream.
+  // Must not be called once views into the block have been handed out.
+  std::string* mutable_content() { return &content_; }
+
+  absl::string_view AsStringView() const override { return content_; }
+
+ private:
+  std::string content_;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_STRINGS_MEM_BLOCK_H_
@@ -14,17 +14,36 @@
 
 #include "common/text/concrete_syntax_leaf.h"
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <new>
 
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/tree_compare.h"
 #include "common/text/visitors.h"
+#include "common/util/block_pool.h"
 #include "common/util/logging.h"
 
 namespace verible {
 
+using LeafPool = BlockPool<sizeof(SyntaxTreeLeaf)>;
+
+void *SyntaxTreeLeaf::operator new(size_t size) {
+  // Subclasses (if any) fall back to the general allocator.
+  if (size != sizeof(SyntaxTreeLeaf)) return ::operator new(size);
+  return LeafPool::Allocate();
+}
+
+void SyntaxTreeLeaf::operator delete(void *p, size_t size) {
+  if (size != sizeof(SyntaxTreeLeaf)) {
+    ::operator delete(p);
+    return;
+  }
+  LeafPool::Deallocate(p);
+}
+
 // Tests if this is equal to SymbolPtr under compare_tokens function
 bool SyntaxTreeLeaf::equals(const Symbol *symbol,
                             const TokenComparator &compare_tokens) const {
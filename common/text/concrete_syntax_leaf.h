@@ -18,6 +18,7 @@
 #ifndef VERIBLE_COMMON_TEXT_CONCRETE_SYNTAX_LEAF_H_
 #define VERIBLE_COMMON_TEXT_CONCRETE_SYNTAX_LEAF_H_
 
+#include <cstddef>
 #include <iosfwd>
 #include <utility>
 
@@ -62,6 +63,13 @@ class SyntaxTreeLeaf : public Symbol {
   SymbolKind Kind() const override { return SymbolKind::kLeaf; }
   SymbolTag Tag() const override { return LeafTag(get().token_enum()); }
 
+  // Leaves are allocated from a pool of recycled memory blocks (BlockPool),
+  // which is much cheaper than the general allocator for the large numbers
+  // of leaves created by parsing.  The pool keeps the memory of freed leaves
+  // for re-use, and never returns it to the system.
+  static void* operator new(size_t size);
+  static void operator delete(void* p, size_t size);
+
  private:
   TokenInfo token_;
 };
@@ -14,17 +14,36 @@
 
 #include "common/text/concrete_syntax_tree.h"
 
+#include <cstddef>
 #include <memory>
+#include <new>
 #include <utility>
 #include <vector>
 
 #include "common/text/symbol.h"
 #include "common/text/tree_compare.h"
 #include "common/text/visitors.h"
+#include "common/util/block_pool.h"
 #include "common/util/logging.h"
 
 namespace verible {
 
+using NodePool = BlockPool<sizeof(SyntaxTreeNode)>;
+
+void* SyntaxTreeNode::operator new(size_t size) {
+  // Subclasses (if any) fall back to the general allocator.
+  if (size != sizeof(SyntaxTreeNode)) return ::operator new(size);
+  return NodePool::Allocate();
+}
+
+void SyntaxTreeNode::operator delete(void* p, size_t size) {
+  if (size != sizeof(SyntaxTreeNode)) {
+    ::operator delete(p);
+    return;
+  }
+  NodePool::Deallocate(p);
+}
+
 // Checks if this is equal to SymbolPtr node under compare_token function
 bool SyntaxTreeNode::equals(const Symbol* symbol,
                             const TokenComparator& compare_tokens) const {
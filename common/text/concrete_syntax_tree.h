@@ -156,6 +156,11 @@ class SyntaxTreeNode : public Symbol {
     return iter != enums.end();
   }
 
+  // Nodes are allocated from a pool of recycled memory blocks (BlockPool),
+  // like SyntaxTreeLeaf, whose memory is never returned to the system.
+  static void* operator new(size_t size);
+  static void operator delete(void* p, size_t size);
+
  private:
   // This tag would really prefer to be a language-specific node enumeration
   // type, but that would (IMHO) create unecessary templating.
@@ -175,6 +180,7 @@ class SyntaxTreeNode : public Symbol {
 template <typename... Args>
 SymbolPtr MakeNode(Args&&... args) {
   std::unique_ptr<SyntaxTreeNode> node_pointer(new SyntaxTreeNode);
+  node_pointer->mutable_children().reserve(sizeof...(Args));
   node_pointer->Append(std::forward<Args>(args)...);
   return std::move(node_pointer);
 }
@@ -188,6 +194,7 @@ template <typename Enum, typename... Args>
 SymbolPtr MakeTaggedNode(const Enum tag, Args&&... args) {
   std::unique_ptr<SyntaxTreeNode> node_pointer(
       new SyntaxTreeNode(static_cast<int>(tag)));
+  node_pointer->mutable_children().reserve(sizeof...(Args));
   node_pointer->Append(std::forward<Args>(args)...);
   return std::move(node_pointer);
 }
@@ -0,0 +1,82 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures construction and destruction of syntax trees, built the same way
+// that parser semantic actions build them.
+// Each benchmark also reports the peak resident set size of the process
+// (peak_rss_kb), which grows with the largest tree built so far.
+
+#include <sys/resource.h>
+
+#include "benchmark/benchmark.h"
+#include "common/text/concrete_syntax_leaf.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/token_info.h"
+
+namespace verible {
+namespace {
+
+// Returns the peak resident set size of this process, in kilobytes.
+double PeakRssKilobytes() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Builds a list of 'num_items' statement-like subtrees, each with 6 leaves:
+//   item: id '=' expr ';'
+//   expr: id '+' id
+SymbolPtr BuildTree(int num_items) {
+  const TokenInfo token(1, "x");
+  SymbolPtr list = MakeTaggedNode(1);
+  for (int i = 0; i < num_items; ++i) {
+    SymbolPtr id(new SyntaxTreeLeaf(token));
+    SymbolPtr equals(new SyntaxTreeLeaf(token));
+    SymbolPtr lhs(new SyntaxTreeLeaf(token));
+    SymbolPtr plus(new SyntaxTreeLeaf(token));
+    SymbolPtr rhs(new SyntaxTreeLeaf(token));
+    SymbolPtr semicolon(new SyntaxTreeLeaf(token));
+    SymbolPtr expr = MakeTaggedNode(3, lhs, plus, rhs);
+    SymbolPtr item = MakeTaggedNode(2, id, equals, expr, semicolon);
+    list = ExtendNode(list, item);
+  }
+  return list;
+}
+
+void BM_BuildAndDestroyTree(benchmark::State& state) {
+  for (auto _ : state) {
+    SymbolPtr tree = BuildTree(state.range(0));
+    benchmark::DoNotOptimize(tree.get());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["peak_rss_kb"] = PeakRssKilobytes();
+}
+
+BENCHMARK(BM_BuildAndDestroyTree)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+void BM_DestroyTree(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    SymbolPtr tree = BuildTree(state.range(0));
+    state.ResumeTiming();
+    tree.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["peak_rss_kb"] = PeakRssKilobytes();
+}
+
+BENCHMARK(BM_DestroyTree)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+}  // namespace
+}  // namespace verible
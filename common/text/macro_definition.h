@@ -84,6 +84,9 @@ class MacroDefinition {
 
   absl::string_view Name() const { return name_.text(); }
 
+  // Returns the directive that starts the definition, e.g. "`define".
+  const TokenInfo& Header() const { return header_; }
+
   const TokenInfo& DefinitionText() const { return definition_text_; }
 
   void SetDefinitionText(const TokenInfo& t) { definition_text_ = t; }
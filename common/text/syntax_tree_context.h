@@ -42,6 +42,16 @@ class SyntaxTreeContext : public AutoPopStack<const SyntaxTreeNode*> {
   // member class to handle push and pop of stack safely
   using AutoPop = base_type::AutoPop;
 
+  SyntaxTreeContext() = default;
+
+  // Constructs a context from a sequence of ancestors, outermost first.
+  explicit SyntaxTreeContext(
+      const std::vector<const SyntaxTreeNode*>& ancestors) {
+    for (const SyntaxTreeNode* ancestor : ancestors) {
+      Push(ABSL_DIE_IF_NULL(ancestor));
+    }
+  }
+
  protected:
   // restrict access to AutoPopStack<>::top method only to this class
   using base_type::top;
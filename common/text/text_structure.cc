@@ -30,6 +30,7 @@
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "common/strings/line_column_map.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
@@ -397,16 +398,15 @@ static void CopyTokensAndView(TokenSequence* destination,
   }
 }
 
-// Incrementally copies a slice of tokens and expands a single subtree.
-// This advances the next_token_iter and next_token_view_iter iterators.
-// The subtree from the expansion is transferred into this objects's syntax
-// tree.  Indices into the final token stream view are collected in
-// token_view_indices.  Offset is the location of each expansion point.
-void TextStructureView::ConsumeDeferredExpansion(
+// Copies the tokens (and partial view) from the next_token_iter and
+// next_token_view_iter iterators up to the token at 'offset', and advances
+// both iterators to that token.  Indices into the final token stream view are
+// collected in token_view_indices.
+void TextStructureView::CopyTokensUpToOffset(
     TokenSequence::const_iterator* next_token_iter,
     TokenStreamView::const_iterator* next_token_view_iter,
-    DeferredExpansion* expansion, TokenSequence* combined_tokens,
-    std::vector<int>* token_view_indices, const char* offset) {
+    TokenSequence* combined_tokens, std::vector<int>* token_view_indices,
+    const char* offset) const {
   auto token_iter = *next_token_iter;
   auto token_view_iter = *next_token_view_iter;
   // Find the position up to each expansion point.
@@ -427,6 +427,41 @@ void TextStructureView::ConsumeDeferredExpansion(
   CopyTokensAndView(combined_tokens, token_view_indices,
                     make_range(token_iter, *next_token_iter),
                     make_range(token_view_iter, *next_token_view_iter));
+}
+
+// Replaces tokens_ with combined_tokens, and tokens_view_ with the iterators
+// at token_view_indices into the new sequence.
+void TextStructureView::CommitCombinedTokens(
+    TokenSequence* combined_tokens,
+    const std::vector<int>& token_view_indices) {
+  // Commit the newly expanded sequence of tokens.
+  tokens_.swap(*combined_tokens);
+
+  // Reconstruct view iterators from indices into the new sequence.
+  tokens_view_.clear();
+  tokens_view_.reserve(token_view_indices.size());
+  for (const auto index : token_view_indices) {
+    tokens_view_.push_back(tokens_.cbegin() + index);
+  }
+
+  // Recalculate line-by-line token ranges.
+  // TODO(fangism): Should be possible to update line_token_map_ incrementally
+  // as well.
+  CalculateFirstTokensPerLine();
+}
+
+// Incrementally copies a slice of tokens and expands a single subtree.
+// This advances the next_token_iter and next_token_view_iter iterators.
+// The subtree from the expansion is transferred into this objects's syntax
+// tree.  Indices into the final token stream view are collected in
+// token_view_indices.  Offset is the location of each expansion point.
+void TextStructureView::ConsumeDeferredExpansion(
+    TokenSequence::const_iterator* next_token_iter,
+    TokenStreamView::const_iterator* next_token_view_iter,
+    DeferredExpansion* expansion, TokenSequence* combined_tokens,
+    std::vector<int>* token_view_indices, const char* offset) {
+  CopyTokensUpToOffset(next_token_iter, next_token_view_iter, combined_tokens,
+                       token_view_indices, offset);
 
   // Adjust locations of tokens in the expanded tree by pointing them
   // into the original text (contents_).
@@ -458,8 +493,11 @@ void TextStructureView::ConsumeDeferredExpansion(
 }
 
 TextStructure::TextStructure(absl::string_view contents)
-    : owned_contents_(contents), data_(owned_contents_) {
-  // Internal string_view must point to memory owned by owned_contents_.
+    : TextStructure(std::make_shared<StringMemBlock>(contents)) {}
+
+TextStructure::TextStructure(std::shared_ptr<MemBlock> contents)
+    : contents_(std::move(contents)), data_(contents_->AsStringView()) {
+  // Internal string_view must point to memory owned by contents_.
   const absl::Status status = InternalConsistencyCheck();
   CHECK(status.ok()) << status.message() << " (in ctor)";
 }
@@ -488,28 +526,57 @@ void TextStructureView::ExpandSubtrees(NodeExpansionMap* expansions) {
                     make_range(token_iter, tokens_.cend()),
                     make_range(token_view_iter, tokens_view_.cend()));
 
-  // Commit the newly expanded sequence of tokens.
-  tokens_.swap(combined_tokens);
+  CommitCombinedTokens(&combined_tokens, combined_token_view_indices);
+}
 
-  // Reconstruct view iterators from indices into the new sequence.
-  tokens_view_.clear();
-  tokens_view_.reserve(combined_token_view_indices.size());
-  for (const auto index : combined_token_view_indices) {
-    tokens_view_.push_back(tokens_.cbegin() + index);
+void TextStructureView::SpliceSubtrees(std::vector<SubtreeSplice>* splices) {
+  if (splices->empty()) return;
+  TokenSequence combined_tokens;
+  combined_tokens.reserve(tokens_.size());
+  std::vector<int> combined_token_view_indices;
+  combined_token_view_indices.reserve(tokens_view_.size());
+  auto token_iter = tokens_.cbegin();
+  auto token_view_iter = tokens_view_.cbegin();
+  for (auto& splice : *splices) {
+    const SyntaxTreeLeaf& leaf =
+        SymbolCastToLeaf(*ABSL_DIE_IF_NULL(*splice.expansion_point));
+    const absl::string_view leaf_text = leaf.get().text();
+    CHECK(IsSubRange(leaf_text, contents_));
+    CopyTokensUpToOffset(&token_iter, &token_view_iter, &combined_tokens,
+                         &combined_token_view_indices, leaf_text.begin());
+    CHECK(BoundsEqual(token_iter->text(), leaf_text));
+
+    // Splice the replacement's tokens in place of the leaf's token.
+    const int base_index = combined_tokens.size();
+    for (const int index : splice.token_view_indices) {
+      combined_token_view_indices.push_back(base_index + index);
+    }
+    for (auto& token : splice.tokens) {
+      CHECK(IsSubRange(token.text(), leaf_text));
+      combined_tokens.push_back(std::move(token));
+    }
+    *splice.expansion_point = std::move(splice.subtree);
+
+    // Advance one past expansion point to skip over expanded token.
+    ++token_iter;
+    ++token_view_iter;
   }
+  splices->clear();
 
-  // Recalculate line-by-line token ranges.
-  // TODO(fangism): Should be possible to update line_token_map_ incrementally
-  // as well.
-  CalculateFirstTokensPerLine();
+  // Copy the remaining tokens beyond the last expansion point.
+  CopyTokensAndView(&combined_tokens, &combined_token_view_indices,
+                    make_range(token_iter, tokens_.cend()),
+                    make_range(token_view_iter, tokens_view_.cend()));
+
+  CommitCombinedTokens(&combined_tokens, combined_token_view_indices);
 }
 
 absl::Status TextStructure::StringViewConsistencyCheck() const {
   const absl::string_view contents = data_.Contents();
   if (!contents.empty() &&
-      !IsSubRange(contents, absl::string_view(owned_contents_))) {
+      !IsSubRange(contents, contents_->AsStringView())) {
     return absl::InternalError(
-        "string_view contents_ is not a substring of owned_contents_, "
+        "string_view contents_ is not a substring of owned contents_, "
         "contents_ might reference deallocated memory!");
   }
   return absl::OkStatus();
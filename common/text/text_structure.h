@@ -35,6 +35,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "common/strings/line_column_map.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/token_stream_view.h"
@@ -65,6 +66,25 @@ class TextStructureView {
   // expansion is encountered.
   using NodeExpansionMap = std::map<int, DeferredExpansion>;
 
+  // In-place replacement of a syntax tree leaf with a subtree whose tokens
+  // already point into this structure's text, so that, unlike a
+  // DeferredExpansion, it needs neither a separately owned analysis nor
+  // rebasing.
+  struct SubtreeSplice {
+    // Position in the syntax tree to replace (leaf).
+    std::unique_ptr<Symbol>* expansion_point;
+
+    // Subtree that replaces the leaf at expansion_point.
+    std::unique_ptr<Symbol> subtree;
+
+    // Tokens that span the text of the replaced leaf, without EOF.
+    TokenSequence tokens;
+
+    // Indices of the elements of 'tokens' that belong in the token stream
+    // view, in increasing order.
+    std::vector<int> token_view_indices;
+  };
+
   explicit TextStructureView(absl::string_view contents);
 
   ~TextStructureView();
@@ -150,6 +170,11 @@ class TextStructureView {
   // by this function.
   void ExpandSubtrees(NodeExpansionMap* expansions);
 
+  // SpliceSubtrees is like ExpandSubtrees, for replacements that already
+  // point into Contents().  'splices' must be ordered by the position of the
+  // replaced leaves, and their contents are consumed by this function.
+  void SpliceSubtrees(std::vector<SubtreeSplice>* splices);
+
   // All of this class's consistency checks combined.
   absl::Status InternalConsistencyCheck() const;
 
@@ -186,6 +211,15 @@ class TextStructureView {
   void TrimContents(int left_offset, int length);
   void SplitLines();
 
+  void CopyTokensUpToOffset(
+      TokenSequence::const_iterator* next_token_iter,
+      TokenStreamView::const_iterator* next_token_view_iter,
+      TokenSequence* combined_tokens, std::vector<int>* token_view_indices,
+      const char* offset) const;
+
+  void CommitCombinedTokens(TokenSequence* combined_tokens,
+                            const std::vector<int>& token_view_indices);
+
   void ConsumeDeferredExpansion(
       TokenSequence::const_iterator* next_token_iter,
       TokenStreamView::const_iterator* next_token_view_iter,
@@ -211,8 +245,13 @@ class TextStructureView {
 // the same owned memory can be used for multiple analysis views.
 class TextStructure {
  public:
+  // Copies 'contents' into memory owned by this object.
   explicit TextStructure(absl::string_view contents);
 
+  // Shares ownership of 'contents' without copying, e.g. a memory-mapped
+  // file.
+  explicit TextStructure(std::shared_ptr<MemBlock> contents);
+
   // DeferredExpansion::subanalysis requires this destructor to be virtual.
   virtual ~TextStructure();
 
@@ -222,20 +261,18 @@ class TextStructure {
 
   const ConcreteSyntaxTree& SyntaxTree() const { return data_.SyntaxTree(); }
 
-  // Verify that string_views are inside memory owned by owned_contents_.
+  // Verify that string_views are inside memory owned by contents_.
   absl::Status StringViewConsistencyCheck() const;
 
   // Verify that internal data structures have valid ranges.
   absl::Status InternalConsistencyCheck() const;
 
  protected:
-  // This string owns the memory referenced by all substring string_views
+  // This owns the memory referenced by all substring string_views
   // in this object.
-  // TODO(hzeller): avoid local copy and just require that the string-view
-  // we are called with outlives this object?
-  const std::string owned_contents_;
+  const std::shared_ptr<MemBlock> contents_;
 
-  // The data_ object's string_views are owned by owned_contents_.
+  // The data_ object's string_views are owned by contents_.
   TextStructureView data_;
 };
 
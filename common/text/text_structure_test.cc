@@ -19,6 +19,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -28,6 +29,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "common/strings/line_column_map.h"
+#include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/text_structure_test_utils.h"
@@ -492,6 +494,63 @@ TEST_F(TextStructureViewPublicTest, ExpandSubtreesMultipleLeaves) {
   EXPECT_TRUE(EqualTrees(syntax_tree_.get(), expect_tree.get()));
 }
 
+// Test that SpliceSubtrees on no splices changes nothing.
+TEST_F(TextStructureViewPublicTest, SpliceSubtreesEmpty) {
+  const auto expect_tree =
+      Node(Leaf(tokens_[0]), Leaf(tokens_[1]), Leaf(tokens_[3]));
+  std::vector<TextStructureView::SubtreeSplice> splices;
+  SpliceSubtrees(&splices);
+  EXPECT_TRUE(EqualTrees(syntax_tree_.get(), expect_tree.get()));
+  EXPECT_THAT(tokens_, SizeIs(4));
+  EXPECT_THAT(tokens_view_, SizeIs(3));
+}
+
+// Test that SpliceSubtrees replaces leaves with subtrees, and their tokens.
+TEST_F(TextStructureViewPublicTest, SpliceSubtreesMultipleLeaves) {
+  const int divide1 = 3;
+  const int new_node_tag1 = 7;
+  const int divide2 = 2;
+  const int new_node_tag2 = 9;
+  auto& children =
+      down_cast<SyntaxTreeNode*>(syntax_tree_.get())->mutable_children();
+  std::vector<TextStructureView::SubtreeSplice> splices;
+  for (const auto& split : {std::make_tuple(0, divide1, new_node_tag1),
+                            std::make_tuple(2, divide2, new_node_tag2)}) {
+    // Expand a token into two, like ("hel", "lo") and ("wo", "rld").
+    const int child = std::get<0>(split);
+    const int divide = std::get<1>(split);
+    const absl::string_view text =
+        down_cast<const SyntaxTreeLeaf&>(*children[child]).get().text();
+    TextStructureView::SubtreeSplice splice;
+    splice.expansion_point = &children[child];
+    splice.tokens.push_back(TokenInfo(11, text.substr(0, divide)));
+    splice.tokens.push_back(TokenInfo(12, text.substr(divide)));
+    splice.token_view_indices = {0, 1};
+    splice.subtree = TNode(std::get<2>(split), Leaf(splice.tokens[0]),
+                           Leaf(splice.tokens[1]));
+    splices.push_back(std::move(splice));
+  }
+  const auto expect_tree = Node(                             // noformat
+      TNode(new_node_tag1,                                   // noformat
+            Leaf(11, tokens_[0].text().substr(0, divide1)),  // noformat
+            Leaf(12, tokens_[0].text().substr(divide1))      // noformat
+            ),                                               // noformat
+      Leaf(tokens_[1]),                                      // noformat
+      TNode(new_node_tag2,                                   // noformat
+            Leaf(11, tokens_[3].text().substr(0, divide2)),  // noformat
+            Leaf(12, tokens_[3].text().substr(divide2))      // noformat
+            )                                                // noformat
+  );
+  SpliceSubtrees(&splices);
+  EXPECT_THAT(splices, IsEmpty());
+  EXPECT_TRUE(EqualTrees(syntax_tree_.get(), expect_tree.get()));
+  EXPECT_THAT(tokens_, SizeIs(6));
+  EXPECT_THAT(tokens_view_, SizeIs(5));
+  EXPECT_EQ(tokens_[4].text(), "wo");
+  EXPECT_EQ(tokens_view_[3], tokens_.begin() + 4);
+  EXPECT_TRUE(InternalConsistencyCheck().ok());
+}
+
 // The following tests intentionally cause internal violations to
 // make sure the consistency checks work as intended.
 // The mutated fields are restored so that the consistency checks
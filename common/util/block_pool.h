@@ -0,0 +1,137 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_UTIL_BLOCK_POOL_H_
+#define VERIBLE_COMMON_UTIL_BLOCK_POOL_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace verible {
+
+// BlockPool<kBlockSize> hands out fixed-size blocks of memory, carved out of
+// large chunks, and recycles freed blocks instead of returning them to the
+// system allocator.  This is intended for class-specific operator new/delete
+// of small objects that are created and destroyed in very large numbers,
+// such as syntax tree nodes.
+//
+// Each thread allocates from and frees into its own free list, without
+// locking.  Blocks may be freed by a different thread than the one that
+// allocated them.  When a thread exits, its free list is handed over to a
+// shared list from which other threads refill.
+//
+// Freed blocks are never returned to the system: chunks are kept for the
+// lifetime of the program, so the memory held by a pool stays at what its
+// peak number of live blocks needed, even after all blocks are freed.  This
+// suits programs whose live object count stays near its peak (or that exit
+// soon after), but not long-running programs that briefly need many blocks
+// and then far fewer.
+template <size_t kBlockSize, size_t kBlocksPerChunk = 1024>
+class BlockPool {
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+  static_assert(kBlockSize >= sizeof(FreeBlock), "Block size too small.");
+
+  // Blocks are laid out contiguously, so round up to keep them aligned.
+  static constexpr size_t kAlignedBlockSize =
+      (kBlockSize + alignof(std::max_align_t) - 1) /
+      alignof(std::max_align_t) * alignof(std::max_align_t);
+
+ public:
+  BlockPool() = delete;
+
+  // Returns a block of at least kBlockSize bytes, suitably aligned for any
+  // object of that size.
+  static void* Allocate() {
+    FreeBlock*& head = LocalFreeList().head;
+    if (head == nullptr) head = Refill();
+    FreeBlock* block = head;
+    head = block->next;
+    return block;
+  }
+
+  // Returns a block obtained from Allocate() to the pool.
+  static void Deallocate(void* p) {
+    auto* block = static_cast<FreeBlock*>(p);
+    FreeBlock*& head = LocalFreeList().head;
+    block->next = head;
+    head = block;
+  }
+
+ private:
+  struct SharedState {
+    absl::Mutex lock;
+    // Blocks given back by exited threads.
+    FreeBlock* head ABSL_GUARDED_BY(lock) = nullptr;
+    // All chunks ever allocated (keeps them reachable for leak checkers).
+    std::vector<void*> chunks ABSL_GUARDED_BY(lock);
+  };
+
+  struct ThreadState {
+    FreeBlock* head = nullptr;
+
+    ~ThreadState() {
+      if (head == nullptr) return;
+      FreeBlock* tail = head;
+      while (tail->next != nullptr) tail = tail->next;
+      SharedState& shared = Shared();
+      absl::MutexLock l(&shared.lock);
+      tail->next = shared.head;
+      shared.head = head;
+      head = nullptr;
+    }
+  };
+
+  static SharedState& Shared() {
+    static auto* const shared = new SharedState;  // never destroyed
+    return *shared;
+  }
+
+  static ThreadState& LocalFreeList() {
+    static thread_local ThreadState state;
+    return state;
+  }
+
+  // Returns a non-empty list of free blocks, taken from the shared list,
+  // or from a new chunk.
+  static FreeBlock* Refill() {
+    SharedState& shared = Shared();
+    absl::MutexLock l(&shared.lock);
+    if (shared.head != nullptr) {
+      FreeBlock* list = shared.head;
+      shared.head = nullptr;
+      return list;
+    }
+    char* chunk =
+        static_cast<char*>(::operator new(kAlignedBlockSize * kBlocksPerChunk));
+    shared.chunks.push_back(chunk);
+    FreeBlock* list = nullptr;
+    for (size_t i = kBlocksPerChunk; i > 0; --i) {
+      auto* block =
+          reinterpret_cast<FreeBlock*>(chunk + (i - 1) * kAlignedBlockSize);
+      block->next = list;
+      list = block;
+    }
+    return list;
+  }
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_UTIL_BLOCK_POOL_H_
@@ -0,0 +1,90 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/block_pool.h"
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace verible {
+namespace {
+
+// Each test uses its own block size, to get a separate pool.
+
+TEST(BlockPoolTest, DistinctAlignedBlocks) {
+  using Pool = BlockPool<24, 4>;
+  std::set<void*> blocks;
+  for (int i = 0; i < 10; ++i) {  // spans multiple chunks
+    void* block = Pool::Allocate();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t),
+              0);
+    EXPECT_TRUE(blocks.insert(block).second);
+  }
+  for (void* block : blocks) Pool::Deallocate(block);
+}
+
+TEST(BlockPoolTest, RecyclesFreedBlocks) {
+  using Pool = BlockPool<40>;
+  void* first = Pool::Allocate();
+  Pool::Deallocate(first);
+  void* second = Pool::Allocate();
+  EXPECT_EQ(first, second);
+  Pool::Deallocate(second);
+}
+
+TEST(BlockPoolTest, BlocksAreWritable) {
+  using Pool = BlockPool<sizeof(int64_t) * 8, 16>;
+  std::vector<int64_t*> blocks;
+  for (int i = 0; i < 100; ++i) {
+    auto* block = static_cast<int64_t*>(Pool::Allocate());
+    for (int j = 0; j < 8; ++j) block[j] = i;
+    blocks.push_back(block);
+  }
+  for (int i = 0; i < 100; ++i) {
+    for (int j = 0; j < 8; ++j) EXPECT_EQ(blocks[i][j], i);
+  }
+  for (auto* block : blocks) Pool::Deallocate(block);
+}
+
+TEST(BlockPoolTest, FreeAcrossThreads) {
+  using Pool = BlockPool<56, 8>;
+  std::vector<void*> blocks;
+  std::thread producer([&blocks] {
+    for (int i = 0; i < 100; ++i) blocks.push_back(Pool::Allocate());
+  });
+  producer.join();
+  // Free blocks allocated by a thread that has exited, in another thread.
+  std::thread releaser([&blocks] {
+    for (void* block : blocks) Pool::Deallocate(block);
+  });
+  releaser.join();
+
+  // Blocks freed in an exited thread are reused by others.
+  std::vector<void*> recycled;
+  std::thread consumer([&recycled] {
+    void* block = Pool::Allocate();
+    recycled.push_back(block);
+    Pool::Deallocate(block);
+  });
+  consumer.join();
+  const std::set<void*> freed(blocks.begin(), blocks.end());
+  EXPECT_EQ(freed.count(recycled.front()), 1);
+}
+
+}  // namespace
+}  // namespace verible
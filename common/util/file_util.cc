@@ -16,18 +16,26 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <streambuf>
 #include <string>
+#include <utility>
 
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -35,6 +43,8 @@
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
+#include "absl/time/time.h"
+#include "common/strings/mem_block.h"
 #include "common/util/logging.h"
 
 namespace verible {
@@ -135,6 +145,33 @@ absl::Status FileExists(const std::string &filename) {
       absl::StrCat("file : ", filename, " does not exist"));
 }
 
+// Files changed within this long before the present are considered recent:
+// that is coarser than the timestamp granularity of common filesystems.
+static constexpr absl::Duration kRecentChangeWindow = absl::Seconds(1);
+
+bool FileVersion::IsRecent(absl::Time now) const {
+  return std::max(modification_time, change_time) > now - kRecentChangeWindow;
+}
+
+absl::StatusOr<FileVersion> GetFileVersion(absl::string_view filename) {
+  struct stat file_info;
+  if (stat(std::string(filename).c_str(), &file_info) != 0) {
+    return CreateErrorStatusFromErrno("can't stat");
+  }
+  FileVersion version;
+#ifdef __APPLE__
+  version.modification_time = absl::TimeFromTimespec(file_info.st_mtimespec);
+  version.change_time = absl::TimeFromTimespec(file_info.st_ctimespec);
+#else
+  version.modification_time = absl::TimeFromTimespec(file_info.st_mtim);
+  version.change_time = absl::TimeFromTimespec(file_info.st_ctim);
+#endif
+  version.size = file_info.st_size;
+  version.device = file_info.st_dev;
+  version.inode = file_info.st_ino;
+  return version;
+}
+
 absl::Status GetContents(absl::string_view filename, std::string *content) {
   std::ifstream fs;
   std::istream *stream = nullptr;
@@ -155,6 +192,79 @@ absl::Status GetContents(absl::string_view filename, std::string *content) {
   return absl::OkStatus();
 }
 
+namespace {
+// MemBlock backed by a read-only memory mapping of a whole file.
+class MemoryMappedBlock final : public MemBlock {
+ public:
+  MemoryMappedBlock(void *data, size_t size) : data_(data), size_(size) {}
+
+  MemoryMappedBlock(const MemoryMappedBlock &) = delete;
+  MemoryMappedBlock &operator=(const MemoryMappedBlock &) = delete;
+
+  ~MemoryMappedBlock() override { munmap(data_, size_); }
+
+  absl::string_view AsStringView() const override {
+    return absl::string_view(static_cast<const char *>(data_), size_);
+  }
+
+ private:
+  void *const data_;
+  const size_t size_;
+};
+}  // namespace
+
+// Files smaller than this are read instead of mapped: copying them costs
+// about as much as setting up a mapping, and a copy is immune to the file
+// being truncated while it is in use.
+static constexpr off_t kMinMappedFileSize = 64 * 1024;
+
+// Appends everything that can be read from 'fd' to 'content'.
+static absl::Status ReadAll(int fd, std::string *content) {
+  char buffer[64 * 1024];
+  while (true) {
+    const ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n == 0) return absl::OkStatus();
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return CreateErrorStatusFromErrno("can't read");
+    }
+    content->append(buffer, n);
+  }
+}
+
+absl::StatusOr<std::unique_ptr<MemBlock>> GetContentAsMemBlock(
+    absl::string_view filename) {
+  auto block = absl::make_unique<StringMemBlock>();
+  if (filename == "-") {
+    const absl::Status status = GetContents(filename, block->mutable_content());
+    if (!status.ok()) return status;
+    return std::unique_ptr<MemBlock>(std::move(block));
+  }
+  const int fd = open(std::string(filename).c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return CreateErrorStatusFromErrno("can't read");
+  struct stat file_info;
+  // Small files are cheaper to read, and non-regular files (e.g. pipes) may
+  // not support mapping; these are read from the open descriptor below, so
+  // that the content comes from the same file that was checked.
+  if (fstat(fd, &file_info) == 0 && S_ISREG(file_info.st_mode)) {
+    if (file_info.st_size >= kMinMappedFileSize) {
+      void *data =
+          mmap(nullptr, file_info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        close(fd);
+        return std::unique_ptr<MemBlock>(
+            new MemoryMappedBlock(data, file_info.st_size));
+      }
+      VLOG(1) << "Can't mmap " << filename << ", reading it instead.";
+    }
+    block->mutable_content()->reserve(file_info.st_size);
+  }
+  const absl::Status status = ReadAll(fd, block->mutable_content());
+  close(fd);
+  if (!status.ok()) return status;
+  return std::unique_ptr<MemBlock>(std::move(block));
+}
+
 absl::Status SetContents(absl::string_view filename,
                          absl::string_view content) {
   std::ofstream f(std::string(filename).c_str());
@@ -163,6 +273,68 @@ absl::Status SetContents(absl::string_view filename,
   return absl::OkStatus();
 }
 
+// Creates a new file next to 'path', with a name that no other writer, in this
+// or in another process, uses at the same time.  Unlike with mkstemp(), the
+// permissions of the file are subject to the umask, like those of any other
+// new file.
+static int CreateTemporaryFile(const std::string &path,
+                               std::string *temp_path) {
+  static std::atomic<uint64_t> counter(0);
+  while (true) {
+    *temp_path = absl::StrCat(path, ".tmp-", getpid(), "-", counter++);
+    const int fd =
+        open(temp_path->c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (fd >= 0 || errno != EEXIST) return fd;
+  }
+}
+
+absl::Status SetContentsAtomically(absl::string_view filename,
+                                   absl::string_view content) {
+  // Replace the target of a symbolic link, not the link itself.
+  std::string path(filename);
+  char resolved_path[PATH_MAX];
+  if (realpath(path.c_str(), resolved_path) != nullptr) path = resolved_path;
+
+  struct stat file_info;
+  const bool exists = stat(path.c_str(), &file_info) == 0;
+  // Renaming would detach the file from its other hard links.
+  if (exists && file_info.st_nlink > 1) return SetContents(path, content);
+
+  std::string temp_path;
+  const int fd = CreateTemporaryFile(path, &temp_path);
+  if (fd < 0) return CreateErrorStatusFromErrno("can't create temporary file");
+
+  if (exists) {
+    // Only privileged users can give away files, so if the owner can't be
+    // kept, write in place like SetContents() does.
+    if (fchown(fd, file_info.st_uid, file_info.st_gid) != 0) {
+      close(fd);
+      unlink(temp_path.c_str());
+      return SetContents(path, content);
+    }
+  }
+  // Set the permissions after the owner, as changing the owner may clear the
+  // set-user-ID and set-group-ID bits.
+  bool ok = !exists || fchmod(fd, file_info.st_mode & 07777) == 0;
+  for (const char *data = content.data(), *end = data + content.size();
+       ok && data < end;) {
+    const ssize_t written = write(fd, data, end - data);
+    if (written < 0 && errno == EINTR) continue;
+    ok = written > 0;
+    if (ok) data += written;
+  }
+  absl::Status status;
+  if (!ok) status = CreateErrorStatusFromErrno("can't write.");
+  if (close(fd) != 0 && status.ok()) {
+    status = CreateErrorStatusFromErrno("can't write.");
+  }
+  if (status.ok() && rename(temp_path.c_str(), path.c_str()) != 0) {
+    status = CreateErrorStatusFromErrno("can't rename.");
+  }
+  if (!status.ok()) unlink(temp_path.c_str());
+  return status;
+}
+
 std::string JoinPath(absl::string_view base, absl::string_view name) {
   return absl::StrCat(base, "/", name);
 }
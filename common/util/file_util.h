@@ -17,12 +17,16 @@
 #ifndef VERIBLE_COMMON_UTIL_FILE_UTIL_H_
 #define VERIBLE_COMMON_UTIL_FILE_UTIL_H_
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "common/strings/mem_block.h"
 
 namespace verible {
 namespace file {
@@ -62,12 +66,60 @@ absl::Status UpwardFileSearch(absl::string_view start,
 // Determines whether the given filename exists or not.
 absl::Status FileExists(const std::string& filename);
 
+// Status of a file that changes whenever its content may have changed: when
+// the file is written, or replaced by another one.  Timestamps are only as
+// fine as the filesystem keeps them, so a file written twice within one tick
+// may keep the same version; see FileVersion::IsRecent().
+struct FileVersion {
+  absl::Time modification_time = absl::InfinitePast();
+  absl::Time change_time = absl::InfinitePast();  // of status or content
+  int64_t size = -1;
+  uint64_t device = 0;
+  uint64_t inode = 0;
+
+  // Returns true if the file was changed so shortly before 'now' that it may
+  // be changed again without a change of version.  Values derived from such
+  // a file should not be cached.
+  bool IsRecent(absl::Time now) const;
+
+  bool operator==(const FileVersion& other) const {
+    return modification_time == other.modification_time &&
+           change_time == other.change_time && size == other.size &&
+           device == other.device && inode == other.inode;
+  }
+  bool operator!=(const FileVersion& other) const { return !(*this == other); }
+};
+
+// Returns the current version of "filename", which may be a directory.
+absl::StatusOr<FileVersion> GetFileVersion(absl::string_view filename);
+
 // Read file "filename" and store its content in "content"
 absl::Status GetContents(absl::string_view filename, std::string* content);
 
+// Returns the content of file "filename" without copying it where possible:
+// large regular files are memory-mapped, while small files, "-" (stdin),
+// pipes and files that can't be mapped are read into memory.
+// A mapped file must not be truncated or rewritten in place while the
+// returned block is alive: accessing pages beyond the new end of the file
+// raises SIGBUS, and in-place writes may show through the mapping.  Replacing
+// the file by renaming another one over it (see SetContentsAtomically()) is
+// safe.
+absl::StatusOr<std::unique_ptr<MemBlock>> GetContentAsMemBlock(
+    absl::string_view filename);
+
 // Create file "filename" and store given content in it.
 absl::Status SetContents(absl::string_view filename, absl::string_view content);
 
+// Replaces the content of file "filename" atomically: the content is written
+// to a temporary file in the same directory, which is then renamed to
+// "filename".  Readers see either the old or the new content, never a partial
+// one, and nothing is changed if writing fails.  An existing file keeps its
+// permissions and owner, and a symbolic link keeps pointing to it.  A new
+// file gets the permissions of the umask.  Files with several hard links, or
+// whose owner can't be kept, are written in place like with SetContents().
+absl::Status SetContentsAtomically(absl::string_view filename,
+                                   absl::string_view content);
+
 // Join directory + filename
 std::string JoinPath(absl::string_view base, absl::string_view name);
 
@@ -14,15 +14,21 @@
 
 #include "common/util/file_util.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 
 #undef EXPECT_OK
 #define EXPECT_OK(value) EXPECT_TRUE((value).ok())
+#undef ASSERT_OK
+#define ASSERT_OK(value) ASSERT_TRUE((value).ok())
 
 namespace verible {
 namespace util {
@@ -86,6 +92,101 @@ TEST(FileUtil, StatusErrorReporting) {
   EXPECT_EQ(status.code(), absl::StatusCode::kPermissionDenied) << status;
 }
 
+TEST(FileUtil, SetContentsAtomically) {
+  const std::string test_dir =
+      file::JoinPath(testing::TempDir(), "atomic_test_dir");
+  const std::string test_file = file::JoinPath(test_dir, "foo");
+  ASSERT_OK(file::CreateDir(test_dir));
+  unlink(test_file.c_str());  // Remove file if left from previous test.
+
+  std::string content;
+  EXPECT_OK(file::SetContentsAtomically(test_file, "first"));
+  EXPECT_OK(file::GetContents(test_file, &content));
+  EXPECT_EQ(content, "first");
+
+  // Replacing content keeps the permissions of the file.
+  ASSERT_EQ(chmod(test_file.c_str(), 0640), 0);
+  EXPECT_OK(file::SetContentsAtomically(test_file, "second"));
+  EXPECT_OK(file::GetContents(test_file, &content));
+  EXPECT_EQ(content, "second");
+  struct stat file_info;
+  ASSERT_EQ(stat(test_file.c_str(), &file_info), 0);
+  EXPECT_EQ(file_info.st_mode & 0777, 0640);
+
+  // No temporary files are left behind.
+  const auto dir = file::ListDir(test_dir);
+  ASSERT_OK(dir);
+  EXPECT_EQ(dir->files, std::vector<std::string>{test_file});
+
+  EXPECT_FALSE(
+      file::SetContentsAtomically(file::JoinPath(test_dir, "no/such/file"), "")
+          .ok());
+}
+
+TEST(FileUtil, SetContentsAtomicallyKeepsLinks) {
+  const std::string test_dir =
+      file::JoinPath(testing::TempDir(), "atomic_links_test_dir");
+  ASSERT_OK(file::CreateDir(test_dir));
+  const std::string target = file::JoinPath(test_dir, "target");
+  const std::string symlink_path = file::JoinPath(test_dir, "symlink");
+  const std::string hardlink_path = file::JoinPath(test_dir, "hardlink");
+  unlink(symlink_path.c_str());  // Remove files if left from previous test.
+  unlink(hardlink_path.c_str());
+  ASSERT_OK(file::SetContents(target, "first"));
+  ASSERT_EQ(symlink("target", symlink_path.c_str()), 0);
+  ASSERT_EQ(link(target.c_str(), hardlink_path.c_str()), 0);
+
+  // Writing through the symbolic link replaces its target.
+  EXPECT_OK(file::SetContentsAtomically(symlink_path, "second"));
+  struct stat file_info;
+  ASSERT_EQ(lstat(symlink_path.c_str(), &file_info), 0);
+  EXPECT_TRUE(S_ISLNK(file_info.st_mode));
+  std::string content;
+  EXPECT_OK(file::GetContents(hardlink_path, &content));
+  EXPECT_EQ(content, "second");
+
+  // Writing one hard link changes them all.
+  EXPECT_OK(file::SetContentsAtomically(hardlink_path, "third"));
+  EXPECT_OK(file::GetContents(target, &content));
+  EXPECT_EQ(content, "third");
+}
+
+TEST(FileUtil, SetContentsAtomicallyNewFileUsesUmask) {
+  const std::string test_file =
+      file::JoinPath(testing::TempDir(), "atomic_umask_test");
+  unlink(test_file.c_str());  // Remove file if left from previous test.
+  const mode_t saved_umask = umask(027);
+  EXPECT_OK(file::SetContentsAtomically(test_file, "content"));
+  umask(saved_umask);
+  struct stat file_info;
+  ASSERT_EQ(stat(test_file.c_str(), &file_info), 0);
+  EXPECT_EQ(file_info.st_mode & 0777, 0640);
+}
+
+TEST(FileUtil, GetFileVersion) {
+  const auto missing = file::GetFileVersion("does-not-exist");
+  EXPECT_FALSE(missing.ok());
+  EXPECT_EQ(missing.status().code(), absl::StatusCode::kNotFound);
+
+  const std::string test_file = file::JoinPath(testing::TempDir(), "test-ver");
+  EXPECT_OK(file::SetContents(test_file, "foo"));
+  const auto version = file::GetFileVersion(test_file);
+  ASSERT_OK(version);
+  EXPECT_EQ(version->size, 3);
+  EXPECT_TRUE(version->IsRecent(absl::Now()));
+  EXPECT_FALSE(version->IsRecent(absl::Now() + absl::Seconds(2)));
+
+  const auto unchanged = file::GetFileVersion(test_file);
+  ASSERT_OK(unchanged);
+  EXPECT_EQ(*unchanged, *version);
+
+  // Same modification time (on a coarse filesystem), different size.
+  EXPECT_OK(file::SetContents(test_file, "foobar"));
+  const auto changed = file::GetFileVersion(test_file);
+  ASSERT_OK(changed);
+  EXPECT_NE(*changed, *version);
+}
+
 TEST(FileUtil, ScopedTestFile) {
   const absl::string_view test_content = "Hello World!";
   file::testing::ScopedTestFile test_file(testing::TempDir(), test_content);
@@ -105,6 +206,50 @@ TEST(FileUtil, ScopedTestFileStdin) {
   EXPECT_EQ(test_content, read_back_content);
 }
 
+TEST(FileUtil, GetContentAsMemBlock) {
+  const absl::string_view test_content = "module m;\nendmodule\n";
+  file::testing::ScopedTestFile test_file(testing::TempDir(), test_content);
+  const auto block = file::GetContentAsMemBlock(test_file.filename());
+  ASSERT_OK(block);
+  EXPECT_EQ((*block)->AsStringView(), test_content);
+}
+
+TEST(FileUtil, GetContentAsMemBlockLargeFile) {
+  // Large enough to be memory-mapped.
+  const std::string test_content(1 << 20, 'x');
+  file::testing::ScopedTestFile test_file(testing::TempDir(), test_content);
+  const auto block = file::GetContentAsMemBlock(test_file.filename());
+  ASSERT_OK(block);
+  EXPECT_EQ((*block)->AsStringView(), test_content);
+}
+
+TEST(FileUtil, GetContentAsMemBlockEmptyFile) {
+  file::testing::ScopedTestFile test_file(testing::TempDir(), "");
+  const auto block = file::GetContentAsMemBlock(test_file.filename());
+  ASSERT_OK(block);
+  EXPECT_TRUE((*block)->AsStringView().empty());
+}
+
+TEST(FileUtil, GetContentAsMemBlockMissingFile) {
+  const auto block = file::GetContentAsMemBlock("does-not-exist");
+  EXPECT_FALSE(block.ok());
+  EXPECT_EQ(block.status().code(), absl::StatusCode::kNotFound);
+}
+
+TEST(FileUtil, GetContentAsMemBlockDirectory) {
+  // A directory can be opened, but not read.
+  const auto block = file::GetContentAsMemBlock(testing::TempDir());
+  EXPECT_FALSE(block.ok());
+}
+
+TEST(FileUtil, GetContentAsMemBlockStdin) {
+  // When running interactively, skip this test to avoid waiting for stdin.
+  if (isatty(STDIN_FILENO)) return;
+  const auto block = file::GetContentAsMemBlock("-");
+  ASSERT_OK(block);
+  EXPECT_TRUE((*block)->AsStringView().empty());
+}
+
 TEST(FileUtil, ReadEmptyDirectory) {
   const std::string test_dir = file::JoinPath(testing::TempDir(), "empty_dir");
   ASSERT_TRUE(file::CreateDir(test_dir).ok());
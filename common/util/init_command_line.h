@@ -15,6 +15,7 @@
 #ifndef VERIBLE_COMMON_UTIL_INIT_COMMAND_LINE_H_
 #define VERIBLE_COMMON_UTIL_INIT_COMMAND_LINE_H_
 
+#include <string>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -26,6 +27,10 @@ namespace verible {
 std::vector<char*> InitCommandLine(absl::string_view usage, int* argc,
                                    char*** argv);
 
+// Returns a description of the version of this build, as printed by
+// --version.  Empty if the build was not stamped with version information.
+std::string GetBuildVersion();
+
 }  // namespace verible
 
 #endif  // VERIBLE_COMMON_UTIL_INIT_COMMAND_LINE_H_
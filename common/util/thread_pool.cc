@@ -0,0 +1,74 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/thread_pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+
+namespace verible {
+
+ThreadPool::ThreadPool(int num_threads) {
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this] { Work(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock l(&lock_);
+    stopping_ = true;
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPool::Schedule(std::function<void()> fn) {
+  if (threads_.empty()) {
+    fn();
+    return;
+  }
+  absl::MutexLock l(&lock_);
+  queue_.push_back(std::move(fn));
+}
+
+int ThreadPool::DefaultNumThreads() {
+  return std::max<int>(1, std::thread::hardware_concurrency());
+}
+
+bool ThreadPool::HasWorkOrStopping() const {
+  return !queue_.empty() || stopping_;
+}
+
+void ThreadPool::Work() {
+  for (;;) {
+    std::function<void()> fn;
+    {
+      absl::MutexLock l(&lock_);
+      lock_.Await(absl::Condition(this, &ThreadPool::HasWorkOrStopping));
+      // Drain remaining work before honoring stopping_.
+      if (queue_.empty()) return;
+      fn = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    fn();
+  }
+}
+
+}  // namespace verible
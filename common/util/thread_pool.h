@@ -0,0 +1,82 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_UTIL_THREAD_POOL_H_
+#define VERIBLE_COMMON_UTIL_THREAD_POOL_H_
+
+#include <deque>
+#include <functional>
+#include <thread>  // IWYU pragma: keep
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace verible {
+
+// ThreadPool runs scheduled work items on a fixed set of worker threads.
+// Idle workers take the oldest pending item from a shared queue, so long
+// running items do not hold up the rest of the work.
+// Destruction blocks until every scheduled item has been run, including items
+// scheduled by other work items.
+//
+// Usage:
+//   {
+//     ThreadPool pool(4);
+//     for (...) pool.Schedule([=] { ... });
+//   }  // all work done here
+class ThreadPool {
+ public:
+  // Starts 'num_threads' workers.  With 'num_threads' <= 0, no threads are
+  // started, and Schedule() runs each work item immediately in the calling
+  // thread.
+  explicit ThreadPool(int num_threads);
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Waits for all pending work to complete, and joins all threads.
+  ~ThreadPool();
+
+  // Enqueues a work item to be run by the next available worker.
+  void Schedule(std::function<void()> fn);
+
+  // Returns the number of worker threads.
+  int NumThreads() const { return threads_.size(); }
+
+  // Returns a reasonable default number of threads for this machine
+  // (at least 1).
+  static int DefaultNumThreads();
+
+ private:
+  // Main loop of each worker thread.
+  void Work();
+
+  // Wake-up condition for idle workers.
+  bool HasWorkOrStopping() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  absl::Mutex lock_;
+
+  // Pending work items, oldest first.
+  std::deque<std::function<void()>> queue_ ABSL_GUARDED_BY(lock_);
+
+  // Set upon destruction, tells idle workers to exit.
+  bool stopping_ ABSL_GUARDED_BY(lock_) = false;
+
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_UTIL_THREAD_POOL_H_
@@ -0,0 +1,78 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/thread_pool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace verible {
+namespace {
+
+TEST(ThreadPoolTest, NoThreadsRunsInline) {
+  ThreadPool pool(0);
+  EXPECT_EQ(pool.NumThreads(), 0);
+  const auto caller = std::this_thread::get_id();
+  std::thread::id runner;
+  pool.Schedule([&runner] { runner = std::this_thread::get_id(); });
+  // Already done, no need to wait.
+  EXPECT_EQ(runner, caller);
+}
+
+TEST(ThreadPoolTest, NoWork) {
+  ThreadPool pool(3);
+  EXPECT_EQ(pool.NumThreads(), 3);
+}
+
+TEST(ThreadPoolTest, AllWorkDoneUponDestruction) {
+  constexpr int kNumItems = 1000;
+  std::atomic<int> count(0);
+  std::vector<int> results(kNumItems, 0);
+  {
+    ThreadPool pool(4);
+    for (int i = 0; i < kNumItems; ++i) {
+      pool.Schedule([i, &count, &results] {
+        results[i] = i * 2;  // each item writes its own slot
+        ++count;
+      });
+    }
+  }
+  EXPECT_EQ(count, kNumItems);
+  for (int i = 0; i < kNumItems; ++i) {
+    EXPECT_EQ(results[i], i * 2);
+  }
+}
+
+TEST(ThreadPoolTest, ScheduleFromWorker) {
+  std::atomic<int> count(0);
+  {
+    ThreadPool pool(2);
+    pool.Schedule([&pool, &count] {
+      ++count;
+      pool.Schedule([&count] { ++count; });
+    });
+  }
+  EXPECT_EQ(count, 2);
+}
+
+TEST(ThreadPoolTest, DefaultNumThreads) {
+  EXPECT_GE(ThreadPool::DefaultNumThreads(), 1);
+}
+
+}  // namespace
+}  // namespace verible
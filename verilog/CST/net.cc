@@ -61,10 +61,7 @@ std::vector<const TokenInfo*> GetIdentifiersFromNetDeclaration(
   auto matcher = verible::matcher::Matcher(ExpectedTagPredicate,
                                            verible::matcher::InnerMatchAll);
 
-  std::vector<verible::TreeSearchMatch> identifier_nodes =
-      SearchSyntaxTree(symbol, matcher);
-
-  for (auto& id : identifier_nodes) {
+  for (const auto& id : SearchSyntaxTreeLazily(symbol, matcher)) {
     const auto* identifier = SymbolCastToNode(*id.match)[0].get();
 
     const auto* identifier_leaf =
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -26,6 +27,7 @@
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "verilog/CST/verilog_matchers.h"  // IWYU pragma: keep
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -64,6 +66,12 @@ static const Matcher& AlwaysStarMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag> AlwaysCombRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kAlwaysStatement)};
+}
+
+bool AlwaysCombRule::IsSubtreeLocal() const { return true; }
+
 void AlwaysCombRule::HandleSymbol(const verible::Symbol& symbol,
                                   const SyntaxTreeContext& context) {
   // Check for offending use of always @*
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -27,6 +28,7 @@
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "verilog/CST/verilog_matchers.h"  // IWYU pragma: keep
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -36,7 +38,7 @@ namespace analysis {
 using verible::GetStyleGuideCitation;
 using verible::LintRuleStatus;
 using verible::LintViolation;
-using verible::SearchSyntaxTree;
+using verible::SearchSyntaxTreeLazily;
 using verible::SyntaxTreeContext;
 using verible::matcher::Matcher;
 
@@ -62,13 +64,20 @@ static const Matcher& AlwaysFFMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+AlwaysFFNonBlockingRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kAlwaysStatement)};
+}
+
+bool AlwaysFFNonBlockingRule::IsSubtreeLocal() const { return true; }
+
 void AlwaysFFNonBlockingRule::HandleSymbol(const verible::Symbol& symbol,
                                            const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
 
   if (AlwaysFFMatcher().Matches(symbol, &manager)) {
     for (const auto& match :
-         SearchSyntaxTree(symbol, NodekNetVariableAssignment())) {
+         SearchSyntaxTreeLazily(symbol, NodekNetVariableAssignment())) {
       // this is intended to ignore assignments in for loop step statements like
       // i=i+1
       if (match.context.IsInside(NodeEnum::kLoopHeader)) continue;
@@ -17,6 +17,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -39,6 +40,10 @@ class AlwaysFFNonBlockingRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  std::vector<verible::SymbolTag> InterestingTags() const override;
+
+  bool IsSubtreeLocal() const override;
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -28,6 +29,7 @@
 #include "verilog/CST/functions.h"
 #include "verilog/CST/module.h"
 #include "verilog/CST/package.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
 namespace verilog {
@@ -55,6 +57,14 @@ std::string BannedDeclaredNamePatternsRule::GetDescription(
       " See your project's style guidance regarding naming.");
 }
 
+std::vector<verible::SymbolTag>
+BannedDeclaredNamePatternsRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kModuleDeclaration),
+          verible::NodeTag(NodeEnum::kPackageDeclaration)};
+}
+
+bool BannedDeclaredNamePatternsRule::IsSubtreeLocal() const { return true; }
+
 void BannedDeclaredNamePatternsRule::HandleNode(
     const verible::SyntaxTreeNode& node,
     const verible::SyntaxTreeContext& context) {
@@ -17,6 +17,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/matcher/matcher.h"
@@ -43,6 +44,10 @@ class BannedDeclaredNamePatternsRule : public verible::SyntaxTreeLintRule {
   void HandleNode(const verible::SyntaxTreeNode& node,
                   const verible::SyntaxTreeContext& context) override;
 
+  std::vector<verible::SymbolTag> InterestingTags() const override;
+
+  bool IsSubtreeLocal() const override;
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -27,6 +28,7 @@
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -61,6 +63,13 @@ static const Matcher& CaseMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+CaseMissingDefaultRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kCaseItemList)};
+}
+
+bool CaseMissingDefaultRule::IsSubtreeLocal() const { return true; }
+
 void CaseMissingDefaultRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
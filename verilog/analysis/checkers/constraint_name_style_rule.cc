@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -30,6 +31,7 @@
 #include "common/text/token_info.h"
 #include "verilog/CST/constraints.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 #include "verilog/parser/verilog_token_enum.h"
@@ -66,6 +68,13 @@ static const Matcher& ConstraintMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+ConstraintNameStyleRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kConstraintDeclaration)};
+}
+
+bool ConstraintNameStyleRule::IsSubtreeLocal() const { return true; }
+
 void ConstraintNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
                                            const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
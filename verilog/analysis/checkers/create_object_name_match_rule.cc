@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -183,6 +184,13 @@ static std::string FormatReason(absl::string_view decl_name,
       decl_name, ", got: ", name_text, ". ");
 }
 
+std::vector<verible::SymbolTag>
+CreateObjectNameMatchRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kNetVariableAssignment)};
+}
+
+bool CreateObjectNameMatchRule::IsSubtreeLocal() const { return true; }
+
 void CreateObjectNameMatchRule::HandleSymbol(const verible::Symbol& symbol,
                                              const SyntaxTreeContext& context) {
   // Check for assignments that match the pattern.
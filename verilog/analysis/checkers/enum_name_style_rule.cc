@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -23,11 +24,13 @@
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/matcher/bound_symbol_manager.h"
 #include "common/analysis/matcher/matcher.h"
+#include "common/analysis/syntax_tree_search.h"
 #include "common/strings/naming_utils.h"
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "verilog/CST/type.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
 namespace verilog {
@@ -60,13 +63,19 @@ static const Matcher& TypedefMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag> EnumNameStyleRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kTypeDeclaration)};
+}
+
+bool EnumNameStyleRule::IsSubtreeLocal() const { return true; }
+
 void EnumNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
                                      const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
   if (TypedefMatcher().Matches(symbol, &manager)) {
     // TODO: This can be changed to checking type of child (by index) when we
     // have consistent shape for all kTypeDeclaration nodes.
-    if (!FindAllEnumTypes(symbol).empty()) {
+    if (verible::FindFirstMatch(symbol, NodekEnumType()) != nullptr) {
       const auto* identifier_leaf = GetIdentifierFromTypeDeclaration(symbol);
       const auto name = ABSL_DIE_IF_NULL(identifier_leaf)->get().text();
       if (!verible::IsLowerSnakeCaseWithDigits(name) ||
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -29,6 +30,7 @@
 #include "verilog/CST/functions.h"
 #include "verilog/CST/identifier.h"
 #include "verilog/CST/verilog_matchers.h"  // IWYU pragma: keep
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -65,6 +67,13 @@ static const Matcher& FunctionMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+ExplicitFunctionLifetimeRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kFunctionDeclaration)};
+}
+
+bool ExplicitFunctionLifetimeRule::IsSubtreeLocal() const { return true; }
+
 void ExplicitFunctionLifetimeRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   // Don't need to check for lifetime declaration if context is inside a class
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -29,6 +30,7 @@
 #include "verilog/CST/port.h"
 #include "verilog/CST/type.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -65,6 +67,15 @@ static const Matcher& PortMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+ExplicitFunctionTaskParameterTypeRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kPortItem)};
+}
+
+bool ExplicitFunctionTaskParameterTypeRule::IsSubtreeLocal() const {
+  return true;
+}
+
 void ExplicitFunctionTaskParameterTypeRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
@@ -29,6 +30,7 @@
 #include "common/util/logging.h"
 #include "verilog/CST/parameters.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -83,6 +85,13 @@ static bool HasStringAssignment(const verible::Symbol& param_decl) {
          verilog_tokentype::TK_StringLiteral;
 }
 
+std::vector<verible::SymbolTag>
+ExplicitParameterStorageTypeRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kParamDeclaration)};
+}
+
+bool ExplicitParameterStorageTypeRule::IsSubtreeLocal() const { return true; }
+
 void ExplicitParameterStorageTypeRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
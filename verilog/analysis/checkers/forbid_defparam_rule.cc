@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -25,6 +26,7 @@
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -53,6 +55,12 @@ static const Matcher& OverrideMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag> ForbidDefparamRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kParameterOverride)};
+}
+
+bool ForbidDefparamRule::IsSubtreeLocal() const { return true; }
+
 void ForbidDefparamRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
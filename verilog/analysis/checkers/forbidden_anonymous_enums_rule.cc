@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -25,6 +26,7 @@
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -59,6 +61,13 @@ static const Matcher& EnumMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+ForbiddenAnonymousEnumsRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kEnumType)};
+}
+
+bool ForbiddenAnonymousEnumsRule::IsSubtreeLocal() const { return true; }
+
 void ForbiddenAnonymousEnumsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
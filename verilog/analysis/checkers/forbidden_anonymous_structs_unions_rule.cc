@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -27,6 +28,7 @@
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -100,6 +102,16 @@ bool ForbiddenAnonymousStructsUnionsRule::IsRuleMet(
          (allow_anonymous_nested_type_ && NestedInStructOrUnion(context));
 }
 
+std::vector<verible::SymbolTag>
+ForbiddenAnonymousStructsUnionsRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kStructType),
+          verible::NodeTag(NodeEnum::kUnionType)};
+}
+
+bool ForbiddenAnonymousStructsUnionsRule::IsSubtreeLocal() const {
+  return true;
+}
+
 void ForbiddenAnonymousStructsUnionsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
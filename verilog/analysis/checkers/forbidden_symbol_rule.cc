@@ -17,6 +17,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -32,6 +33,7 @@
 #include "verilog/CST/verilog_matchers.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/parser/verilog_token_enum.h"
 
 namespace verilog {
 namespace analysis {
@@ -85,6 +87,13 @@ ForbiddenSystemTaskFunctionRule::InvalidSymbolsMap() {
   return *invalid_symbols;
 }
 
+std::vector<verible::SymbolTag>
+ForbiddenSystemTaskFunctionRule::InterestingTags() const {
+  return {verible::LeafTag(verilog_tokentype::SystemTFIdentifier)};
+}
+
+bool ForbiddenSystemTaskFunctionRule::IsSubtreeLocal() const { return true; }
+
 void ForbiddenSystemTaskFunctionRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -28,6 +28,7 @@
 #include "verilog/CST/identifier.h"
 #include "verilog/CST/seq_block.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -63,6 +64,13 @@ static const Matcher& BlockMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+GenerateLabelPrefixRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kGenerateBlock)};
+}
+
+bool GenerateLabelPrefixRule::IsSubtreeLocal() const { return true; }
+
 void GenerateLabelPrefixRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
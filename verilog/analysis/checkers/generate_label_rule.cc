@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -26,6 +27,7 @@
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -63,6 +65,12 @@ static const Matcher& BlockMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag> GenerateLabelRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kGenerateBlock)};
+}
+
+bool GenerateLabelRule::IsSubtreeLocal() const { return true; }
+
 void GenerateLabelRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -29,6 +30,7 @@
 #include "verilog/CST/module.h"
 #include "verilog/CST/type.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
 namespace verilog {
@@ -63,6 +65,13 @@ static const Matcher& InterfaceMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+InterfaceNameStyleRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kInterfaceDeclaration)};
+}
+
+bool InterfaceNameStyleRule::IsSubtreeLocal() const { return true; }
+
 void InterfaceNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
                                           const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
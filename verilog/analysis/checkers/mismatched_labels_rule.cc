@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -30,6 +31,7 @@
 #include "verilog/CST/identifier.h"
 #include "verilog/CST/seq_block.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -61,6 +63,12 @@ static const Matcher& BeginMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag> MismatchedLabelsRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kBegin)};
+}
+
+bool MismatchedLabelsRule::IsSubtreeLocal() const { return true; }
+
 void MismatchedLabelsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
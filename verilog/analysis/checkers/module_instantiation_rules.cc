@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -115,6 +116,12 @@ const char ModuleParameterRule::kMessage[] =
     "Pass named parameters for parameterized module instantiations with "
     "more than one parameter";
 
+std::vector<verible::SymbolTag> ModuleParameterRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kActualParameterList)};
+}
+
+bool ModuleParameterRule::IsSubtreeLocal() const { return true; }
+
 void ModuleParameterRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   // Syntactically, class instances are indistinguishable from module instances
@@ -155,6 +162,12 @@ const char ModulePortRule::kMessage[] =
     "Use named ports for module instantiation with "
     "more than one port";
 
+std::vector<verible::SymbolTag> ModulePortRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kGateInstance)};
+}
+
+bool ModulePortRule::IsSubtreeLocal() const { return true; }
+
 void ModulePortRule::HandleSymbol(const verible::Symbol& symbol,
                                   const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
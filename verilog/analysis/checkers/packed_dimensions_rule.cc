@@ -17,6 +17,7 @@
 #include <algorithm>  // for std::distance
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -32,6 +33,7 @@
 #include "verilog/CST/dimensions.h"
 #include "verilog/CST/expression.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -68,6 +70,12 @@ static const Matcher& DimensionRangeMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag> PackedDimensionsRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kDimensionRange)};
+}
+
+bool PackedDimensionsRule::IsSubtreeLocal() const { return true; }
+
 void PackedDimensionsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   if (!ContextIsInsidePackedDimensions(context)) return;
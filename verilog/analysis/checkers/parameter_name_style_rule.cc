@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -30,6 +31,7 @@
 #include "common/text/token_info.h"
 #include "verilog/CST/parameters.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 #include "verilog/parser/verilog_token_enum.h"
@@ -93,6 +95,13 @@ std::string ParameterNameStyleRule::ViolationMsg(absl::string_view symbol_type,
                       bit_list);
 }
 
+std::vector<verible::SymbolTag>
+ParameterNameStyleRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kParamDeclaration)};
+}
+
+bool ParameterNameStyleRule::IsSubtreeLocal() const { return true; }
+
 void ParameterNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
                                           const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
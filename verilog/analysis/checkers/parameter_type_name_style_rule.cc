@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -30,6 +31,7 @@
 #include "common/text/token_info.h"
 #include "verilog/CST/parameters.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 #include "verilog/parser/verilog_token_enum.h"
@@ -68,6 +70,13 @@ static const Matcher& ParamDeclMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+ParameterTypeNameStyleRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kParamDeclaration)};
+}
+
+bool ParameterTypeNameStyleRule::IsSubtreeLocal() const { return true; }
+
 void ParameterTypeNameStyleRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -30,6 +31,7 @@
 #include "verilog/CST/verilog_matchers.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/parser/verilog_token_enum.h"
 
 namespace verilog {
 namespace analysis {
@@ -57,6 +59,12 @@ static const Matcher& IdMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag> PlusargAssignmentRule::InterestingTags() const {
+  return {verible::LeafTag(verilog_tokentype::SystemTFIdentifier)};
+}
+
+bool PlusargAssignmentRule::IsSubtreeLocal() const { return true; }
+
 void PlusargAssignmentRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
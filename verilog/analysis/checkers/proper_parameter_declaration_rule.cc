@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -27,6 +28,7 @@
 #include "verilog/CST/context_functions.h"
 #include "verilog/CST/parameters.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 #include "verilog/parser/verilog_token_enum.h"
@@ -71,6 +73,13 @@ static const Matcher& ParamDeclMatcher() {
 }
 
 // TODO(kathuriac): Also check the 'interface' and 'program' constructs.
+std::vector<verible::SymbolTag>
+ProperParameterDeclarationRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kParamDeclaration)};
+}
+
+bool ProperParameterDeclarationRule::IsSubtreeLocal() const { return true; }
+
 void ProperParameterDeclarationRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
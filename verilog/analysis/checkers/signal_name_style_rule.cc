@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -33,6 +34,7 @@
 #include "verilog/CST/net.h"
 #include "verilog/CST/port.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -76,6 +78,14 @@ static const Matcher& DataMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag> SignalNameStyleRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kPortDeclaration),
+          verible::NodeTag(NodeEnum::kNetDeclaration),
+          verible::NodeTag(NodeEnum::kDataDeclaration)};
+}
+
+bool SignalNameStyleRule::IsSubtreeLocal() const { return true; }
+
 void SignalNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
                                        const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
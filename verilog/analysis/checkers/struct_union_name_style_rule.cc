@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -23,11 +24,13 @@
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/matcher/bound_symbol_manager.h"
 #include "common/analysis/matcher/matcher.h"
+#include "common/analysis/syntax_tree_search.h"
 #include "common/strings/naming_utils.h"
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "verilog/CST/type.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
 namespace verilog {
@@ -64,6 +67,13 @@ static const Matcher& TypedefMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+StructUnionNameStyleRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kTypeDeclaration)};
+}
+
+bool StructUnionNameStyleRule::IsSubtreeLocal() const { return true; }
+
 void StructUnionNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
                                             const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -71,9 +81,9 @@ void StructUnionNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
     const char* msg;
     // TODO: This can be changed to checking type of child (by index) when we
     // have consistent shape for all kTypeDeclaration nodes.
-    if (!FindAllStructTypes(symbol).empty()) {
+    if (verible::FindFirstMatch(symbol, NodekStructType()) != nullptr) {
       msg = kMessageStruct;
-    } else if (!FindAllUnionTypes(symbol).empty()) {
+    } else if (verible::FindFirstMatch(symbol, NodekUnionType()) != nullptr) {
       msg = kMessageUnion;
     } else {
       // Neither a struct nor union definition
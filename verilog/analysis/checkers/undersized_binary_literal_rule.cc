@@ -17,6 +17,7 @@
 #include <cstddef>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
@@ -32,6 +33,7 @@
 #include "common/util/logging.h"
 #include "verilog/CST/numbers.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -74,6 +76,13 @@ static const Matcher& NumberMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+UndersizedBinaryLiteralRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kNumber)};
+}
+
+bool UndersizedBinaryLiteralRule::IsSubtreeLocal() const { return true; }
+
 void UndersizedBinaryLiteralRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
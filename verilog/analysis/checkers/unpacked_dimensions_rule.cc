@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -30,6 +31,7 @@
 #include "verilog/CST/dimensions.h"
 #include "verilog/CST/expression.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -76,6 +78,13 @@ static const Matcher& DimensionRangeMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag>
+UnpackedDimensionsRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kDimensionRange)};
+}
+
+bool UnpackedDimensionsRule::IsSubtreeLocal() const { return true; }
+
 void UnpackedDimensionsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   if (!ContextIsInsideUnpackedDimensions(context) ||
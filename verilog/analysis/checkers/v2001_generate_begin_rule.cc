@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -28,6 +29,7 @@
 #include "common/text/syntax_tree_context.h"
 #include "common/text/tree_utils.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -62,6 +64,13 @@ std::string V2001GenerateBeginRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag>
+V2001GenerateBeginRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kGenerateRegion)};
+}
+
+bool V2001GenerateBeginRule::IsSubtreeLocal() const { return true; }
+
 void V2001GenerateBeginRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
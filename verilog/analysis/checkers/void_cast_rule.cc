@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -31,6 +32,7 @@
 #include "common/text/token_info.h"
 #include "common/text/tree_utils.h"
 #include "verilog/CST/verilog_matchers.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
 
@@ -91,6 +93,12 @@ static const Matcher& RandomizeMatcher() {
   return matcher;
 }
 
+std::vector<verible::SymbolTag> VoidCastRule::InterestingTags() const {
+  return {verible::NodeTag(NodeEnum::kVoidcast)};
+}
+
+bool VoidCastRule::IsSubtreeLocal() const { return true; }
+
 void VoidCastRule::HandleSymbol(const verible::Symbol& symbol,
                                 const SyntaxTreeContext& context) {
   // Check for forbidden function names
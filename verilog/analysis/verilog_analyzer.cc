@@ -25,6 +25,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_split.h"
@@ -32,16 +33,19 @@
 #include "common/analysis/file_analyzer.h"
 #include "common/lexer/token_stream_adapter.h"
 #include "common/strings/comment_utils.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
 #include "common/text/token_stream_view.h"
+#include "common/text/tree_utils.h"
 #include "common/text/visitors.h"
-#include "common/util/container_util.h"
+#include "common/util/iterator_range.h"
 #include "common/util/logging.h"
 #include "common/util/status_macros.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/verilog_excerpt_parse.h"
 #include "verilog/parser/verilog_lexer.h"
 #include "verilog/parser/verilog_lexical_context.h"
@@ -55,7 +59,6 @@ namespace verilog {
 using verible::FileAnalyzer;
 using verible::TokenInfo;
 using verible::TokenSequence;
-using verible::container::InsertKeyOrDie;
 
 const char VerilogAnalyzer::kParseDirectiveName[] = "verilog_syntax:";
 
@@ -68,6 +71,53 @@ absl::Status VerilogAnalyzer::Tokenize() {
   return lex_status_;
 }
 
+absl::Status VerilogAnalyzer::TokenizeWithLexedSubstring(
+    size_t offset, const TokenSequence& substring_tokens) {
+  if (tokenized_) return lex_status_;
+  tokenized_ = true;
+  CHECK(!substring_tokens.empty() && substring_tokens.back().isEOF());
+  const absl::string_view substring(
+      substring_tokens.front().text().begin(),
+      std::distance(substring_tokens.front().text().begin(),
+                    substring_tokens.back().text().end()));
+  const absl::string_view text = Data().Contents();
+  CHECK_EQ(text.substr(offset, substring.length()), substring);
+
+  TokenSequence& tokens = MutableData().MutableTokenStream();
+  const auto lex = [&](absl::string_view fragment) {
+    VerilogLexer lexer(fragment);
+    return verible::MakeTokenSequence(
+        &lexer, fragment, &tokens, [&](const TokenInfo& error_token) {
+          VLOG(1) << "Lexical error with token: " << error_token;
+          rejected_tokens_.push_back(verible::RejectedToken{
+              error_token, verible::AnalysisPhase::kLexPhase,
+              "" /* no detailed explanation */});
+        });
+  };
+  // Lex the text before the substring, without its EOF.
+  lex_status_ = lex(text.substr(0, offset));
+  if (!lex_status_.ok()) return lex_status_;
+  tokens.pop_back();
+  // Copy the substring's tokens, without its EOF.
+  const char* const substring_base = text.begin() + offset;
+  for (auto iter = substring_tokens.begin();
+       iter + 1 != substring_tokens.end(); ++iter) {
+    tokens.push_back(*iter);
+    TokenInfo& token = tokens.back();
+    token.set_token_enum(LexicalContext::LexicalTokenEnum(token.token_enum()));
+    const size_t token_offset =
+        std::distance(substring.begin(), iter->text().begin());
+    token.RebaseStringView(substring_base + token_offset);
+  }
+  // Lex the rest, including EOF.
+  lex_status_ = lex(text.substr(offset + substring.length()));
+  if (!lex_status_.ok()) return lex_status_;
+
+  MutableData().CalculateFirstTokensPerLine();
+  verible::InitTokenStreamView(tokens, &MutableData().MutableTokenStreamView());
+  return lex_status_;
+}
+
 absl::string_view VerilogAnalyzer::ScanParsingModeDirective(
     const TokenSequence& raw_tokens) {
   for (const auto& token : raw_tokens) {
@@ -133,9 +183,18 @@ static const absl::string_view FailingTokenKeywordToParsingMode(
 
 std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
     absl::string_view text, absl::string_view name) {
+  return AnalyzeAutomaticMode(std::make_shared<verible::StringMemBlock>(text),
+                              name);
+}
+
+std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
+    std::shared_ptr<verible::MemBlock> content, absl::string_view name,
+    const VerilogPreprocessConfig& preprocess_config) {
   VLOG(2) << __FUNCTION__;
-  auto analyzer = absl::make_unique<VerilogAnalyzer>(text, name);
+  const absl::string_view text = content->AsStringView();
+  auto analyzer = absl::make_unique<VerilogAnalyzer>(std::move(content), name);
   if (analyzer == nullptr) return analyzer;
+  analyzer->SetPreprocessConfig(preprocess_config);
   const absl::string_view text_base = analyzer->Data().Contents();
   // If there is any lexical error, stop right away.
   const auto lex_status = analyzer->Tokenize();
@@ -144,10 +203,10 @@ std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
       ScanParsingModeDirective(analyzer->Data().TokenStream());
   if (!parse_mode.empty()) {
     // Invoke alternate parser, and use its results.
-    // Slightly inefficient to lex text all over again, but this is
-    // acceptable for an exceptional code path.
+    // The text's tokens are re-used instead of lexing it again.
     VLOG(1) << "Analyzing using parse mode directive: " << parse_mode;
-    auto mode_analyzer = AnalyzeVerilogWithMode(text, name, parse_mode);
+    auto mode_analyzer = AnalyzeVerilogWithMode(
+        text, analyzer->Data().TokenStream(), name, parse_mode);
     if (mode_analyzer != nullptr) return mode_analyzer;
     // Silently ignore any unknown parsing modes.
   }
@@ -168,8 +227,10 @@ std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
               verilog_tokentype(first_reject.token_info.token_enum()));
       VLOG(1) << "Retrying parsing in mode: \"" << retry_parse_mode << "\".";
       if (!retry_parse_mode.empty()) {
-        auto retry_analyzer =
-            AnalyzeVerilogWithMode(text, name, retry_parse_mode);
+        // The text's tokens are re-used, after undoing their disambiguation
+        // in the normal mode's context.
+        auto retry_analyzer = AnalyzeVerilogWithMode(
+            text, analyzer->Data().TokenStream(), name, retry_parse_mode);
         const absl::string_view retry_text_base =
             retry_analyzer->Data().Contents();
         VLOG(1) << "Retrying to parse:\n" << retry_text_base;
@@ -226,10 +287,9 @@ absl::Status VerilogAnalyzer::Analyze() {
   ContextualizeTokens();
 
   // pseudo-preprocess token stream.
-  // TODO(fangism): preprocessor_.Configure();
-  //   Not all analyses will want to preprocess.
+  // Inactive conditional branches are only dropped when configured to.
   {
-    VerilogPreprocess preprocessor;
+    VerilogPreprocess preprocessor(preprocess_config_);
     preprocessor_data_ = preprocessor.ScanStream(Data().GetTokenStreamView());
     if (!preprocessor_data_.errors.empty()) {
       for (const auto& error : preprocessor_data_.errors) {
@@ -267,92 +327,461 @@ using verible::SyntaxTreeNode;
 using verible::TextStructureView;
 using verible::TokenInfo;
 
+// Returns a copy of the tree 'symbol', with its tokens moved 'shift' bytes.
+SymbolPtr CopyShiftedTree(const verible::Symbol& symbol, std::ptrdiff_t shift) {
+  if (symbol.Kind() == verible::SymbolKind::kLeaf) {
+    TokenInfo token(verible::SymbolCastToLeaf(symbol).get());
+    token.RebaseStringView(token.text().begin() + shift);
+    return absl::make_unique<SyntaxTreeLeaf>(token);
+  }
+  const SyntaxTreeNode& node = verible::SymbolCastToNode(symbol);
+  auto copy = absl::make_unique<SyntaxTreeNode>(node.Tag().tag);
+  copy->mutable_children().reserve(node.children().size());
+  for (const auto& child : node.children()) {
+    copy->AppendChild(child == nullptr ? nullptr
+                                       : CopyShiftedTree(*child, shift));
+  }
+  return std::move(copy);
+}
+
 // Helper class to replace macro call argument nodes with expression trees.
+// Arguments are parsed by a single re-used expression parser, and each
+// distinct argument text is parsed only once: repeated arguments get a copy
+// of the first one's results.
 class MacroCallArgExpander : public MutableTreeVisitorRecursive {
  public:
-  explicit MacroCallArgExpander(absl::string_view text) : full_text_(text) {}
+  MacroCallArgExpander() = default;
 
   void Visit(const SyntaxTreeNode&, SymbolPtr*) override {}
 
   void Visit(const SyntaxTreeLeaf& leaf, SymbolPtr* leaf_owner) override {
     const TokenInfo& token(leaf.get());
-    if (token.token_enum() == MacroArg) {
-      VLOG(3) << "MacroCallArgExpander: examining token: " << token;
-      // Attempt to parse text as an expression.
-      std::unique_ptr<VerilogAnalyzer> expr_analyzer =
-          AnalyzeVerilogExpression(token.text(), "<macro-arg-expander>");
-      if (!expr_analyzer->ParseStatus().ok()) {
-        // If that failed, try to parse text as a property.
-        expr_analyzer =
-            AnalyzeVerilogPropertySpec(token.text(), "<macro-arg-expander>");
-        if (!expr_analyzer->ParseStatus().ok()) {
-          // If that failed: try to infer parsing mode from comments
-          expr_analyzer = VerilogAnalyzer::AnalyzeAutomaticMode(
-              token.text(), "<macro-arg-expander>");
-        }
-      }
-      if (ABSL_DIE_IF_NULL(expr_analyzer)->LexStatus().ok() &&
-          expr_analyzer->ParseStatus().ok()) {
-        VLOG(3) << "  ... content is parse-able, saving for expansion.";
-        const auto& token_sequence = expr_analyzer->Data().TokenStream();
-        const verible::TokenInfo::Context token_context{
-            expr_analyzer->Data().Contents(), [](std::ostream& stream, int e) {
-              stream << verilog_symbol_name(e);
-            }};
-        if (VLOG_IS_ON(4)) {
-          LOG(INFO) << "macro call-arg's lexed tokens: ";
-          for (const auto& t : token_sequence) {
-            LOG(INFO) << verible::TokenWithContext{t, token_context};
-          }
-        }
-        CHECK_EQ(token_sequence.back().right(expr_analyzer->Data().Contents()),
-                 token.text().length());
-        // Defer in-place expansion until all expansions have been collected
-        // (for efficiency, avoiding inserting into middle of a vector,
-        // and causing excessive reallocation).
-        TextStructureView::DeferredExpansion& analysis_slot =
-            InsertKeyOrDie(&subtrees_to_splice_, token.left(full_text_));
-        CHECK_EQ(analysis_slot.subanalysis.get(), nullptr)
-            << "Cannot expand the same location twice.  Token: " << token;
-        analysis_slot.expansion_point = leaf_owner;
-        analysis_slot.subanalysis = std::move(expr_analyzer);
-      } else {
-        // Ignore parse failures.
+    if (token.token_enum() != MacroArg) return;
+    VLOG(3) << "MacroCallArgExpander: examining token: " << token;
+    const absl::string_view text = token.text();
+    const auto found = parsed_args_.find(text);
+    if (found != parsed_args_.end()) {
+      if (found->second < 0) {
         VLOG(3) << "Ignoring parsing failure: " << token;
+      } else {
+        VLOG(3) << "  ... same as a previous argument, copying its expansion.";
+        CopySplice(found->second, text, leaf_owner);
       }
+      return;
     }
+
+    TextStructureView::SubtreeSplice splice;
+    splice.expansion_point = leaf_owner;
+    // Attempt to parse text as an expression.
+    splice.subtree = expression_parser_.Parse(text, &splice.tokens,
+                                              &splice.token_view_indices);
+    if (splice.subtree == nullptr) {
+      // If that failed, try to parse text as a property.
+      std::unique_ptr<VerilogAnalyzer> analyzer =
+          AnalyzeVerilogPropertySpec(text, "<macro-arg-expander>");
+      if (!analyzer->ParseStatus().ok()) {
+        // If that failed: try to infer parsing mode from comments
+        analyzer = VerilogAnalyzer::AnalyzeAutomaticMode(
+            text, "<macro-arg-expander>");
+      }
+      if (ABSL_DIE_IF_NULL(analyzer)->LexStatus().ok() &&
+          analyzer->ParseStatus().ok()) {
+        TakeAnalysis(analyzer.get(), text, &splice);
+      }
+    }
+    if (splice.subtree == nullptr) {
+      // Ignore parse failures.
+      VLOG(3) << "Ignoring parsing failure: " << token;
+      parsed_args_.emplace(text, -1);
+      return;
+    }
+    VLOG(3) << "  ... content is parse-able, saving for expansion.";
+    if (VLOG_IS_ON(4)) {
+      const verible::TokenInfo::Context token_context{
+          text, [](std::ostream& stream, int e) {
+            stream << verilog_symbol_name(e);
+          }};
+      LOG(INFO) << "macro call-arg's lexed tokens: ";
+      for (const auto& t : splice.tokens) {
+        LOG(INFO) << verible::TokenWithContext{t, token_context};
+      }
+    }
+    CHECK(!splice.tokens.empty());
+    CHECK_EQ(splice.tokens.back().text().end(), text.end());
+    parsed_args_.emplace(text, splices_.size());
+    splices_.push_back(std::move(splice));
   }
 
   MacroCallArgExpander(const MacroCallArgExpander&) = delete;
   MacroCallArgExpander(MacroCallArgExpander&&) = delete;
   MacroCallArgExpander& operator=(const MacroCallArgExpander&) = delete;
 
-  // Process accumulated DeferredExpansions.
+  // Replaces the visited arguments with their parsed subtrees.
   void ExpandSubtrees(VerilogAnalyzer* analyzer) {
-    if (!subtrees_to_splice_.empty()) {
-      analyzer->MutableData().ExpandSubtrees(&subtrees_to_splice_);
-    }
+    // Splicing is done after all expansions have been collected
+    // (for efficiency, avoiding inserting into middle of a vector,
+    // and causing excessive reallocation).
+    analyzer->MutableData().SpliceSubtrees(&splices_);
+    parsed_args_.clear();
   }
 
  private:
-  // Deferred set of syntax tree nodes to expand.
-  // Key: location.
-  // Value: substring analysis results.
-  TextStructureView::NodeExpansionMap subtrees_to_splice_;
+  // Moves the results of 'analyzer', the analysis of a copy of 'text', into
+  // 'splice', pointing them into 'text'.
+  static void TakeAnalysis(VerilogAnalyzer* analyzer, absl::string_view text,
+                           TextStructureView::SubtreeSplice* splice) {
+    TextStructureView& data = analyzer->MutableData();
+    const absl::string_view sub_text = data.Contents();
+    CHECK_EQ(sub_text, text);
+    data.MutateTokens([=](TokenInfo* t) {
+      t->RebaseStringView(text.begin() + t->left(sub_text));
+    });
+    TokenSequence& tokens = data.MutableTokenStream();
+    for (const auto& iter : data.GetTokenStreamView()) {
+      if (iter->isEOF()) break;
+      splice->token_view_indices.push_back(
+          std::distance(tokens.cbegin(), iter));
+    }
+    if (!tokens.empty() && tokens.back().isEOF()) tokens.pop_back();
+    splice->tokens = std::move(tokens);
+    splice->subtree = std::move(data.MutableSyntaxTree());
+    data.Clear();
+  }
+
+  // Schedules the expansion of the argument 'text' at 'leaf_owner' with a
+  // copy of splices_[index], whose argument has the same text.
+  void CopySplice(int index, absl::string_view text, SymbolPtr* leaf_owner) {
+    TextStructureView::SubtreeSplice splice;
+    {
+      const TextStructureView::SubtreeSplice& original = splices_[index];
+      const std::ptrdiff_t shift = std::distance(
+          original.tokens.back().text().end(), text.end());
+      splice.expansion_point = leaf_owner;
+      splice.subtree = CopyShiftedTree(*original.subtree, shift);
+      splice.tokens = original.tokens;
+      for (auto& t : splice.tokens) {
+        t.RebaseStringView(t.text().begin() + shift);
+      }
+      splice.token_view_indices = original.token_view_indices;
+    }
+    splices_.push_back(std::move(splice));
+  }
+
+  // Re-used for every argument.
+  VerilogExpressionParser expression_parser_;
 
-  // Full text from which tokens were lexed, for calculating byte offsets.
-  absl::string_view full_text_;
+  // Syntax tree leaves to expand, in the order they were visited.
+  std::vector<TextStructureView::SubtreeSplice> splices_;
+
+  // Key: text of a visited argument.
+  // Value: index of its expansion in splices_, or -1 if it did not parse.
+  absl::flat_hash_map<absl::string_view, int> parsed_args_;
 };
 
 }  // namespace
 
 void VerilogAnalyzer::ExpandMacroCallArgExpressions() {
   VLOG(2) << __FUNCTION__;
-  MacroCallArgExpander expander(Data().Contents());
+  MacroCallArgExpander expander;
   ABSL_DIE_IF_NULL(SyntaxTree())
       ->Accept(&expander, &MutableData().MutableSyntaxTree());
   expander.ExpandSubtrees(this);
   VLOG(2) << "end of " << __FUNCTION__;
 }
 
+// Returns true if 'token' separates the tokens around it, so that lexing
+// either side on its own yields the same tokens as lexing them together.
+static bool IsLexicalSeparator(const TokenInfo& token) {
+  switch (token.token_enum()) {
+    case TK_SPACE:
+    case TK_NEWLINE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns true if 'token' could extend a preceding top-level item, such as an
+// end-label (':') or a semicolon after a macro call (';').  Items that start
+// with such a token may not be parsed separately.
+static bool MayContinueItem(const TokenInfo& token) {
+  return token.token_enum() == ':' || token.token_enum() == ';';
+}
+
+static bool ContainsPreprocessorControl(verible::TokenRange tokens) {
+  return std::any_of(tokens.begin(), tokens.end(), [](const TokenInfo& t) {
+    return IsPreprocessorControlToken(verilog_tokentype(t.token_enum()));
+  });
+}
+
+std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeEdit(
+    std::unique_ptr<VerilogAnalyzer> previous, size_t offset, size_t length,
+    absl::string_view replacement) {
+  const absl::string_view old_text = previous->Data().Contents();
+  CHECK_LE(offset + length, old_text.length());
+  auto text = std::make_shared<verible::StringMemBlock>();
+  std::string* new_text = text->mutable_content();
+  new_text->reserve(old_text.length() - length + replacement.length());
+  new_text->append(old_text.begin(), old_text.begin() + offset);
+  new_text->append(replacement.begin(), replacement.end());
+  new_text->append(old_text.begin() + offset + length, old_text.end());
+
+  const std::string name(previous->filename_);
+  auto analyzer = absl::make_unique<VerilogAnalyzer>(text, name);
+  analyzer->SetPreprocessConfig(previous->preprocess_config_);
+  if (analyzer->SpliceEdit(previous.get(), offset, length,
+                           replacement.length())) {
+    return analyzer;
+  }
+  VLOG(1) << "Edit at " << offset << " requires a full analysis.";
+  return AnalyzeAutomaticMode(std::move(text), name,
+                              previous->preprocess_config_);
+}
+
+bool VerilogAnalyzer::SpliceEdit(VerilogAnalyzer* previous, size_t offset,
+                                 size_t old_length, size_t new_length) {
+  VLOG(2) << __FUNCTION__;
+  // Only error-free analyses in the normal parsing mode can be reused.
+  if (!previous->lex_status_.ok() || !previous->parse_status_.ok() ||
+      !previous->rejected_tokens_.empty()) {
+    return false;
+  }
+  // Files with a parsing mode directive are not parsed as a list of items.
+  if (!ScanParsingModeDirective(previous->Data().TokenStream()).empty()) {
+    return false;
+  }
+  // Items are not separable from the conditional directives around them.
+  if (previous->preprocess_config_.filter_branches) return false;
+  const verible::ConcreteSyntaxTree& old_root = previous->SyntaxTree();
+  if (old_root == nullptr || old_root->Kind() != verible::SymbolKind::kNode ||
+      !verible::SymbolCastToNode(*old_root)
+           .MatchesTag(NodeEnum::kDescriptionList)) {
+    return false;
+  }
+  const auto& old_items = verible::SymbolCastToNode(*old_root).children();
+
+  // Find the run of items [first_item, end_item) affected by the edit.  The
+  // edit may extend into the space around them: [left, right) in the old
+  // text, which ends before the first unaffected item.
+  const absl::string_view old_text = previous->Data().Contents();
+  std::vector<std::pair<size_t, size_t>> item_spans;
+  item_spans.reserve(old_items.size());
+  for (const auto& item : old_items) {
+    if (item == nullptr) return false;
+    const absl::string_view span = verible::StringSpanOfSymbol(*item);
+    if (span.data() == nullptr) return false;
+    const size_t left = std::distance(old_text.begin(), span.begin());
+    item_spans.emplace_back(left, left + span.length());
+  }
+  const size_t edit_end = offset + old_length;
+  const size_t first_item =
+      std::partition_point(item_spans.begin(), item_spans.end(),
+                           [=](const std::pair<size_t, size_t>& span) {
+                             return span.second <= offset;
+                           }) -
+      item_spans.begin();
+  const size_t end_item =
+      std::partition_point(item_spans.begin() + first_item, item_spans.end(),
+                           [=](const std::pair<size_t, size_t>& span) {
+                             return span.first < edit_end;
+                           }) -
+      item_spans.begin();
+  const size_t left = first_item == 0 ? 0 : item_spans[first_item - 1].second;
+  const size_t right = end_item == old_items.size()
+                           ? old_text.length()
+                           : item_spans[end_item].first;
+  if (end_item < old_items.size() &&
+      MayContinueItem(verible::GetLeftmostLeaf(*old_items[end_item])->get())) {
+    return false;
+  }
+
+  // Tokens [old_begin, old_end) of the old text are replaced.
+  const TokenSequence& old_tokens = previous->Data().TokenStream();
+  const verible::TokenRange old_range =
+      previous->Data().TokenRangeSpanningOffsets(left, right);
+  if (old_range.begin() != old_tokens.begin() &&
+      std::prev(old_range.begin())->text().end() > old_text.begin() + left) {
+    return false;
+  }
+  if (ContainsPreprocessorControl(old_range)) return false;
+
+  // Lex the edited region on its own.  Its tokens are views into this
+  // analyzer's text.
+  const absl::string_view text = Data().Contents();
+  const size_t new_right = right - old_length + new_length;
+  const absl::string_view region = text.substr(left, new_right - left);
+  TokenSequence region_tokens;
+  {
+    VerilogLexer lexer(region);
+    if (!verible::MakeTokenSequence(&lexer, region, &region_tokens,
+                                    [](const TokenInfo&) {})
+             .ok()) {
+      return false;
+    }
+  }
+  // region_tokens ends with EOF.
+  if (left > 0 && !IsLexicalSeparator(region_tokens.front())) return false;
+  if (new_right < text.length() &&
+      (region_tokens.size() < 2 ||
+       !IsLexicalSeparator(region_tokens[region_tokens.size() - 2]))) {
+    return false;
+  }
+  if (ContainsPreprocessorControl(
+          verible::make_range(region_tokens.cbegin(), region_tokens.cend()))) {
+    return false;
+  }
+
+  if (first_item == 0 && !ScanParsingModeDirective(region_tokens).empty()) {
+    return false;
+  }
+
+  // Filter and contextualize the region's tokens as Analyze() does.
+  verible::TokenStreamView region_view;
+  verible::InitTokenStreamView(region_tokens, &region_view);
+  verible::FilterTokenStreamViewInPlace(&VerilogLexer::KeepSyntaxTreeTokens,
+                                        &region_view);
+  {
+    verible::TokenStreamReferenceView writable_view;
+    writable_view.reserve(region_view.size());
+    for (const auto iter : region_view) {
+      writable_view.push_back(region_tokens.begin() +
+                              std::distance(region_tokens.cbegin(), iter));
+    }
+    LexicalContext context;
+    context.TransformVerilogSymbols(writable_view);
+  }
+  if (left > 0 && MayContinueItem(*region_view.front())) return false;
+
+  // Parse the region as a sequence of top-level items.
+  auto generator = MakeTokenViewer(region_view);
+  VerilogParser parser(&generator);
+  if (!parser.Parse().ok()) return false;
+  verible::ConcreteSyntaxTree region_root = parser.TakeRoot();
+  if (region_root == nullptr ||
+      region_root->Kind() != verible::SymbolKind::kNode) {
+    return false;
+  }
+  auto& region_root_node = verible::SymbolCastToNode(*region_root);
+  if (!region_root_node.MatchesTag(NodeEnum::kDescriptionList) &&
+      !region_root_node.children().empty()) {
+    return false;
+  }
+  auto& new_items = region_root_node.mutable_children();
+  // A text without items is not parsed as a list of items.
+  if (new_items.empty() && end_item - first_item == old_items.size()) {
+    return false;
+  }
+
+  // Splice the token sequence, reusing the tokens outside of the region.
+  // The region's EOF token is dropped.
+  const size_t old_begin = std::distance(old_tokens.begin(), old_range.begin());
+  const size_t old_end = std::distance(old_tokens.begin(), old_range.end());
+  const size_t region_size = region_tokens.size() - 1;
+  const auto rebase = [=](TokenInfo* token) {
+    size_t token_offset =
+        std::distance(old_text.begin(), token->text().begin());
+    if (token_offset >= right) token_offset += new_length - old_length;
+    token->RebaseStringView(text.begin() + token_offset);
+  };
+  TokenSequence& tokens = MutableData().MutableTokenStream();
+  tokens.clear();
+  tokens.reserve(old_tokens.size() - (old_end - old_begin) + region_size);
+  for (size_t i = 0; i < old_begin; ++i) {
+    tokens.push_back(old_tokens[i]);
+    rebase(&tokens.back());
+  }
+  tokens.insert(tokens.end(), region_tokens.begin(),
+                region_tokens.begin() + region_size);
+  for (size_t i = old_end; i < old_tokens.size(); ++i) {
+    tokens.push_back(old_tokens[i]);
+    rebase(&tokens.back());
+  }
+
+  // Splice the filtered view of tokens in the same way.
+  verible::TokenStreamView& view = MutableData().MutableTokenStreamView();
+  view.clear();
+  view.reserve(previous->Data().GetTokenStreamView().size() +
+               region_view.size());
+  bool region_viewed = false;
+  const auto view_region = [&]() {
+    for (const auto iter : region_view) {
+      const size_t index = std::distance(region_tokens.cbegin(), iter);
+      if (index < region_size) {
+        view.push_back(tokens.cbegin() + old_begin + index);
+      }
+    }
+    region_viewed = true;
+  };
+  for (const auto iter : previous->Data().GetTokenStreamView()) {
+    const size_t index = std::distance(old_tokens.begin(), iter);
+    if (index < old_begin) {
+      view.push_back(tokens.cbegin() + index);
+      continue;
+    }
+    if (!region_viewed) view_region();
+    if (index >= old_end) {
+      view.push_back(tokens.cbegin() +
+                     (index - old_end + old_begin + region_size));
+    }
+  }
+  if (!region_viewed) view_region();
+
+  // Splice the syntax tree, reusing the items outside of the region.
+  verible::ConcreteSyntaxTree root =
+      std::move(previous->MutableData().MutableSyntaxTree());
+  auto& items = verible::SymbolCastToNode(*root).mutable_children();
+  std::vector<verible::SymbolPtr> spliced_items;
+  spliced_items.reserve(items.size() - (end_item - first_item) +
+                        new_items.size());
+  for (size_t i = 0; i < first_item; ++i) {
+    verible::MutateLeaves(&items[i], rebase);
+    spliced_items.push_back(std::move(items[i]));
+  }
+  for (auto& item : new_items) spliced_items.push_back(std::move(item));
+  for (size_t i = end_item; i < items.size(); ++i) {
+    verible::MutateLeaves(&items[i], rebase);
+    spliced_items.push_back(std::move(items[i]));
+  }
+  const size_t new_items_end = first_item + new_items.size();
+  items = std::move(spliced_items);
+  MutableData().MutableSyntaxTree() = std::move(root);
+  max_used_stack_size_ =
+      std::max(previous->max_used_stack_size_, parser.MaxUsedStackSize());
+  // Nothing of 'previous' refers to its text anymore.
+  previous->MutableData().Clear();
+
+  // The preprocessor directives are unchanged, but its results refer to the
+  // new text.
+  {
+    VerilogPreprocess preprocessor(preprocess_config_);
+    preprocessor_data_ = preprocessor.ScanStream(Data().GetTokenStreamView());
+    if (!preprocessor_data_.errors.empty()) {
+      MutableData().Clear();
+      return false;
+    }
+    MutableData().MutableTokenStreamView() =
+        preprocessor_data_.preprocessed_token_stream;  // copy
+  }
+  MutableData().CalculateFirstTokensPerLine();
+
+  // Expand macro arguments of the new items only.
+  {
+    MacroCallArgExpander expander;
+    auto& root_items =
+        verible::SymbolCastToNode(*MutableData().MutableSyntaxTree())
+            .mutable_children();
+    for (size_t i = first_item; i < new_items_end; ++i) {
+      root_items[i]->Accept(&expander, &root_items[i]);
+    }
+    expander.ExpandSubtrees(this);
+  }
+
+  tokenized_ = true;
+  lex_status_ = absl::OkStatus();
+  parse_status_ = absl::OkStatus();
+  VLOG(2) << "end of " << __FUNCTION__ << ", re-parsed items [" << first_item
+          << ", " << new_items_end << ")";
+  return true;
+}
+
 }  // namespace verilog
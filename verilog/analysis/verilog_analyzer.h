@@ -19,10 +19,12 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "common/analysis/file_analyzer.h"
+#include "common/strings/mem_block.h"
 #include "common/text/token_stream_view.h"
 #include "verilog/preprocessor/verilog_preprocess.h"
 
@@ -37,9 +39,27 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
         max_used_stack_size_(0),
         use_parser_directive_comments_(use_parser_directive_comments) {}
 
+  // Shares ownership of 'text' without copying, e.g. a memory-mapped file.
+  VerilogAnalyzer(std::shared_ptr<verible::MemBlock> text,
+                  absl::string_view name,
+                  bool use_parser_directive_comments = true)
+      : verible::FileAnalyzer(std::move(text), name),
+        max_used_stack_size_(0),
+        use_parser_directive_comments_(use_parser_directive_comments) {}
+
   // Lex-es the input text into tokens.
   absl::Status Tokenize() override;
 
+  // Like Tokenize(), but copies the tokens of the substring at 'offset' from
+  // 'substring_tokens' instead of lexing it again.  'substring_tokens' are
+  // the (EOF-terminated) tokens of an equal string, e.g. from the analysis
+  // of a text that is being re-analyzed as part of this one, and may have
+  // been disambiguated by context (see LexicalContext).  The substring must
+  // be lexically independent of the text around it, e.g. surrounded by
+  // whitespace.
+  absl::Status TokenizeWithLexedSubstring(
+      size_t offset, const verible::TokenSequence& substring_tokens);
+
   // Create token stream view without comments and whitespace.
   // The retained tokens will become leaves of a concrete syntax tree.
   void FilterTokensForSyntaxTree();
@@ -55,11 +75,37 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
 
   size_t MaxUsedStackSize() const { return max_used_stack_size_; }
 
+  // Configures the preprocessing done by Analyze(), which by default keeps
+  // all conditional branches.
+  void SetPreprocessConfig(const VerilogPreprocessConfig& config) {
+    preprocess_config_ = config;
+  }
+
   // Automatically analyze with the correct parsing mode, as detected
   // by parser directive comments.
   static std::unique_ptr<VerilogAnalyzer> AnalyzeAutomaticMode(
       absl::string_view text, absl::string_view name);
 
+  // Same as above, but shares ownership of 'text' without copying it.
+  // 'preprocess_config' applies to the normal parsing mode, not to texts
+  // analyzed in another mode.
+  static std::unique_ptr<VerilogAnalyzer> AnalyzeAutomaticMode(
+      std::shared_ptr<verible::MemBlock> text, absl::string_view name,
+      const VerilogPreprocessConfig& preprocess_config =
+          VerilogPreprocessConfig());
+
+  // Returns the analysis of the text of 'previous' after replacing 'length'
+  // bytes at 'offset' with 'replacement', as AnalyzeAutomaticMode() would
+  // produce it for the edited text.  'previous' is consumed.
+  // When 'previous' is free of errors, and the edit lies within a run of
+  // top-level description items (and the space around them), only that run
+  // is re-lexed and re-parsed, and spliced into the tokens and syntax tree
+  // that are reused from 'previous'.  Otherwise, the edited text is analyzed
+  // from scratch.
+  static std::unique_ptr<VerilogAnalyzer> AnalyzeEdit(
+      std::unique_ptr<VerilogAnalyzer> previous, size_t offset, size_t length,
+      absl::string_view replacement);
+
   const VerilogPreprocessData& PreprocessorData() const {
     return preprocessor_data_;
   }
@@ -88,6 +134,14 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
   // syntax tree.  If parsing fails, leave the MacroArg token unexpanded.
   void ExpandMacroCallArgExpressions();
 
+  // Fills this analyzer, whose text is that of 'previous' with 'old_length'
+  // bytes at 'offset' replaced by 'new_length' bytes, by re-analyzing only
+  // the top-level items affected by the edit, see AnalyzeEdit().
+  // Returns false if the edit cannot be analyzed incrementally, in which case
+  // neither analyzer may be used other than for destruction.
+  bool SpliceEdit(VerilogAnalyzer* previous, size_t offset, size_t old_length,
+                  size_t new_length);
+
   // Information about parser internals.
 
   // True if input text has already been lexed.
@@ -96,6 +150,9 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
   // Maximum symbol stack depth.
   size_t max_used_stack_size_;
 
+  // Preprocessor configuration.
+  VerilogPreprocessConfig preprocess_config_;
+
   // Preprocessor.
   VerilogPreprocessData preprocessor_data_;
 
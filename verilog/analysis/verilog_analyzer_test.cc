@@ -14,7 +14,9 @@
 
 #include "verilog/analysis/verilog_analyzer.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -30,6 +32,7 @@
 #include "absl/types/span.h"
 #include "common/analysis/file_analyzer.h"
 #include "common/strings/display_utils.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/constants.h"
@@ -38,11 +41,15 @@
 #include "common/text/token_info.h"
 #include "common/text/token_info_test_util.h"
 #include "common/text/token_stream_view.h"
+#include "common/text/tree_compare.h"
 #include "common/text/tree_utils.h"
 #include "common/util/casts.h"
 #include "common/util/logging.h"
+#include "common/util/range.h"
 #include "verilog/analysis/verilog_excerpt_parse.h"
 #include "verilog/parser/verilog_token_enum.h"
+#include "verilog/preprocessor/verilog_macro_set.h"
+#include "verilog/preprocessor/verilog_preprocess.h"
 
 #undef EXPECT_OK
 #define EXPECT_OK(value) EXPECT_TRUE((value).ok())
@@ -736,6 +743,309 @@ TEST(VerilogAnalyzerExpandsMacroArgsTest, MultipleMacroCalls) {
   }
 }
 
+// Returns true if 'tokens' contains 'token' (at the same location).
+bool TokensContainToken(const verible::TokenSequence& tokens,
+                        const TokenInfo& token) {
+  return std::find(tokens.begin(), tokens.end(), token) != tokens.end();
+}
+
+// Test that repeated macro args expand in place, each at its own location.
+TEST(VerilogAnalyzerExpandsMacroArgsTest, RepeatedArgs) {
+  const TokenInfoTestData test = {"`FOO(",
+                                  {SymbolIdentifier, "a"},
+                                  " + ",
+                                  {TK_DecNumber, "1"},
+                                  ")\n`BAR(",
+                                  {SymbolIdentifier, "a"},
+                                  " + ",
+                                  {TK_DecNumber, "1"},
+                                  ", ",
+                                  {SymbolIdentifier, "a"},
+                                  " + ",
+                                  {TK_DecNumber, "1"},
+                                  ")\n"};
+  const auto analyzer =
+      absl::make_unique<VerilogAnalyzer>(test.code, "<<inline>>");
+  EXPECT_OK(analyzer->Analyze());
+  EXPECT_OK(analyzer->Data().InternalConsistencyCheck());
+  const ConcreteSyntaxTree& tree = analyzer->SyntaxTree();
+  const auto search_tokens =
+      test.FindImportantTokens(analyzer->Data().Contents());
+  ASSERT_EQ(search_tokens.size(), 6);
+  for (const auto search_token : search_tokens) {
+    EXPECT_TRUE(TreeContainsToken(tree, search_token)) << search_token;
+    EXPECT_TRUE(
+        TokensContainToken(analyzer->Data().TokenStream(), search_token))
+        << search_token;
+  }
+}
+
+// Test that repeated non-expression macro args don't expand.
+TEST(VerilogAnalyzerExpandsMacroArgsTest, RepeatedNonExprArgs) {
+  const TokenInfoTestData test = {"`FOOBAR(", {MacroArg, "module"},
+                                  ")\n",       "`FOOBAR(",
+                                  {MacroArg, "module"}, ")\n"};
+  const auto analyzer =
+      absl::make_unique<VerilogAnalyzer>(test.code, "<<inline>>");
+  EXPECT_OK(analyzer->Analyze());
+  const ConcreteSyntaxTree& tree = analyzer->SyntaxTree();
+  const auto search_tokens =
+      test.FindImportantTokens(analyzer->Data().Contents());
+  ASSERT_EQ(search_tokens.size(), 2);
+  for (const auto search_token : search_tokens) {
+    EXPECT_TRUE(TreeContainsToken(tree, search_token)) << search_token;
+  }
+}
+
+// Tests that the re-used expression parser yields the same results as
+// analyzing each text as an expression, but pointing into the text itself.
+TEST(VerilogExpressionParserTest, SameAsAnalyzeVerilogExpression) {
+  const absl::string_view test_cases[] = {
+      "a",           "a + b",               "f(x, 1'b0)",
+      "`BAR(z)",     "`FOO(`BAR(z))",       "{a, b}",
+      " c ? d : e ", "x /* comment */ [3]", "\\esc",
+  };
+  VerilogExpressionParser parser;
+  for (const auto test : test_cases) {
+    const std::string text(test);
+    verible::TokenSequence tokens;
+    std::vector<int> token_view_indices;
+    const SymbolPtr tree = parser.Parse(text, &tokens, &token_view_indices);
+    const auto expected = AnalyzeVerilogExpression(text, "<file>");
+    ASSERT_OK(expected->ParseStatus()) << text;
+    ASSERT_NE(tree, nullptr) << text;
+
+    const auto& expected_data = expected->Data();
+    const auto& expected_tokens = expected_data.TokenStream();
+    // Unlike 'tokens', the expected tokens end with EOF.
+    ASSERT_EQ(tokens.size() + 1, expected_tokens.size()) << text;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      EXPECT_EQ(tokens[i].token_enum(), expected_tokens[i].token_enum());
+      EXPECT_EQ(tokens[i].left(text),
+                expected_tokens[i].left(expected_data.Contents()));
+      EXPECT_EQ(tokens[i].text(), expected_tokens[i].text());
+    }
+    const auto& expected_view = expected_data.GetTokenStreamView();
+    ASSERT_EQ(token_view_indices.size(), expected_view.size()) << text;
+    for (size_t i = 0; i < token_view_indices.size(); ++i) {
+      EXPECT_EQ(token_view_indices[i],
+                std::distance(expected_tokens.begin(), expected_view[i]));
+    }
+    EXPECT_TRUE(verible::EqualTreesByEnumString(
+        tree.get(), expected_data.SyntaxTree().get()))
+        << text;
+    const auto* leftmost = verible::GetLeftmostLeaf(*tree);
+    ASSERT_NE(leftmost, nullptr);
+    EXPECT_TRUE(verible::IsSubRange(leftmost->get().text(),
+                                   absl::string_view(text)))
+        << text;
+  }
+
+  // Texts that are not expressions.
+  for (const absl::string_view test : {"", "module", "a +", "int x;"}) {
+    const std::string text(test);
+    verible::TokenSequence tokens;
+    std::vector<int> token_view_indices;
+    EXPECT_EQ(parser.Parse(text, &tokens, &token_view_indices), nullptr)
+        << text;
+  }
+}
+
+// Expects that 'actual' has the same tokens, token view, and syntax tree as
+// 'expected'.
+void ExpectEquivalentAnalyses(const VerilogAnalyzer& actual,
+                              const VerilogAnalyzer& expected) {
+  const auto& actual_data = actual.Data();
+  const auto& expected_data = expected.Data();
+  ASSERT_EQ(actual_data.Contents(), expected_data.Contents());
+  EXPECT_EQ(actual.LexStatus().ok(), expected.LexStatus().ok());
+  EXPECT_EQ(actual.ParseStatus().ok(), expected.ParseStatus().ok());
+  EXPECT_EQ(actual.GetRejectedTokens().size(),
+            expected.GetRejectedTokens().size());
+
+  const auto& actual_tokens = actual_data.TokenStream();
+  const auto& expected_tokens = expected_data.TokenStream();
+  ASSERT_EQ(actual_tokens.size(), expected_tokens.size());
+  for (size_t i = 0; i < actual_tokens.size(); ++i) {
+    EXPECT_EQ(actual_tokens[i].token_enum(), expected_tokens[i].token_enum())
+        << "token " << i;
+    EXPECT_EQ(actual_tokens[i].left(actual_data.Contents()),
+              expected_tokens[i].left(expected_data.Contents()))
+        << "token " << i;
+    EXPECT_EQ(actual_tokens[i].text(), expected_tokens[i].text())
+        << "token " << i;
+  }
+
+  const auto& actual_view = actual_data.GetTokenStreamView();
+  const auto& expected_view = expected_data.GetTokenStreamView();
+  ASSERT_EQ(actual_view.size(), expected_view.size());
+  for (size_t i = 0; i < actual_view.size(); ++i) {
+    EXPECT_EQ(std::distance(actual_tokens.begin(), actual_view[i]),
+              std::distance(expected_tokens.begin(), expected_view[i]))
+        << "view " << i;
+  }
+
+  EXPECT_TRUE(verible::EqualTreesByEnumString(actual.SyntaxTree().get(),
+                                              expected.SyntaxTree().get()));
+}
+
+// Returns the number of top-level items of 'after' that were reused from
+// the syntax tree 'before'.
+int CountReusedItems(const std::vector<const Symbol*>& before,
+                     const ConcreteSyntaxTree& after) {
+  if (after == nullptr || after->Kind() != verible::SymbolKind::kNode) {
+    return 0;
+  }
+  int count = 0;
+  for (const auto& item : verible::SymbolCastToNode(*after).children()) {
+    count += std::count(before.begin(), before.end(), item.get());
+  }
+  return count;
+}
+
+std::vector<const Symbol*> TopLevelItems(const ConcreteSyntaxTree& tree) {
+  std::vector<const Symbol*> items;
+  if (tree != nullptr && tree->Kind() == verible::SymbolKind::kNode) {
+    for (const auto& item : verible::SymbolCastToNode(*tree).children()) {
+      items.push_back(item.get());
+    }
+  }
+  return items;
+}
+
+struct EditTestCase {
+  absl::string_view code;
+  absl::string_view edited;  // text within 'code' to replace
+  absl::string_view replacement;
+  int reused_items;  // 0 when the edit requires a full analysis
+};
+
+TEST(VerilogAnalyzerAnalyzeEditTest, SameAsFullAnalysis) {
+  constexpr absl::string_view kModules =
+      "module a;\nendmodule\n\n"
+      "module b;\n  wire w;\nendmodule\n\n"
+      "module c;\nendmodule\n";
+  const EditTestCase test_cases[] = {
+      // Edits within one item.
+      {kModules, "wire w;", "wire [1:0] x, y;", 2},
+      {kModules, "wire w;", "", 2},
+      {kModules, "module c", "module cc", 2},
+      {kModules, "a;", "a(input clk);", 2},
+      {kModules, "wire w;", "`FOO(1 + 2)\n  `BAR(x, y)", 2},
+      {kModules, "w;\nendmodule", "w;\nendmodule : b", 2},
+      {"`define X 1\nmodule a;\nendmodule\n", "module a", "module b", 1},
+      // Edits of the space between items.
+      {kModules, "\n\n", "\n\nmodule d;\nendmodule\n\n", 3},
+      {kModules, "\n\n", "\n// comment\n\n", 3},
+      {kModules, "module b;\n  wire w;\nendmodule\n\n", "", 2},
+      {kModules, "module c;\nendmodule\n",
+       "module c;\nendmodule\n\nmodule e;\nendmodule\n", 2},
+      // Edits that span items.
+      {kModules, "endmodule\n\nmodule b;", "endmodule\n\nmodule bb;", 1},
+      // Edits that require a full analysis.
+      {kModules, "wire w;", "wire w", 0},
+      {kModules, "\n\nmodule b", "\n`define X 1\nmodule b", 0},
+      {kModules, "a;\nendmodule", "a;", 0},
+      {kModules, "\n\nmodule b", "\n\nmodulee b", 0},
+      {kModules, "endmodule\n\nmodule b", "endmodulemodule b", 0},
+      {kModules, "module a",
+       "// verilog_syntax: parse-as-module-body\nmodule a", 0},
+      {"`define X 1\nmodule a;\nendmodule\n", "X 1", "X 2", 0},
+      {"", "", "module a;\nendmodule\n", 0},
+      {"module a;\nendmodule\n", "module a;\nendmodule\n", "", 0},
+  };
+  for (const auto& test : test_cases) {
+    const std::string code(test.code);
+    const size_t offset = code.find(std::string(test.edited));
+    ASSERT_NE(offset, std::string::npos) << test.edited;
+    std::string edited_code(code);
+    edited_code.replace(offset, test.edited.length(),
+                        std::string(test.replacement));
+
+    auto previous = VerilogAnalyzer::AnalyzeAutomaticMode(code, "<file>");
+    const std::vector<const Symbol*> previous_items =
+        TopLevelItems(previous->SyntaxTree());
+    const auto analyzer = VerilogAnalyzer::AnalyzeEdit(
+        std::move(previous), offset, test.edited.length(), test.replacement);
+    const auto expected =
+        VerilogAnalyzer::AnalyzeAutomaticMode(edited_code, "<file>");
+    ExpectEquivalentAnalyses(*analyzer, *expected);
+    EXPECT_EQ(CountReusedItems(previous_items, analyzer->SyntaxTree()),
+              test.reused_items)
+        << "code:\n"
+        << edited_code;
+  }
+}
+
+TEST(VerilogAnalyzerAnalyzeEditTest, SuccessiveEdits) {
+  std::string code =
+      "module a;\nendmodule\n\nmodule b;\nendmodule\n\nmodule c;\nendmodule\n";
+  const auto macros =
+      VerilogMacroSet::Build("`define ONE 1\n`define TWO(x) (x)\n");
+  ASSERT_TRUE(macros.ok()) << macros.status();
+  VerilogPreprocessConfig config;
+  config.predefined_macros = *macros;
+  const auto analyze = [&config](const std::string& text) {
+    return VerilogAnalyzer::AnalyzeAutomaticMode(
+        std::make_shared<verible::StringMemBlock>(text), "<file>", config);
+  };
+  auto analyzer = analyze(code);
+  const std::pair<absl::string_view, absl::string_view> edits[] = {
+      {"module b;\n", "module b;\n  wire w;\n"},
+      {"wire w;", "wire w;\n  assign w = `ONE;"},
+      {"module a;\n", "module a;\n  initial $display(\"a\");\n"},
+      {"module c;\nendmodule\n", ""},
+      {"w = `ONE", "w = `TWO(3)"},
+  };
+  for (const auto& edit : edits) {
+    const size_t offset = code.find(std::string(edit.first));
+    ASSERT_NE(offset, std::string::npos) << edit.first;
+    code.replace(offset, edit.first.length(), std::string(edit.second));
+    analyzer = VerilogAnalyzer::AnalyzeEdit(std::move(analyzer), offset,
+                                            edit.first.length(), edit.second);
+    const auto expected = analyze(code);
+    ExpectEquivalentAnalyses(*analyzer, *expected);
+    // The predefined macros must survive each incremental edit.
+    EXPECT_NE(analyzer->PreprocessorData().FindMacroDefinition("ONE"), nullptr);
+    EXPECT_NE(analyzer->PreprocessorData().FindMacroDefinition("TWO"), nullptr);
+  }
+}
+
+// Tests that analyzing in a parsing mode with already lexed (and normal-mode
+// disambiguated) tokens yields the same as lexing the text again.
+TEST(AnalyzeVerilogWithModeTest, ReusedTokensSameAsLexed) {
+  const std::pair<absl::string_view, absl::string_view> test_cases[] = {
+      // code, mode
+      {"always @(posedge clk) begin -> e; x <= y; end\n",
+       "parse-as-module-body"},
+      {"constraint c { x -> y; }\n", "parse-as-class-body"},
+      {"property p;\n  int x;\n  a |-> b;\nendproperty\n",
+       "parse-as-module-body"},
+      {"x = y -> z;\n-> e;\n", "parse-as-statements"},
+      {"a -> b", "parse-as-property-spec"},
+      {"a + b", "parse-as-expression"},
+      {"", "parse-as-package-body"},
+      {"library foolib bar/*.vg;\ninclude bar/*.vg;\n",
+       "parse-as-library-map"},
+      {"wire w;\n`define X \\\n  1\n", "parse-as-module-body"},
+      {"module m; endmodule", "parse-as-module-body"},
+  };
+  for (const auto& test : test_cases) {
+    const std::string code(test.first);
+    VerilogAnalyzer normal_analyzer(code, "<file>");
+    normal_analyzer.Analyze().IgnoreError();
+    const auto analyzer = AnalyzeVerilogWithMode(
+        code, normal_analyzer.Data().TokenStream(), "<file>", test.second);
+    const auto expected = AnalyzeVerilogWithMode(code, "<file>", test.second);
+    ASSERT_NE(analyzer, nullptr);
+    ASSERT_NE(expected, nullptr);
+    ExpectEquivalentAnalyses(*analyzer, *expected);
+  }
+  EXPECT_EQ(AnalyzeVerilogWithMode("", verible::TokenSequence{}, "<file>",
+                                   "parse-as-nothing"),
+            nullptr);
+}
+
 // Helper class for testing internals.
 class VerilogAnalyzerInternalsTest : public testing::Test,
                                      public VerilogAnalyzer {
@@ -14,34 +14,80 @@
 
 #include "verilog/analysis/verilog_excerpt_parse.h"
 
-#include <functional>
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "common/lexer/token_stream_adapter.h"
 #include "common/text/text_structure.h"
+#include "common/text/token_stream_view.h"
+#include "common/text/tree_utils.h"
 #include "common/util/container_util.h"
 #include "common/util/logging.h"
 #include "verilog/analysis/verilog_analyzer.h"
+#include "verilog/parser/verilog_lexer.h"
+#include "verilog/parser/verilog_lexical_context.h"
+#include "verilog/parser/verilog_parser.h"
+#include "verilog/parser/verilog_token_enum.h"
 
 namespace verilog {
 
 using verible::container::FindOrNull;
 
+// Text that wraps around an excerpt to form a whole Verilog source, so that
+// the excerpt is parsed as a particular construct.
+struct ExcerptContext {
+  absl::string_view prolog;
+  absl::string_view epilog;
+};
+
+static constexpr ExcerptContext kPropertySpecContext{
+    "module foo;\nproperty p;\n", "\nendproperty;\nendmodule;\n"};
+static constexpr ExcerptContext kStatementsContext{"function foo();\n",
+                                                   "\nendfunction\n"};
+// $error in this context is an elaboration system task
+// The space before the ) is critical to accommodate escaped identifiers.
+// Without the space, lexing an escaped identifier would consume part
+// of the epilog text.
+static constexpr ExcerptContext kExpressionContext{
+    "module foo;\nif (", " ) $error;\nendmodule\n"};
+static constexpr ExcerptContext kModuleBodyContext{"module foo;\n",
+                                                   "\nendmodule\n"};
+static constexpr ExcerptContext kClassBodyContext{"class foo;\n",
+                                                  "\nendclass\n"};
+static constexpr ExcerptContext kPackageBodyContext{"package foo;\n",
+                                                    "\nendpackage\n"};
+// The prolog/epilog strings come from verilog.lex as token enums:
+// PD_LIBRARY_SYNTAX_BEGIN and PD_LIBRARY_SYNTAX_END.
+// These are used in verilog.y to enclose the complete library_description
+// grammar rule.
+static constexpr ExcerptContext kLibraryMapContext{
+    "`____verible_verilog_library_begin____\n",
+    "\n`____verible_verilog_library_end____\n"};
+
 // Function template to create any mini-parser for Verilog.
-// 'prolog' and 'epilog' are text that wrap around the 'text' argument to
-// form a whole Verilog source.
+// 'context' wraps around the 'text' argument to form a whole Verilog source.
+// If 'text_tokens' is not null, it holds the already lexed tokens of 'text',
+// which are re-used instead of lexing 'text' again where possible.
 // The returned analyzer's text structure will discard parsed information
 // about the prolog and epilog, leaving only the substructure of interest.
 static std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogConstruct(
-    absl::string_view prolog, absl::string_view text, absl::string_view epilog,
-    absl::string_view filename) {
+    const ExcerptContext& context, absl::string_view text,
+    absl::string_view filename,
+    const verible::TokenSequence* text_tokens = nullptr) {
   VLOG(2) << __FUNCTION__;
+  const absl::string_view prolog = context.prolog;
+  const absl::string_view epilog = context.epilog;
   CHECK(epilog.empty() || absl::ascii_isspace(epilog[0]))
       << "epilog text must begin with a whitespace to prevent unintentional "
          "token-joining and escaped-identifier extension.";
@@ -52,6 +98,17 @@ static std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogConstruct(
       analyze_text, filename,
       /* use_parser_directive_comments_ */ false);
 
+  // Tokens of 'text' lexed on their own are the same as when lexed within the
+  // prolog and epilog, unless a token could join with the end of the prolog,
+  // or a line continuation could extend into the epilog.
+  if (text_tokens != nullptr &&
+      (prolog.empty() || absl::ascii_isspace(prolog.back())) &&
+      !absl::EndsWith(text, "\\")) {
+    ABSL_DIE_IF_NULL(analyzer_ptr)
+        ->TokenizeWithLexedSubstring(prolog.length(), *text_tokens)
+        .IgnoreError();  // Analyze() reports the status.
+  }
+
   if (!ABSL_DIE_IF_NULL(analyzer_ptr)->Analyze().ok()) {
     VLOG(2) << __FUNCTION__ << ": Analyze() failed.  code:\n" << analyze_text;
     // Continue to processes, even if there's an error, so that token
@@ -71,73 +128,180 @@ static std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogConstruct(
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogPropertySpec(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("module foo;\nproperty p;\n", text,
-                                 "\nendproperty;\nendmodule;\n", filename);
+  return AnalyzeVerilogConstruct(kPropertySpecContext, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogStatements(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("function foo();\n", text, "\nendfunction\n",
-                                 filename);
+  return AnalyzeVerilogConstruct(kStatementsContext, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogExpression(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("module foo;\nif (", text,
-                                 " ) $error;\nendmodule\n", filename);
-  // $error in this context is an elaboration system task
-  // The space before the ) is critical to accommodate escaped identifiers.
-  // Without the space, lexing an escaped identifier would consume part
-  // of the epilog text.
+  return AnalyzeVerilogConstruct(kExpressionContext, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogModuleBody(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("module foo;\n", text, "\nendmodule\n",
-                                 filename);
+  return AnalyzeVerilogConstruct(kModuleBodyContext, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogClassBody(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("class foo;\n", text, "\nendclass\n",
-                                 filename);
+  return AnalyzeVerilogConstruct(kClassBodyContext, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogPackageBody(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("package foo;\n", text, "\nendpackage\n",
-                                 filename);
+  return AnalyzeVerilogConstruct(kPackageBodyContext, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogLibraryMap(
     absl::string_view text, absl::string_view filename) {
-  // The prolog/epilog strings come from verilog.lex as token enums:
-  // PD_LIBRARY_SYNTAX_BEGIN and PD_LIBRARY_SYNTAX_END.
-  // These are used in verilog.y to enclose the complete library_description
-  // grammar rule.
-  return AnalyzeVerilogConstruct(
-      "`____verible_verilog_library_begin____\n", text,
-      "\n`____verible_verilog_library_end____\n", filename);
+  return AnalyzeVerilogConstruct(kLibraryMapContext, text, filename);
+}
+
+// Returns the context that selects parsing 'mode', or nullptr if the mode is
+// unknown.
+static const ExcerptContext* ParsingModeContext(absl::string_view mode) {
+  static const auto* context_map =
+      new std::map<absl::string_view, const ExcerptContext*>{
+          {"parse-as-statements", &kStatementsContext},
+          {"parse-as-expression", &kExpressionContext},
+          {"parse-as-module-body", &kModuleBodyContext},
+          {"parse-as-class-body", &kClassBodyContext},
+          {"parse-as-package-body", &kPackageBodyContext},
+          {"parse-as-property-spec", &kPropertySpecContext},
+          {"parse-as-library-map", &kLibraryMapContext},
+      };
+  const auto* context_ptr = FindOrNull(*context_map, mode);
+  return context_ptr == nullptr ? nullptr : *context_ptr;
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogWithMode(
     absl::string_view text, absl::string_view filename,
     absl::string_view mode) {
-  static const auto* func_map =
-      new std::map<absl::string_view,
-                   std::function<std::unique_ptr<VerilogAnalyzer>(
-                       absl::string_view, absl::string_view)>>{
-          {"parse-as-statements", &AnalyzeVerilogStatements},
-          {"parse-as-expression", &AnalyzeVerilogExpression},
-          {"parse-as-module-body", &AnalyzeVerilogModuleBody},
-          {"parse-as-class-body", &AnalyzeVerilogClassBody},
-          {"parse-as-package-body", &AnalyzeVerilogPackageBody},
-          {"parse-as-property-spec", &AnalyzeVerilogPropertySpec},
-          {"parse-as-library-map", &AnalyzeVerilogLibraryMap},
-      };
-  auto func_ptr = FindOrNull(*func_map, mode);
-  if (func_ptr == nullptr) return nullptr;
-  return (*func_ptr)(text, filename);
+  const ExcerptContext* context = ParsingModeContext(mode);
+  if (context == nullptr) return nullptr;
+  return AnalyzeVerilogConstruct(*context, text, filename);
+}
+
+std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogWithMode(
+    absl::string_view text, const verible::TokenSequence& text_tokens,
+    absl::string_view filename, absl::string_view mode) {
+  const ExcerptContext* context = ParsingModeContext(mode);
+  if (context == nullptr) return nullptr;
+  return AnalyzeVerilogConstruct(*context, text, filename, &text_tokens);
+}
+
+VerilogExpressionParser::VerilogExpressionParser()
+    : lexer_(absl::make_unique<VerilogLexer>("")) {}
+
+VerilogExpressionParser::~VerilogExpressionParser() = default;
+
+// Parses 'text' with AnalyzeVerilogExpression(), which also expands the
+// arguments of macro calls in 'text', and moves the results into 'tokens',
+// 'token_view_indices' and the returned tree, pointing into 'text'.
+static verible::SymbolPtr AnalyzeExpressionWithMacroArgs(
+    absl::string_view text, verible::TokenSequence* tokens,
+    std::vector<int>* token_view_indices) {
+  const auto analyzer = AnalyzeVerilogExpression(text, "<expression>");
+  if (!analyzer->LexStatus().ok() || !analyzer->ParseStatus().ok()) {
+    return nullptr;
+  }
+  verible::TextStructureView& data = analyzer->MutableData();
+  const absl::string_view analyzed_text = data.Contents();
+  data.MutateTokens([=](verible::TokenInfo* token) {
+    token->RebaseStringView(text.begin() + token->left(analyzed_text));
+  });
+  verible::TokenSequence& analyzed_tokens = data.MutableTokenStream();
+  token_view_indices->clear();
+  for (const auto& iter : data.GetTokenStreamView()) {
+    if (iter->isEOF()) break;
+    token_view_indices->push_back(
+        std::distance(analyzed_tokens.cbegin(), iter));
+  }
+  if (!analyzed_tokens.empty() && analyzed_tokens.back().isEOF()) {
+    analyzed_tokens.pop_back();
+  }
+  *tokens = std::move(analyzed_tokens);
+  verible::SymbolPtr tree = std::move(data.MutableSyntaxTree());
+  data.Clear();
+  return tree;
+}
+
+// This follows the same steps as AnalyzeVerilogConstruct() with
+// kExpressionContext, minus the preprocessor and the expansion of macro call
+// arguments.  Texts with macro call arguments, which are rare, are analyzed
+// with AnalyzeVerilogExpression() instead, which expands them.
+verible::SymbolPtr VerilogExpressionParser::Parse(
+    absl::string_view text, verible::TokenSequence* tokens,
+    std::vector<int>* token_view_indices) {
+  const absl::string_view prolog = kExpressionContext.prolog;
+  const absl::string_view epilog = kExpressionContext.epilog;
+  buffer_.assign(prolog.begin(), prolog.end());
+  buffer_.append(text.begin(), text.end());
+  buffer_.append(epilog.begin(), epilog.end());
+  const absl::string_view buffer(buffer_);
+  const absl::string_view buffer_text =
+      buffer.substr(prolog.length(), text.length());
+
+  buffer_tokens_.clear();
+  const auto lex_status = verible::MakeTokenSequence(
+      lexer_.get(), buffer, &buffer_tokens_, [](const verible::TokenInfo&) {});
+  if (!lex_status.ok()) return nullptr;
+  if (std::any_of(buffer_tokens_.begin(), buffer_tokens_.end(),
+                  [](const verible::TokenInfo& token) {
+                    return token.token_enum() == MacroArg;
+                  })) {
+    return AnalyzeExpressionWithMacroArgs(text, tokens, token_view_indices);
+  }
+
+  verible::TokenStreamReferenceView tokens_view;
+  for (auto iter = buffer_tokens_.begin(); iter != buffer_tokens_.end();
+       ++iter) {
+    if (VerilogLexer::KeepSyntaxTreeTokens(*iter)) tokens_view.push_back(iter);
+  }
+  LexicalContext context;
+  context.TransformVerilogSymbols(tokens_view);
+
+  verible::SymbolPtr tree;
+  {
+    const verible::TokenStreamView parser_view(tokens_view.begin(),
+                                               tokens_view.end());
+    auto generator = verible::MakeTokenViewer(parser_view);
+    VerilogParser parser(&generator);
+    if (!parser.Parse().ok()) return nullptr;
+    tree = parser.TakeRoot();
+  }
+  verible::TrimSyntaxTree(&tree, buffer_text);
+  if (tree == nullptr) return nullptr;
+
+  // Point the tokens and leaves of the excerpt into 'text'.
+  const auto rebase = [=](verible::TokenInfo* token) {
+    const size_t offset =
+        std::distance(buffer_text.begin(), token->text().begin());
+    token->RebaseStringView(text.begin() + offset);
+  };
+  verible::MutateLeaves(&tree, rebase);
+  tokens->clear();
+  token_view_indices->clear();
+  for (auto iter = buffer_tokens_.begin(); iter != buffer_tokens_.end();
+       ++iter) {
+    if (iter->isEOF()) break;
+    const auto offset =
+        std::distance(buffer_text.begin(), iter->text().begin());
+    if (offset < 0) continue;
+    if (offset >= static_cast<int>(text.length())) break;
+    // A token that would extend into the epilog is not part of 'text'.
+    if (offset + iter->text().length() > text.length()) return nullptr;
+    if (VerilogLexer::KeepSyntaxTreeTokens(*iter)) {
+      token_view_indices->push_back(tokens->size());
+    }
+    tokens->push_back(*iter);
+    rebase(&tokens->back());
+  }
+  return tree;
 }
 
 }  // namespace verilog
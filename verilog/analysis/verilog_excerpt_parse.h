@@ -21,8 +21,13 @@
 #define VERIBLE_VERILOG_ANALYSIS_VERILOG_EXCERPT_PARSE_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/token_info.h"
+#include "common/text/token_stream_view.h"
 #include "verilog/analysis/verilog_analyzer.h"
 
 namespace verilog {
@@ -64,6 +69,50 @@ std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogLibraryMap(
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogWithMode(
     absl::string_view text, absl::string_view filename, absl::string_view mode);
 
+// Same as above, but re-uses 'text_tokens', the already lexed tokens of
+// 'text' (e.g. from analyzing it in another mode), instead of lexing 'text'
+// again where possible.
+std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogWithMode(
+    absl::string_view text, const verible::TokenSequence& text_tokens,
+    absl::string_view filename, absl::string_view mode);
+
+class VerilogLexer;
+
+// VerilogExpressionParser parses many small texts as expressions, like
+// AnalyzeVerilogExpression(), without the cost of a VerilogAnalyzer and a
+// copy of the text per call: one lexer and one text buffer are re-used
+// across calls.  The results point into the parsed text itself.
+// Texts are not preprocessed; preprocessing directives are not expressions.
+// Texts with macro call arguments are analyzed by AnalyzeVerilogExpression(),
+// so that their arguments are expanded the same way.
+class VerilogExpressionParser {
+ public:
+  VerilogExpressionParser();
+  ~VerilogExpressionParser();
+
+  VerilogExpressionParser(const VerilogExpressionParser&) = delete;
+  VerilogExpressionParser& operator=(const VerilogExpressionParser&) = delete;
+
+  // Parses 'text' as an expression.  On success, returns the syntax tree,
+  // 'tokens' holds all tokens of 'text' (without EOF), and
+  // 'token_view_indices' holds the positions of the parsed (non-whitespace)
+  // tokens among them.  All tokens and leaves point into 'text'.
+  // Returns nullptr if 'text' does not parse as an expression.
+  verible::SymbolPtr Parse(absl::string_view text,
+                           verible::TokenSequence* tokens,
+                           std::vector<int>* token_view_indices);
+
+ private:
+  // Re-used lexer.
+  std::unique_ptr<VerilogLexer> lexer_;
+
+  // Re-used buffer for the text and the context that surrounds it.
+  std::string buffer_;
+
+  // Re-used buffer for the tokens of buffer_.
+  verible::TokenSequence buffer_tokens_;
+};
+
 }  // namespace verilog
 
 #endif  // VERIBLE_VERILOG_ANALYSIS_VERILOG_EXCERPT_PARSE_H_
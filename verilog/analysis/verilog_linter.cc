@@ -14,7 +14,11 @@
 
 #include "verilog/analysis/verilog_linter.h"
 
+#include <algorithm>
+#include <climits>
 #include <cstddef>
+#include <cstdlib>
+#include <functional>
 #include <iomanip>
 #include <map>
 #include <memory>
@@ -24,25 +28,37 @@
 #include <vector>
 
 #include "absl/flags/flag.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "common/analysis/line_lint_rule.h"
 #include "common/analysis/line_linter.h"
+#include "common/analysis/lint_result_cache.h"
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/lint_waiver.h"
+#include "common/analysis/syntax_tree_index.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
 #include "common/analysis/syntax_tree_linter.h"
 #include "common/analysis/text_structure_lint_rule.h"
 #include "common/analysis/text_structure_linter.h"
 #include "common/analysis/token_stream_lint_rule.h"
 #include "common/analysis/token_stream_linter.h"
+#include "common/strings/fingerprint.h"
 #include "common/strings/line_column_map.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
+#include "common/text/tree_utils.h"
 #include "common/util/file_util.h"
 #include "common/util/logging.h"
+#include "common/util/thread_pool.h"
 #include "verilog/analysis/default_rules.h"
 #include "verilog/analysis/lint_rule_registry.h"
 #include "verilog/analysis/verilog_analyzer.h"
@@ -50,6 +66,7 @@
 #include "verilog/analysis/verilog_linter_constants.h"
 #include "verilog/parser/verilog_token_classifications.h"
 #include "verilog/parser/verilog_token_enum.h"
+#include "verilog/preprocessor/verilog_macro_set.h"
 
 // TODO(hzeller): make --rules repeatable and cumulative
 
@@ -69,34 +86,95 @@ ABSL_FLAG(verilog::RuleSet, ruleset, verilog::RuleSet::kDefault,
 ABSL_FLAG(std::string, waiver_files, "",
           "Path to waiver config files (comma-separated). "
           "Please refer to the README file for information about its format.");
+ABSL_FLAG(int, lint_threads, 1,
+          "Number of threads that analyze each file.  With more than one, "
+          "the different kinds of rules run concurrently, and the syntax tree "
+          "of a file with many top-level descriptions is split among threads. "
+          "Findings do not depend on the number of threads.");
 
 namespace verilog {
 
+using verible::ExternalWaiverFile;
 using verible::LineColumnMap;
 using verible::LintRuleStatus;
 using verible::LintWaiver;
 using verible::TextStructureView;
 using verible::TokenInfo;
 
-// Return code useful to be used in main:
-//  0: success
-//  1: linting error (if parse_fatal == true)
-//  2..: other fatal issues such as file not found.
-int LintOneFile(std::ostream* stream, absl::string_view filename,
-                const LinterConfiguration& config, bool check_syntax,
-                bool parse_fatal, bool lint_fatal) {
-  std::string content;
-  const absl::Status content_status =
-      verible::file::GetContents(filename, &content);
-  if (!content_status.ok()) {
-    LOG(ERROR) << "Can't read '" << filename
-               << "': " << content_status.message();
-    return 2;
+namespace {
+// FileDerivedCache memoizes values that are derived from the content of a
+// file, such as parsed configuration and waiver files, so that they can be
+// shared among all linted files.  A value is re-derived whenever the
+// version of its source file changes.  Values derived from recently changed
+// files are not cached, because such files may change again without a change
+// of version.  Thread-safe.
+template <typename T>
+class FileDerivedCache {
+ public:
+  using ValuePtr = std::shared_ptr<const T>;
+
+  // Returns the value for 'key', derived from 'source_file' (which may be
+  // empty if there is no file), using 'make' when the value is not cached or
+  // is out of date.
+  ValuePtr Get(const std::string& key, absl::string_view source_file,
+               const std::function<ValuePtr()>& make) {
+    verible::file::FileVersion version;  // default for missing files
+    if (!source_file.empty()) {
+      const auto file_version = verible::file::GetFileVersion(source_file);
+      if (file_version.ok()) version = *file_version;
+    }
+    {
+      absl::MutexLock l(&lock_);
+      const auto found = entries_.find(key);
+      if (found != entries_.end() && found->second.version == version) {
+        return found->second.value;
+      }
+    }
+    // Derive outside of the lock.  Concurrent misses only do redundant work.
+    ValuePtr value = make();
+    if (version.IsRecent(absl::Now())) return value;
+    absl::MutexLock l(&lock_);
+    entries_[key] = {version, value};
+    return value;
   }
 
+ private:
+  struct Entry {
+    verible::file::FileVersion version;
+    ValuePtr value;
+  };
+
+  absl::Mutex lock_;
+  std::map<std::string, Entry> entries_ ABSL_GUARDED_BY(lock_);
+};
+}  // namespace
+
+// Returns the lexed external waiver file at 'path', or nullptr if it is
+// unreadable or empty.  Each waiver file is read and lexed once, and shared by
+// all linted files.
+static std::shared_ptr<const ExternalWaiverFile> GetExternalWaiverFile(
+    absl::string_view path) {
+  static auto* cache = new FileDerivedCache<ExternalWaiverFile>;
+  return cache->Get(
+      std::string(path), path,
+      [path]() -> std::shared_ptr<const ExternalWaiverFile> {
+        std::string content;
+        const auto status = verible::file::GetContents(path, &content);
+        if (!status.ok() || content.empty()) return nullptr;
+        return std::make_shared<const ExternalWaiverFile>(path,
+                                                          std::move(content));
+      });
+}
+
+// Lints 'content' of 'filename', see LintOneFile().
+static int LintContent(std::ostream* stream, absl::string_view filename,
+                       const std::shared_ptr<verible::MemBlock>& content,
+                       const LinterConfiguration& config, bool check_syntax,
+                       bool parse_fatal, bool lint_fatal,
+                       const VerilogPreprocessConfig& preprocess_config) {
   // Lex and parse the contents of the file.
-  const auto analyzer =
-      VerilogAnalyzer::AnalyzeAutomaticMode(content, filename);
+  const auto analyzer = VerilogAnalyzer::AnalyzeAutomaticMode(
+      content, filename, preprocess_config);
   if (check_syntax) {
     const auto lex_status = ABSL_DIE_IF_NULL(analyzer)->LexStatus();
     const auto parse_status = analyzer->ParseStatus();
@@ -117,7 +195,8 @@ int LintOneFile(std::ostream* stream, absl::string_view filename,
   // Analyze the parsed structure for lint violations.
   std::ostringstream lint_stream;
   const absl::Status lint_status = VerilogLintTextStructure(
-      &lint_stream, std::string(filename), content, config, analyzer->Data());
+      &lint_stream, std::string(filename), content->AsStringView(), config,
+      analyzer->Data());
   if (!lint_status.ok()) {
     // Something went wrong with running the lint analysis itself.
     LOG(ERROR) << "Fatal error: " << lint_status.message();
@@ -130,8 +209,97 @@ int LintOneFile(std::ostream* stream, absl::string_view filename,
   return 0;
 }
 
-VerilogLinter::VerilogLinter()
-    : lint_waiver_(
+// Returns the key of the cached result of linting 'content' of 'filename'.
+// The diagnostics depend on the file name and content, the effective
+// configuration, the content of the external waiver files, and the options
+// that control reporting and preprocessing.
+static verible::Fingerprint LintResultKey(
+    const verible::LintResultCache& cache, absl::string_view filename,
+    absl::string_view content, const LinterConfiguration& config,
+    bool check_syntax, bool parse_fatal, bool lint_fatal,
+    const VerilogPreprocessConfig& preprocess_config) {
+  const std::string configuration = config.UnparseConfiguration();
+  const auto& predefined_macros = preprocess_config.predefined_macros;
+  const std::string options = absl::StrCat(
+      check_syntax, parse_fatal, lint_fatal, preprocess_config.filter_branches,
+      ":", absl::StrJoin(preprocess_config.defines, ","), ":",
+      predefined_macros ? predefined_macros->fingerprint().ToHex() : "");
+  std::vector<std::shared_ptr<const ExternalWaiverFile>> waiver_files;
+  std::vector<absl::string_view> parts = {filename, content, configuration,
+                                          options};
+  for (const auto& waiver_file :
+       absl::StrSplit(config.external_waivers, ',', absl::SkipEmpty())) {
+    waiver_files.push_back(GetExternalWaiverFile(waiver_file));
+    parts.push_back(waiver_files.back() == nullptr
+                        ? absl::string_view()
+                        : waiver_files.back()->Contents());
+  }
+  return cache.MakeKey(parts);
+}
+
+// Return code useful to be used in main:
+//  0: success
+//  1: linting error (if parse_fatal == true)
+//  2..: other fatal issues such as file not found.
+int LintOneFile(std::ostream* stream, absl::string_view filename,
+                const LinterConfiguration& config, bool check_syntax,
+                bool parse_fatal, bool lint_fatal,
+                const verible::LintResultCache* cache,
+                const VerilogPreprocessConfig& preprocess_config) {
+  // Memory-mapped where possible, to avoid copying large files.
+  auto content_or = verible::file::GetContentAsMemBlock(filename);
+  if (!content_or.ok()) {
+    LOG(ERROR) << "Can't read '" << filename
+               << "': " << content_or.status().message();
+    return 2;
+  }
+  return LintOneFileContent(stream, filename, std::move(*content_or), config,
+                            check_syntax, parse_fatal, lint_fatal, cache,
+                            preprocess_config);
+}
+
+int LintOneFileContent(std::ostream* stream, absl::string_view filename,
+                       std::shared_ptr<verible::MemBlock> content,
+                       const LinterConfiguration& config, bool check_syntax,
+                       bool parse_fatal, bool lint_fatal,
+                       const verible::LintResultCache* cache,
+                       const VerilogPreprocessConfig& preprocess_config) {
+  if (cache == nullptr) {
+    return LintContent(stream, filename, content, config, check_syntax,
+                       parse_fatal, lint_fatal, preprocess_config);
+  }
+
+  // Replay the diagnostics of an earlier run, without lexing or parsing.
+  const verible::Fingerprint key =
+      LintResultKey(*cache, filename, content->AsStringView(), config,
+                    check_syntax, parse_fatal, lint_fatal, preprocess_config);
+  const auto cached = cache->Lookup(key);
+  if (cached.ok()) {
+    *stream << cached->output;
+    return cached->exit_status;
+  }
+
+  std::ostringstream output;
+  verible::LintResultCache::Result result;
+  result.exit_status =
+      LintContent(&output, filename, content, config, check_syntax,
+                  parse_fatal, lint_fatal, preprocess_config);
+  result.output = output.str();
+  *stream << result.output;
+  // Fatal errors are not results of the analysis, so they are not cached.
+  if (result.exit_status <= 1) {
+    const absl::Status store_status = cache->Store(key, result);
+    if (!store_status.ok()) {
+      LOG(WARNING) << "Can't cache lint result of '" << filename
+                   << "': " << store_status.message();
+    }
+  }
+  return result.exit_status;
+}
+
+VerilogLinter::VerilogLinter(int num_threads)
+    : num_threads_(num_threads),
+      lint_waiver_(
           [](const TokenInfo& t) {
             return IsComment(verilog_tokentype(t.token_enum()));
           },
@@ -161,22 +329,42 @@ absl::Status VerilogLinter::Configure(const LinterConfiguration& configuration,
     token_stream_linter_.AddRule(std::move(rule));
   }
   auto syntax_rules = configuration.CreateSyntaxTreeRules();
-  for (auto& rule : syntax_rules) {
-    syntax_tree_linter_.AddRule(std::move(rule));
+  if (num_threads_ > 1) {
+    // Subtree-local rules go to the first shard.  More shards are created
+    // when a syntax tree is large enough to be split.
+    syntax_tree_shards_.push_back(
+        absl::make_unique<verible::SyntaxTreeLinter>());
+    for (auto& rule : syntax_rules) {
+      const bool sharded = rule->IsSubtreeLocal();
+      rule_is_sharded_.push_back(sharded);
+      (sharded ? *syntax_tree_shards_.front() : syntax_tree_linter_)
+          .AddRule(std::move(rule));
+    }
+    create_subtree_local_rules_ = [configuration]() {
+      auto rules = configuration.CreateSyntaxTreeRules();
+      rules.erase(std::remove_if(rules.begin(), rules.end(),
+                                 [](const auto& rule) {
+                                   return !rule->IsSubtreeLocal();
+                                 }),
+                  rules.end());
+      return rules;
+    };
+  } else {
+    for (auto& rule : syntax_rules) {
+      syntax_tree_linter_.AddRule(std::move(rule));
+    }
   }
 
   absl::Status rc = absl::OkStatus();
+  const auto active_rules = configuration.ActiveRuleIds();
   for (const auto& waiver_file :
        absl::StrSplit(configuration.external_waivers, ',', absl::SkipEmpty())) {
-    std::string content;
-    auto status = verible::file::GetContents(waiver_file, &content);
-    if (content.empty()) {
+    const auto waivers = GetExternalWaiverFile(waiver_file);
+    if (waivers == nullptr) {
       continue;
     }
-    if (status.ok()) {
-      status = lint_waiver_.ApplyExternalWaivers(
-          configuration.ActiveRuleIds(), lintee_filename, waiver_file, content);
-    }
+    const auto status = lint_waiver_.ApplyExternalWaivers(
+        active_rules, lintee_filename, *waivers);
     if (!status.ok()) {
       rc.Update(status);
     }
@@ -185,27 +373,128 @@ absl::Status VerilogLinter::Configure(const LinterConfiguration& configuration,
   return rc;
 }
 
+// Minimum number of top-level descriptions per syntax tree shard, so that
+// small files are not split.
+static constexpr size_t kMinDescriptionsPerShard = 8;
+
 void VerilogLinter::Lint(const TextStructureView& text_structure,
                          absl::string_view filename) {
   // Collect all lint waivers in an initial pass.
-  lint_waiver_.ProcessTokenRangesByLine(text_structure);
+  const auto waiver_status =
+      lint_waiver_.ProcessTokenRangesByLine(text_structure);
+  if (!waiver_status.ok()) {
+    LOG(ERROR) << "Can't apply regex waivers to '" << filename
+               << "': " << waiver_status.message();
+  }
+
+  // Lets rules search subtrees for nodes by tag without walking them.
+  const verible::ConcreteSyntaxTree& syntax_tree = text_structure.SyntaxTree();
+  std::unique_ptr<verible::SyntaxTreeIndex> index;
+  if (syntax_tree != nullptr) {
+    index = absl::make_unique<verible::SyntaxTreeIndex>(*syntax_tree);
+  }
+
+  // The analyses only read the text structure, and each one updates only its
+  // own rules, so they can run concurrently.  With a single thread, they run
+  // one after another in this thread.  The pool waits for all of them to
+  // finish when it goes out of scope.
+  verible::ThreadPool pool(num_threads_ > 1 ? num_threads_ : 0);
 
   // Analyze general text structure.
-  text_structure_linter_.Lint(text_structure, filename);
+  pool.Schedule([&] { text_structure_linter_.Lint(text_structure, filename); });
 
   // Analyze lines of text.
-  line_linter_.Lint(text_structure.Lines());
+  pool.Schedule([&] { line_linter_.Lint(text_structure.Lines()); });
 
   // Analyze token stream.
-  token_stream_linter_.Lint(text_structure.TokenStream());
+  pool.Schedule(
+      [&] { token_stream_linter_.Lint(text_structure.TokenStream()); });
 
   // Analyze syntax tree.
-  const verible::ConcreteSyntaxTree& syntax_tree = text_structure.SyntaxTree();
   if (syntax_tree != nullptr) {
-    syntax_tree_linter_.Lint(*syntax_tree);
+    ScheduleSyntaxTreeLint(*syntax_tree, *index, &pool);
   }
 }
 
+void VerilogLinter::ScheduleSyntaxTreeLint(
+    const verible::Symbol& root, const verible::SyntaxTreeIndex& index,
+    verible::ThreadPool* pool) {
+  // The index is activated in each thread that lints the syntax tree.
+  // With shards, syntax_tree_linter_ only has rules that are not sharded.
+  if (syntax_tree_shards_.empty() ||
+      std::find(rule_is_sharded_.begin(), rule_is_sharded_.end(), false) !=
+          rule_is_sharded_.end()) {
+    pool->Schedule([this, &root, &index] {
+      const verible::SyntaxTreeIndex::ScopedActivation activate_index(&index);
+      syntax_tree_linter_.Lint(root);
+    });
+  }
+  if (syntax_tree_shards_.empty()) return;
+
+  // Split the top-level descriptions into consecutive ranges, one per shard.
+  const size_t num_descriptions =
+      root.Kind() == verible::SymbolKind::kNode
+          ? verible::SymbolCastToNode(root).children().size()
+          : 0;
+  const size_t num_shards = std::max<size_t>(
+      1, std::min<size_t>(num_threads_,
+                          num_descriptions / kMinDescriptionsPerShard));
+  if (num_shards == 1) {
+    pool->Schedule([this, &root, &index] {
+      const verible::SyntaxTreeIndex::ScopedActivation activate_index(&index);
+      syntax_tree_shards_.front()->Lint(root);
+    });
+    return;
+  }
+  VLOG(1) << "Splitting " << num_descriptions << " descriptions among "
+          << num_shards << " syntax tree shards.";
+  while (syntax_tree_shards_.size() < num_shards) {
+    auto shard = absl::make_unique<verible::SyntaxTreeLinter>();
+    for (auto& rule : create_subtree_local_rules_()) {
+      shard->AddRule(std::move(rule));
+    }
+    syntax_tree_shards_.push_back(std::move(shard));
+  }
+  const auto& root_node = verible::SymbolCastToNode(root);
+  for (size_t i = 0; i < num_shards; ++i) {
+    const size_t begin = num_descriptions * i / num_shards;
+    const size_t end = num_descriptions * (i + 1) / num_shards;
+    verible::SyntaxTreeLinter* shard = syntax_tree_shards_[i].get();
+    pool->Schedule([shard, &root_node, &index, begin, end] {
+      const verible::SyntaxTreeIndex::ScopedActivation activate_index(&index);
+      shard->LintChildren(root_node, begin, end);
+    });
+  }
+}
+
+std::vector<LintRuleStatus> VerilogLinter::SyntaxTreeLintStatus() const {
+  std::vector<LintRuleStatus> unsharded = syntax_tree_linter_.ReportStatus();
+  if (syntax_tree_shards_.empty()) return unsharded;
+
+  // Merge the findings of the shards, which are disjoint.
+  std::vector<LintRuleStatus> sharded =
+      syntax_tree_shards_.front()->ReportStatus();
+  for (size_t i = 1; i < syntax_tree_shards_.size(); ++i) {
+    const std::vector<LintRuleStatus> shard_statuses =
+        syntax_tree_shards_[i]->ReportStatus();
+    CHECK_EQ(shard_statuses.size(), sharded.size());
+    for (size_t j = 0; j < sharded.size(); ++j) {
+      sharded[j].violations.insert(shard_statuses[j].violations.begin(),
+                                   shard_statuses[j].violations.end());
+    }
+  }
+
+  // Restore the configured order of the rules.
+  std::vector<LintRuleStatus> statuses;
+  auto next_unsharded = unsharded.begin();
+  auto next_sharded = sharded.begin();
+  for (const bool is_sharded : rule_is_sharded_) {
+    statuses.push_back(std::move(is_sharded ? *next_sharded++
+                                            : *next_unsharded++));
+  }
+  return statuses;
+}
+
 static void AppendLintRuleStatuses(
     const std::vector<LintRuleStatus>& new_statuses,
     const verible::LintWaiver& waivers, const LineColumnMap& line_map,
@@ -243,40 +532,155 @@ std::vector<LintRuleStatus> VerilogLinter::ReportStatus(
                          line_map, text_base, &statuses);
   AppendLintRuleStatuses(token_stream_linter_.ReportStatus(), waivers, line_map,
                          text_base, &statuses);
-  AppendLintRuleStatuses(syntax_tree_linter_.ReportStatus(), waivers, line_map,
-                         text_base, &statuses);
+  AppendLintRuleStatuses(SyntaxTreeLintStatus(), waivers, line_map, text_base,
+                         &statuses);
   return statuses;
 }
 
+// Returns the versions of the directories that an upward search from
+// 'search_start' for 'config_file' looks in: from 'search_start' up to the
+// directory of 'config_file', or up to the root if 'config_file' is empty.
+// Adding or removing a file in a directory changes its version.
+static std::vector<verible::file::FileVersion> SearchedDirectoryVersions(
+    absl::string_view search_start, absl::string_view config_file) {
+  const absl::string_view found_dir =
+      config_file.empty() ? absl::string_view()
+                          : verible::file::Dirname(config_file);
+  std::vector<verible::file::FileVersion> versions;
+  absl::string_view dir = search_start;
+  for (;;) {
+    const auto version = verible::file::GetFileVersion(dir);
+    versions.push_back(version.ok() ? *version : verible::file::FileVersion());
+    if (dir == found_dir || dir == "/") break;
+    dir = verible::file::Dirname(dir);
+    if (dir.empty()) dir = "/";
+  }
+  return versions;
+}
+
+// Returns the rules configuration file that applies to 'linting_start_file'
+// by searching upward, or an empty string if there is none.
+// Search results are cached per directory, and are re-validated with the
+// versions of the searched directories, so that configuration files that are
+// added or removed later are noticed.  Results are not cached while any of
+// these directories was changed recently.
+static std::string SearchRulesConfig(absl::string_view linting_start_file) {
+  if (linting_start_file.empty()) return "";
+  char absolute_path[PATH_MAX];
+  std::string search_start;
+  if (realpath(std::string(linting_start_file).c_str(), absolute_path) !=
+      nullptr) {
+    // All files in the same directory share the search result.
+    search_start = absolute_path;
+    if (verible::file::FileExists(search_start).ok()) {
+      search_start = std::string(verible::file::Dirname(search_start));
+      if (search_start.empty()) search_start = "/";
+    }
+  } else {
+    // The file need not exist, e.g. an unsaved buffer linted by
+    // verible-verilog-server, so search from its directory.
+    absl::string_view directory = verible::file::Dirname(linting_start_file);
+    if (directory == linting_start_file) directory = ".";  // No directory.
+    if (directory.empty()) directory = "/";
+    if (realpath(std::string(directory).c_str(), absolute_path) == nullptr) {
+      return "";
+    }
+    search_start = absolute_path;
+  }
+
+  struct SearchResult {
+    std::string config_file;
+    std::vector<verible::file::FileVersion> directory_versions;
+  };
+  static absl::Mutex lock(absl::kConstInit);
+  static auto* found_configs = new std::map<std::string, SearchResult>;
+  SearchResult cached;
+  bool is_cached = false;
+  {
+    absl::MutexLock l(&lock);
+    const auto found = found_configs->find(search_start);
+    if (found != found_configs->end()) {
+      cached = found->second;
+      is_cached = true;
+    }
+  }
+  if (is_cached &&
+      cached.directory_versions ==
+          SearchedDirectoryVersions(search_start, cached.config_file)) {
+    return cached.config_file;
+  }
+  std::string resolved_config_file;
+  if (!verible::file::UpwardFileSearch(search_start, kDefaultRulesConfig,
+                                       &resolved_config_file)
+           .ok()) {
+    resolved_config_file.clear();
+  }
+  SearchResult result = {
+      resolved_config_file,
+      SearchedDirectoryVersions(search_start, resolved_config_file)};
+  const absl::Time now = absl::Now();
+  for (const auto& version : result.directory_versions) {
+    if (version.IsRecent(now)) return resolved_config_file;
+  }
+  absl::MutexLock l(&lock);
+  (*found_configs)[search_start] = std::move(result);
+  return resolved_config_file;
+}
+
 LinterConfiguration LinterConfigurationFromFlags(
     absl::string_view linting_start_file) {
-  LinterConfiguration config;
-
-  const verilog::LinterOptions options = {
-      .ruleset = absl::GetFlag(FLAGS_ruleset),
-      .rules = absl::GetFlag(FLAGS_rules),
-      .config_file = absl::GetFlag(FLAGS_rules_config),
-      .config_file_is_custom =
-          absl::GetFlag(FLAGS_rules_config) != kDefaultRulesConfig,
-      .rules_config_search = absl::GetFlag(FLAGS_rules_config_search),
-      .linting_start_file = std::string(linting_start_file),
-      .waiver_files = absl::GetFlag(FLAGS_waiver_files)};
-
-  absl::Status config_status = config.ConfigureFromOptions(options);
-  if (!config_status.ok()) {
-    LOG(WARNING) << "Unable to configure linter for: " << linting_start_file;
+  const verilog::RuleSet ruleset = absl::GetFlag(FLAGS_ruleset);
+  const verilog::RuleBundle rules = absl::GetFlag(FLAGS_rules);
+  const std::string rules_config = absl::GetFlag(FLAGS_rules_config);
+  const std::string waiver_files = absl::GetFlag(FLAGS_waiver_files);
+
+  // Resolve the configuration file that applies to this file, if any.
+  std::string config_file;
+  if (rules_config != kDefaultRulesConfig) {
+    config_file = rules_config;
+  } else if (absl::GetFlag(FLAGS_rules_config_search)) {
+    config_file = SearchRulesConfig(linting_start_file);
   }
 
-  return config;
+  // Configurations are shared among all files that resolve to the same
+  // configuration file, and only rebuilt when that file changes.
+  // Flag values are part of the key, in case they change between calls.
+  struct ConfigurationResult {
+    LinterConfiguration config;
+    absl::Status status;
+  };
+  static auto* cache = new FileDerivedCache<ConfigurationResult>;
+  const std::string key =
+      absl::StrCat(AbslUnparseFlag(ruleset), "\n", AbslUnparseFlag(rules),
+                   "\n", waiver_files, "\n", config_file);
+  const auto config = cache->Get(key, config_file, [&]() {
+    const verilog::LinterOptions options = {
+        .ruleset = ruleset,
+        .rules = rules,
+        .config_file = config_file,
+        .config_file_is_custom = !config_file.empty(),
+        .rules_config_search = false,  // already resolved
+        .linting_start_file = std::string(linting_start_file),
+        .waiver_files = waiver_files};
+
+    auto new_config = std::make_shared<ConfigurationResult>();
+    new_config->status = new_config->config.ConfigureFromOptions(options);
+    return new_config;
+  });
+
+  if (!config->status.ok()) {
+    LOG(WARNING) << "Unable to configure linter for: " << linting_start_file;
+  }
+  return config->config;
 }
 
 absl::Status VerilogLintTextStructure(std::ostream* stream,
                                       const std::string& filename,
-                                      const std::string& contents,
+                                      absl::string_view contents,
                                       const LinterConfiguration& config,
                                       const TextStructureView& text_structure) {
   // Create the linter, add rules, and run it.
-  VerilogLinter linter;
+  VerilogLinter linter(absl::GetFlag(FLAGS_lint_threads));
   const absl::Status configuration_status = linter.Configure(config, filename);
   if (!configuration_status.ok()) {
     return configuration_status;
@@ -15,22 +15,31 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_VERILOG_LINTER_H_
 #define VERIBLE_VERILOG_ANALYSIS_VERILOG_LINTER_H_
 
+#include <functional>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "common/analysis/line_linter.h"
+#include "common/analysis/lint_result_cache.h"
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/lint_waiver.h"
+#include "common/analysis/syntax_tree_index.h"
+#include "common/analysis/syntax_tree_lint_rule.h"
 #include "common/analysis/syntax_tree_linter.h"
 #include "common/analysis/text_structure_linter.h"
 #include "common/analysis/token_stream_linter.h"
 #include "common/strings/line_column_map.h"
+#include "common/strings/mem_block.h"
+#include "common/text/symbol.h"
 #include "common/text/text_structure.h"
+#include "common/util/thread_pool.h"
 #include "verilog/analysis/lint_rule_registry.h"
 #include "verilog/analysis/verilog_linter_configuration.h"
+#include "verilog/preprocessor/verilog_preprocess.h"
 
 namespace verilog {
 
@@ -43,17 +52,40 @@ namespace verilog {
 // If 'parse_fatal' is true, abort after encountering syntax errors, else
 // continue to analyze the salvaged code structure.
 // If 'lint_fatal' is true, exit nonzero on finding lint violations.
+// If 'cache' is not null, diagnostics of files that were linted before with
+// the same configuration and options are replayed from it, and new results
+// are stored in it.
+// 'preprocess_config' selects the conditional branches that are analyzed;
+// by default, all of them are.
 // Returns an exit_code like status where 0 means success, 1 means some
 // errors were found (syntax, lint), and anything else is a fatal error.
 int LintOneFile(std::ostream* stream, absl::string_view filename,
                 const LinterConfiguration& config, bool check_syntax,
-                bool parse_fatal, bool lint_fatal);
+                bool parse_fatal, bool lint_fatal,
+                const verible::LintResultCache* cache = nullptr,
+                const VerilogPreprocessConfig& preprocess_config =
+                    VerilogPreprocessConfig());
+
+// Like LintOneFile(), but lints 'content' that was already read, such as an
+// unsaved editor buffer, as if it were the content of 'filename'.
+int LintOneFileContent(std::ostream* stream, absl::string_view filename,
+                       std::shared_ptr<verible::MemBlock> content,
+                       const LinterConfiguration& config, bool check_syntax,
+                       bool parse_fatal, bool lint_fatal,
+                       const verible::LintResultCache* cache = nullptr,
+                       const VerilogPreprocessConfig& preprocess_config =
+                           VerilogPreprocessConfig());
 
 // VerilogLinter analyzes a TextStructureView of Verilog source code.
 // This uses syntax-tree based analyses and lexical token-stream analyses.
 class VerilogLinter {
  public:
-  VerilogLinter();
+  // With 'num_threads' greater than 1, Lint() runs the text structure, line,
+  // token stream and syntax tree analyses concurrently, and splits the syntax
+  // tree analysis of files with many top-level descriptions among separate
+  // instances of the subtree-local rules.  Findings do not depend on the
+  // number of threads.
+  explicit VerilogLinter(int num_threads = 1);
 
   // Configures the internal linters, enabling select rules.
   absl::Status Configure(const LinterConfiguration& configuration,
@@ -68,6 +100,20 @@ class VerilogLinter {
       const verible::LineColumnMap&, absl::string_view text_base);
 
  private:
+  // Schedules the analysis of the syntax tree rooted at 'root' on 'pool'.
+  // 'index' must be an index of 'root'.
+  void ScheduleSyntaxTreeLint(const verible::Symbol& root,
+                              const verible::SyntaxTreeIndex& index,
+                              verible::ThreadPool* pool);
+
+  // Returns the findings of the syntax tree rules in the order in which the
+  // rules were configured, merging the findings of all instances of each
+  // subtree-local rule.
+  std::vector<verible::LintRuleStatus> SyntaxTreeLintStatus() const;
+
+  // Maximum number of concurrent analyses.
+  const int num_threads_;
+
   // Line based linter.
   verible::LineLinter line_linter_;
 
@@ -75,8 +121,23 @@ class VerilogLinter {
   verible::TokenStreamLinter token_stream_linter_;
 
   // Syntax-tree based linter.
+  // With more than one thread, this only holds the rules that are not
+  // subtree-local, and the others are in syntax_tree_shards_.
   verible::SyntaxTreeLinter syntax_tree_linter_;
 
+  // Each shard has its own instance of every subtree-local rule, and analyzes
+  // a consecutive range of the top-level descriptions.  Only used with more
+  // than one thread.
+  std::vector<std::unique_ptr<verible::SyntaxTreeLinter>> syntax_tree_shards_;
+
+  // Creates the subtree-local rules of a new shard.
+  std::function<std::vector<std::unique_ptr<verible::SyntaxTreeLintRule>>()>
+      create_subtree_local_rules_;
+
+  // For each configured syntax tree rule, in order, whether it is in
+  // syntax_tree_shards_ instead of syntax_tree_linter_.
+  std::vector<bool> rule_is_sharded_;
+
   // TextStructure-based linter.
   verible::TextStructureLinter text_structure_linter_;
 
@@ -87,6 +148,9 @@ class VerilogLinter {
 // Creates a linter configuration from global flags.
 // If --rules_config_search is configured, uses the given
 // start file to look up the directory chain.
+// Configurations are cached by the configuration file they are read from
+// (searches are cached per directory), and are only re-read when that file's
+// modification time changes.  Thread-safe.
 LinterConfiguration LinterConfigurationFromFlags(
     absl::string_view linting_start_file = ".");
 
@@ -114,7 +178,7 @@ absl::Status AppendLinterConfigurationFromFile(
 //   absl::Status that reflects whether linter linter ran successfully.
 absl::Status VerilogLintTextStructure(
     std::ostream* stream, const std::string& filename,
-    const std::string& contents, const LinterConfiguration& config,
+    absl::string_view contents, const LinterConfiguration& config,
     const verible::TextStructureView& text_structure);
 
 // Prints the rule, description and default_enabled.
@@ -0,0 +1,91 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures lint throughput on the inputs from verilog_benchmark_sources.h,
+// with every registered rule enabled.  Sources are parsed once, outside of
+// the timed loops.
+
+#include <cstddef>
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "benchmark/benchmark.h"
+#include "common/analysis/syntax_tree_linter.h"
+#include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/analysis/verilog_analyzer.h"
+#include "verilog/analysis/verilog_linter.h"
+#include "verilog/analysis/verilog_linter_configuration.h"
+#include "verilog/benchmark/verilog_benchmark_sources.h"
+
+namespace verilog {
+namespace {
+
+// Returns the analyzed 'source', or nullptr after reporting an error.
+std::unique_ptr<VerilogAnalyzer> AnalyzeOrSkip(benchmark::State& state,
+                                               const BenchmarkSource& source) {
+  auto analyzer = absl::make_unique<VerilogAnalyzer>(source.text, source.name);
+  const auto status = analyzer->Analyze();
+  if (!status.ok()) {
+    state.SkipWithError(status.ToString().c_str());
+    return nullptr;
+  }
+  return analyzer;
+}
+
+// Syntax tree rules only, i.e. SyntaxTreeLinter::Lint().
+void BM_SyntaxTreeLint(benchmark::State& state, const BenchmarkSource& source) {
+  const auto analyzer = AnalyzeOrSkip(state, source);
+  if (analyzer == nullptr) return;
+  const auto& text_structure = analyzer->Data();
+  for (auto _ : state) {
+    verible::SyntaxTreeLinter linter;
+    for (const auto& rule_name : analysis::RegisteredSyntaxTreeRulesNames()) {
+      linter.AddRule(analysis::CreateSyntaxTreeLintRule(rule_name));
+    }
+    linter.Lint(*text_structure.SyntaxTree());
+    benchmark::DoNotOptimize(linter.ReportStatus());
+  }
+  SetThroughputCounters(state, source.text.size(),
+                        text_structure.TokenStream().size());
+}
+
+// All lint engines (line, token stream, syntax tree, text structure),
+// including the reporting of findings.
+void BM_VerilogLint(benchmark::State& state, const BenchmarkSource& source) {
+  const auto analyzer = AnalyzeOrSkip(state, source);
+  if (analyzer == nullptr) return;
+  const auto& text_structure = analyzer->Data();
+  LinterConfiguration config;
+  config.UseRuleSet(RuleSet::kAll);
+  for (auto _ : state) {
+    VerilogLinter linter;
+    const auto status = linter.Configure(config, source.name);
+    if (!status.ok()) {
+      state.SkipWithError(status.ToString().c_str());
+      return;
+    }
+    linter.Lint(text_structure, source.name);
+    benchmark::DoNotOptimize(linter.ReportStatus(
+        text_structure.GetLineColumnMap(), text_structure.Contents()));
+  }
+  SetThroughputCounters(state, source.text.size(),
+                        text_structure.TokenStream().size());
+}
+
+const bool kRegistered =
+    RegisterSourceBenchmarks("BM_SyntaxTreeLint", BM_SyntaxTreeLint) &&
+    RegisterSourceBenchmarks("BM_VerilogLint", BM_VerilogLint);
+
+}  // namespace
+}  // namespace verilog
@@ -283,6 +283,18 @@ bool LinterConfiguration::operator==(const LinterConfiguration& config) const {
   return ActiveRuleIds() == config.ActiveRuleIds();
 }
 
+std::string LinterConfiguration::UnparseConfiguration() const {
+  std::vector<std::string> enabled_rules;
+  for (const auto& rule : configuration_) {
+    if (!rule.second.enabled) continue;
+    enabled_rules.push_back(absl::StrCat(
+        rule.first, rule.second.configuration.empty() ? "" : "=",
+        rule.second.configuration));
+  }
+  return absl::StrCat(absl::StrJoin(enabled_rules, ","),
+                      ";waivers=", external_waivers);
+}
+
 absl::Status LinterConfiguration::AppendFromFile(
     absl::string_view config_filename) {
   // Read local configuration file
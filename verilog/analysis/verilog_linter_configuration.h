@@ -228,6 +228,11 @@ class LinterConfiguration {
 
   bool operator!=(const LinterConfiguration& r) const { return !(*this == r); }
 
+  // Returns a text that identifies the effective configuration: the enabled
+  // rules with their parameters, and the external waiver files.  Unlike
+  // operator==, this tells apart configurations whose rule parameters differ.
+  std::string UnparseConfiguration() const;
+
   // Appends linter rules configuration from a file
   absl::Status AppendFromFile(absl::string_view filename);
 
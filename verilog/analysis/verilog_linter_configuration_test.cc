@@ -361,6 +361,26 @@ TEST(LinterConfigurationTest, ComparisonSameDifferentElement) {
   EXPECT_EQ(config1, config2);
 }
 
+TEST(LinterConfigurationTest, UnparseConfiguration) {
+  LinterConfiguration config;
+  EXPECT_EQ(config.UnparseConfiguration(), ";waivers=");
+  config.TurnOn("rule-abc");
+  config.TurnOff("rule-off");
+  EXPECT_EQ(config.UnparseConfiguration(), "rule-abc;waivers=");
+
+  RuleBundle bundle;
+  bundle.rules["rule-xyz"] = {true, "length:40"};
+  config.UseRuleBundle(bundle);
+  config.external_waivers = "waive.vbl";
+  const std::string unparsed = config.UnparseConfiguration();
+  EXPECT_EQ(unparsed, "rule-abc,rule-xyz=length:40;waivers=waive.vbl");
+
+  // Differs from an otherwise equal configuration with other parameters.
+  bundle.rules["rule-xyz"] = {true, "length:80"};
+  config.UseRuleBundle(bundle);
+  EXPECT_NE(config.UnparseConfiguration(), unparsed);
+}
+
 TEST(LinterConfigurationTest, StreamOperator) {
   LinterConfiguration config;
   {
@@ -20,6 +20,7 @@
 #include "verilog/analysis/verilog_linter.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <iterator>
 #include <memory>
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
@@ -29,16 +30,24 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "common/analysis/lint_rule_status.h"
+#include "common/strings/mem_block.h"
+#include "common/text/text_structure.h"
 #include "common/util/file_util.h"
 #include "common/util/logging.h"
 #include "verilog/analysis/default_rules.h"
 #include "verilog/analysis/verilog_analyzer.h"
 #include "verilog/analysis/verilog_linter_configuration.h"
 
+ABSL_DECLARE_FLAG(bool, rules_config_search);
+
 namespace verilog {
 namespace {
 
@@ -147,6 +156,19 @@ TEST_F(LintOneFileTest, LintError) {
   }
 }
 
+// Tests that content is linted without reading the named file.
+TEST_F(LintOneFileTest, LintContentOfUnsavedFile) {
+  const auto content = std::make_shared<verible::StringMemBlock>(
+      absl::string_view("task automatic foo;\n"
+                        "  $psprintf(\"blah\");\n"  // forbidden function
+                        "endtask\n"));
+  std::ostringstream output;
+  const int exit_code = LintOneFileContent(&output, "unsaved.sv", content,
+                                           config_, true, false, true);
+  EXPECT_EQ(exit_code, 1) << "output:\n" << output.str();
+  EXPECT_THAT(output.str(), StartsWith("unsaved.sv:"));
+}
+
 class VerilogLinterTest : public DefaultLinterConfigTestFixture,
                           public testing::Test {
  public:
@@ -359,6 +381,97 @@ TEST_F(VerilogLinterTest, MultiByteUTF8CharactersAreOnlyCountedOnce) {
   EXPECT_EQ(diagnostics.second, "");
 }
 
+// Returns the formatted findings of linting 'content' with all rules, using
+// 'num_threads' threads.
+static std::string LintWithAllRules(const std::string& content,
+                                    int num_threads) {
+  const auto analyzer = absl::make_unique<VerilogAnalyzer>(content, "all.sv");
+  EXPECT_TRUE(ABSL_DIE_IF_NULL(analyzer)->Analyze().ok());
+  LinterConfiguration config;
+  config.UseRuleSet(RuleSet::kAll);
+  VerilogLinter linter(num_threads);
+  EXPECT_TRUE(linter.Configure(config, "all.sv").ok());
+  const verible::TextStructureView& text_structure = analyzer->Data();
+  linter.Lint(text_structure, "all.sv");
+  const std::vector<verible::LintRuleStatus> statuses = linter.ReportStatus(
+      text_structure.GetLineColumnMap(), text_structure.Contents());
+  std::ostringstream diagnostics;
+  verible::LintStatusFormatter formatter(content);
+  formatter.FormatLintRuleStatuses(&diagnostics, statuses,
+                                   text_structure.Contents(), "all.sv");
+  return diagnostics.str();
+}
+
+TEST(VerilogLinterConcurrencyTest, SameFindingsWithMoreThreads) {
+  std::string content;
+  for (int i = 0; i < 50; ++i) {
+    content += absl::StrCat(
+        "module m", i, "(input logic clk);\n",
+        "  always @* begin\n",
+        "    $psprintf(\"blah\");;\n",
+        "  end\n",
+        "\tlogic [0:", i, "] Bad_Name_", i, ";",
+        (i % 3 == 0
+             ? "  // verilog_lint: waive packed-dimensions-range-ordering"
+             : ""),
+        "\nendmodule\n",
+        "`uvm_info(\"m\", \"msg\", UVM_LOW);\n");
+  }
+  const std::string expected = LintWithAllRules(content, 1);
+  EXPECT_FALSE(expected.empty());
+  for (const int num_threads : {2, 4, 8}) {
+    EXPECT_EQ(LintWithAllRules(content, num_threads), expected)
+        << "with " << num_threads << " threads";
+  }
+}
+
+// Tests that searched rules configurations that are added or removed after an
+// earlier search are noticed.
+TEST(LinterConfigurationFromFlagsTest, SearchNoticesAddedAndRemovedConfig) {
+  const bool saved_search = absl::GetFlag(FLAGS_rules_config_search);
+  absl::SetFlag(&FLAGS_rules_config_search, true);
+  const std::string dir =
+      verible::file::JoinPath(testing::TempDir(), "rules_config_search");
+  ASSERT_TRUE(verible::file::CreateDir(dir).ok());
+  const std::string source = verible::file::JoinPath(dir, "m.sv");
+  ASSERT_TRUE(verible::file::SetContents(source, "").ok());
+  const LinterConfiguration without_config =
+      LinterConfigurationFromFlags(source);
+
+  const std::string rules_config =
+      verible::file::JoinPath(dir, ".rules.verible_lint");
+  ASSERT_TRUE(verible::file::SetContents(rules_config, "-line-length\n").ok());
+  const LinterConfiguration with_config = LinterConfigurationFromFlags(source);
+  EXPECT_FALSE(with_config == without_config);
+
+  ASSERT_EQ(std::remove(rules_config.c_str()), 0);
+  EXPECT_TRUE(LinterConfigurationFromFlags(source) == without_config);
+  absl::SetFlag(&FLAGS_rules_config_search, saved_search);
+}
+
+TEST(LinterConfigurationFromFlagsTest, SearchFromDirectoryOfMissingFile) {
+  const bool saved_search = absl::GetFlag(FLAGS_rules_config_search);
+  absl::SetFlag(&FLAGS_rules_config_search, true);
+  const std::string dir =
+      verible::file::JoinPath(testing::TempDir(), "rules_config_unsaved");
+  ASSERT_TRUE(verible::file::CreateDir(dir).ok());
+  const std::string saved = verible::file::JoinPath(dir, "saved.sv");
+  ASSERT_TRUE(verible::file::SetContents(saved, "").ok());
+  const std::string rules_config =
+      verible::file::JoinPath(dir, ".rules.verible_lint");
+  ASSERT_TRUE(verible::file::SetContents(rules_config, "-line-length\n").ok());
+
+  // A file that was never saved finds the same configuration as its
+  // neighbors.
+  const std::string unsaved = verible::file::JoinPath(dir, "unsaved.sv");
+  const LinterConfiguration with_config = LinterConfigurationFromFlags(unsaved);
+  EXPECT_TRUE(with_config == LinterConfigurationFromFlags(saved));
+
+  absl::SetFlag(&FLAGS_rules_config_search, false);
+  EXPECT_FALSE(with_config == LinterConfigurationFromFlags(unsaved));
+  absl::SetFlag(&FLAGS_rules_config_search, saved_search);
+}
+
 TEST(VerilogLinterDocumentationTest, AllRulesHelpDescriptions) {
   std::ostringstream stream;
   verilog::GetLintRuleDescriptionsHelpFlag(&stream, "all");
@@ -0,0 +1,167 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/benchmark/verilog_benchmark_sources.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "benchmark/benchmark.h"
+#include "common/util/file_util.h"
+#include "common/util/logging.h"
+
+namespace verilog {
+
+std::string GeneratePortListSource(int num_ports) {
+  std::string result("module port_list (\n");
+  for (int i = 0; i < num_ports; ++i) {
+    absl::StrAppend(&result, (i % 2 == 0) ? "  input" : "  output",
+                    " logic [7:0] p", i, (i + 1 < num_ports) ? ",\n" : "\n");
+  }
+  absl::StrAppend(&result, ");\nendmodule\n\nmodule port_list_top;\n");
+  absl::StrAppend(&result, "  port_list u_port_list (\n");
+  for (int i = 0; i < num_ports; ++i) {
+    absl::StrAppend(&result, "    .p", i, "(w", i, ")",
+                    (i + 1 < num_ports) ? ",\n" : "\n");
+  }
+  absl::StrAppend(&result, "  );\nendmodule\n");
+  return result;
+}
+
+std::string GenerateNestedGenerateSource(int depth) {
+  std::string result("module nested_generate #(parameter int N = 2);\n");
+  for (int i = 0; i < depth; ++i) {
+    const std::string indent(2 * (i + 1), ' ');
+    if (i % 2 == 0) {
+      absl::StrAppend(&result, indent, "for (genvar g", i, " = 0; g", i,
+                      " < N; g", i, "++) begin : gen_loop", i, "\n");
+    } else {
+      absl::StrAppend(&result, indent, "if (N > ", i, ") begin : gen_cond",
+                      i, "\n");
+    }
+  }
+  absl::StrAppend(&result, std::string(2 * (depth + 1), ' '),
+                  "logic [N-1:0] leaf;\n");
+  for (int i = depth - 1; i >= 0; --i) {
+    absl::StrAppend(&result, std::string(2 * (i + 1), ' '), "end\n");
+  }
+  absl::StrAppend(&result, "endmodule\n");
+  return result;
+}
+
+std::string GenerateCaseStatementSource(int num_items) {
+  std::string result(
+      "module case_statement (\n"
+      "  input logic [31:0] sel,\n"
+      "  output logic [31:0] out\n"
+      ");\n"
+      "  always_comb begin\n"
+      "    case (sel)\n");
+  for (int i = 0; i < num_items; ++i) {
+    absl::StrAppend(&result, "      32'd", i, ": out = 32'h",
+                    absl::Hex(i * 2654435761u), ";\n");
+  }
+  absl::StrAppend(&result,
+                  "      default: out = '0;\n"
+                  "    endcase\n"
+                  "  end\n"
+                  "endmodule\n");
+  return result;
+}
+
+static bool IsVerilogSourceFile(absl::string_view filename) {
+  for (const char* extension : {".v", ".sv", ".vh", ".svh"}) {
+    if (absl::EndsWith(filename, extension)) return true;
+  }
+  return false;
+}
+
+// Appends 'path' to 'sources' if it is a file, or all Verilog source files
+// found under it if it is a directory.
+static void AppendCorpusSources(absl::string_view path,
+                                std::vector<BenchmarkSource>* sources) {
+  const auto dir = verible::file::ListDir(path);
+  if (dir.ok()) {
+    for (const auto& subdir : dir->directories) {
+      AppendCorpusSources(subdir, sources);
+    }
+    for (const auto& file : dir->files) {
+      if (IsVerilogSourceFile(file)) AppendCorpusSources(file, sources);
+    }
+    return;
+  }
+  BenchmarkSource source{absl::StrCat("corpus:", path), ""};
+  const auto status = verible::file::GetContents(path, &source.text);
+  if (!status.ok()) {
+    LOG(WARNING) << "Skipping corpus file " << path << ": " << status;
+    return;
+  }
+  sources->push_back(std::move(source));
+}
+
+static std::vector<BenchmarkSource> LoadBenchmarkSources() {
+  std::vector<BenchmarkSource> sources;
+  for (int size : {100, 1000, 10000}) {
+    sources.push_back({absl::StrCat("port_list/", size),
+                       GeneratePortListSource(size)});
+  }
+  for (int depth : {8, 32, 128}) {
+    sources.push_back({absl::StrCat("nested_generate/", depth),
+                       GenerateNestedGenerateSource(depth)});
+  }
+  for (int size : {100, 1000, 10000}) {
+    sources.push_back({absl::StrCat("case_statement/", size),
+                       GenerateCaseStatementSource(size)});
+  }
+  const char* corpus = std::getenv("VERIBLE_BENCHMARK_CORPUS");
+  if (corpus != nullptr) {
+    for (absl::string_view path :
+         absl::StrSplit(corpus, ':', absl::SkipEmpty())) {
+      AppendCorpusSources(path, &sources);
+    }
+  }
+  return sources;
+}
+
+const std::vector<BenchmarkSource>& BenchmarkSources() {
+  static const auto* sources =
+      new std::vector<BenchmarkSource>(LoadBenchmarkSources());
+  return *sources;
+}
+
+bool RegisterSourceBenchmarks(absl::string_view name,
+                              const SourceBenchmarkFunction& fn) {
+  for (const auto& source : BenchmarkSources()) {
+    benchmark::RegisterBenchmark(
+        absl::StrCat(name, "/", source.name).c_str(),
+        [fn, &source](benchmark::State& state) { fn(state, source); });
+  }
+  return true;
+}
+
+void SetThroughputCounters(benchmark::State& state, size_t bytes,
+                           size_t tokens) {
+  state.SetBytesProcessed(state.iterations() * bytes);
+  state.counters["tokens"] = benchmark::Counter(
+      tokens, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}  // namespace verilog
@@ -0,0 +1,80 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Inputs shared by the Verilog benchmarks (lexer, parser, formatter, linter).
+//
+// Synthetic sources stress specific scaling dimensions (long port lists,
+// deep generate nesting, long case statements).  In addition, real sources
+// can be benchmarked by listing files or directories in the environment
+// variable VERIBLE_BENCHMARK_CORPUS (colon-separated), for example:
+//
+//   export VERIBLE_BENCHMARK_CORPUS="$PWD/path/to/rtl:$PWD/other/file.sv"
+//   bazel run -c opt //verilog/analysis:verilog_analyzer_benchmark
+//
+// Standard benchmark flags apply, e.g. --benchmark_filter=corpus.
+
+#ifndef VERIBLE_VERILOG_BENCHMARK_VERILOG_BENCHMARK_SOURCES_H_
+#define VERIBLE_VERILOG_BENCHMARK_VERILOG_BENCHMARK_SOURCES_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "benchmark/benchmark.h"
+
+namespace verilog {
+
+struct BenchmarkSource {
+  // Name that appears in the benchmark name, e.g. "port_list/1000".
+  std::string name;
+
+  // Verilog source text.
+  std::string text;
+};
+
+// Returns a module with 'num_ports' ANSI-style port declarations, and an
+// instance of it with as many named port connections.
+std::string GeneratePortListSource(int num_ports);
+
+// Returns a module with generate loops and conditionals nested 'depth' deep.
+std::string GenerateNestedGenerateSource(int depth);
+
+// Returns a module with a case statement of 'num_items' case items.
+std::string GenerateCaseStatementSource(int num_items);
+
+// Returns all synthetic sources at several sizes, followed by any corpus
+// files named by VERIBLE_BENCHMARK_CORPUS.  Sources are loaded only once,
+// and remain valid for the lifetime of the program.
+const std::vector<BenchmarkSource>& BenchmarkSources();
+
+using SourceBenchmarkFunction =
+    std::function<void(benchmark::State&, const BenchmarkSource&)>;
+
+// Registers 'fn' as benchmark "<name>/<source-name>" for every one of the
+// BenchmarkSources().  Call this before benchmark::RunSpecifiedBenchmarks(),
+// e.g. from a static initializer.
+// Returns true, so that it can be used to initialize a static variable.
+bool RegisterSourceBenchmarks(absl::string_view name,
+                              const SourceBenchmarkFunction& fn);
+
+// Reports throughput of processing 'bytes' of text and 'tokens' tokens
+// in each iteration, as bytes/second and tokens/second.
+void SetThroughputCounters(benchmark::State& state, size_t bytes,
+                           size_t tokens);
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_BENCHMARK_VERILOG_BENCHMARK_SOURCES_H_
@@ -0,0 +1,61 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/benchmark/verilog_benchmark_sources.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "verilog/analysis/verilog_analyzer.h"
+
+namespace verilog {
+namespace {
+
+// Synthetic benchmark inputs must be valid code, otherwise the benchmarks
+// would be measuring error recovery.
+void ExpectParses(const std::string& text) {
+  VerilogAnalyzer analyzer(text, "<benchmark>");
+  EXPECT_TRUE(analyzer.Analyze().ok()) << text;
+}
+
+TEST(GeneratePortListSourceTest, Parses) {
+  for (int size : {1, 2, 10}) {
+    ExpectParses(GeneratePortListSource(size));
+  }
+}
+
+TEST(GenerateNestedGenerateSourceTest, Parses) {
+  for (int depth : {0, 1, 2, 7}) {
+    ExpectParses(GenerateNestedGenerateSource(depth));
+  }
+}
+
+TEST(GenerateCaseStatementSourceTest, Parses) {
+  for (int size : {0, 1, 10}) {
+    ExpectParses(GenerateCaseStatementSource(size));
+  }
+}
+
+TEST(BenchmarkSourcesTest, NamesAreUnique) {
+  const auto& sources = BenchmarkSources();
+  ASSERT_FALSE(sources.empty());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    for (size_t j = i + 1; j < sources.size(); ++j) {
+      EXPECT_NE(sources[i].name, sources[j].name);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace verilog
@@ -21,6 +21,7 @@
 #include <map>
 #include <vector>
 
+#include "common/analysis/syntax_tree_search.h"
 #include "common/formatting/align.h"
 #include "common/formatting/format_token.h"
 #include "common/formatting/token_partition_tree.h"
@@ -35,6 +36,7 @@
 #include "common/util/value_saver.h"
 #include "verilog/CST/context_functions.h"
 #include "verilog/CST/declaration.h"
+#include "verilog/CST/verilog_matchers.h"
 #include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/parser/verilog_token_classifications.h"
 #include "verilog/parser/verilog_token_enum.h"
@@ -386,7 +388,9 @@ static bool IsAlignableDeclaration(const SyntaxTreeNode& node) {
     case NodeEnum::kDataDeclaration: {
       const SyntaxTreeNode& instances(GetInstanceListFromDataDeclaration(node));
       if (FindAllRegisterVariables(instances).size() > 1) return false;
-      if (!FindAllGateInstances(instances).empty()) return false;
+      if (verible::FindFirstMatch(instances, NodekGateInstance()) != nullptr) {
+        return false;
+      }
       return true;
     }
     case NodeEnum::kNetDeclaration: {
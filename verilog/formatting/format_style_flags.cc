@@ -0,0 +1,131 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/formatting/format_style_flags.h"
+
+#include "absl/flags/flag.h"
+#include "common/formatting/align.h"
+#include "common/formatting/basic_format_style.h"
+#include "verilog/formatting/format_style.h"
+#include "verilog/formatting/formatter.h"
+
+using verible::AlignmentPolicy;
+using verible::IndentationStyle;
+
+ABSL_FLAG(bool, verify_convergence, true,
+          "If true, and not incrementally formatting with --lines, "
+          "verify that re-formatting the formatted output yields "
+          "no further changes, i.e. formatting is convergent.");
+ABSL_FLAG(int, max_search_states, 100000,
+          "Limits the number of search states explored during "
+          "line wrap optimization.");
+ABSL_FLAG(int, line_wrap_threads, 1,
+          "Number of threads that search line wraps of separate token "
+          "partitions concurrently.  The output does not depend on this.");
+
+// These flags exist in the short term to disable formatting of some regions.
+// Do not expect to be able to use these in the long term, once they find
+// a better home in a configuration struct.
+
+// "indent" means 2 spaces, "wrap" means 4 spaces.
+ABSL_FLAG(IndentationStyle, port_declarations_indentation,
+          IndentationStyle::kWrap, "Indent port declarations: {indent,wrap}");
+ABSL_FLAG(IndentationStyle, formal_parameters_indentation,
+          IndentationStyle::kWrap, "Indent formal parameters: {indent,wrap}");
+ABSL_FLAG(IndentationStyle, named_parameter_indentation,
+          IndentationStyle::kWrap,
+          "Indent named parameter assignments: {indent,wrap}");
+ABSL_FLAG(IndentationStyle, named_port_indentation, IndentationStyle::kWrap,
+          "Indent named port connections: {indent,wrap}");
+
+// For most of the following in this group, kInferUserIntent is a reasonable
+// default behavior because it allows for user-control with minimal invasiveness
+// and burden on the user.
+ABSL_FLAG(AlignmentPolicy, port_declarations_alignment,
+          AlignmentPolicy::kInferUserIntent,
+          "Format port declarations: {align,flush-left,preserve,infer}");
+ABSL_FLAG(AlignmentPolicy, named_parameter_alignment,
+          AlignmentPolicy::kInferUserIntent,
+          "Format named actual parameters: {align,flush-left,preserve,infer}");
+ABSL_FLAG(AlignmentPolicy, named_port_alignment,
+          AlignmentPolicy::kInferUserIntent,
+          "Format named port connections: {align,flush-left,preserve,infer}");
+ABSL_FLAG(
+    AlignmentPolicy, net_variable_alignment,  //
+    AlignmentPolicy::kInferUserIntent,
+    "Format net/variable declarations: {align,flush-left,preserve,infer}");
+ABSL_FLAG(AlignmentPolicy, formal_parameters_alignment,
+          AlignmentPolicy::kInferUserIntent,
+          "Format formal parameters: {align,flush-left,preserve,infer}");
+ABSL_FLAG(AlignmentPolicy, class_member_variables_alignment,
+          AlignmentPolicy::kInferUserIntent,
+          "Format class member variables: {align,flush-left,preserve,infer}");
+ABSL_FLAG(AlignmentPolicy, case_items_alignment,
+          AlignmentPolicy::kInferUserIntent,
+          "Format case items: {align,flush-left,preserve,infer}");
+ABSL_FLAG(AlignmentPolicy, assignment_statement_alignment,
+          AlignmentPolicy::kInferUserIntent,
+          "Format various assignments: {align,flush-left,preserve,infer}");
+
+ABSL_FLAG(bool, try_wrap_long_lines, false,
+          "If true, let the formatter attempt to optimize line wrapping "
+          "decisions where wrapping is needed, else leave them unformatted.  "
+          "This is a short-term measure to reduce risk-of-harm.");
+
+namespace verilog {
+namespace formatter {
+
+FormatStyle FormatStyleFromFlags() {
+  // TODO(fangism): support style configuration from a file.
+  FormatStyle format_style;
+  format_style.try_wrap_long_lines = absl::GetFlag(FLAGS_try_wrap_long_lines);
+
+  // various indentation control
+  format_style.port_declarations_indentation =
+      absl::GetFlag(FLAGS_port_declarations_indentation);
+  format_style.formal_parameters_indentation =
+      absl::GetFlag(FLAGS_formal_parameters_indentation);
+  format_style.named_parameter_indentation =
+      absl::GetFlag(FLAGS_named_parameter_indentation);
+  format_style.named_port_indentation =
+      absl::GetFlag(FLAGS_named_port_indentation);
+
+  // various alignment control
+  format_style.port_declarations_alignment =
+      absl::GetFlag(FLAGS_port_declarations_alignment);
+  format_style.named_parameter_alignment =
+      absl::GetFlag(FLAGS_named_parameter_alignment);
+  format_style.named_port_alignment = absl::GetFlag(FLAGS_named_port_alignment);
+  format_style.module_net_variable_alignment =
+      absl::GetFlag(FLAGS_net_variable_alignment);
+  format_style.formal_parameters_alignment =
+      absl::GetFlag(FLAGS_formal_parameters_alignment);
+  format_style.class_member_variable_alignment =
+      absl::GetFlag(FLAGS_class_member_variables_alignment);
+  format_style.case_items_alignment = absl::GetFlag(FLAGS_case_items_alignment);
+  format_style.assignment_statement_alignment =
+      absl::GetFlag(FLAGS_assignment_statement_alignment);
+  return format_style;
+}
+
+ExecutionControl ExecutionControlFromFlags() {
+  ExecutionControl control;
+  control.max_search_states = absl::GetFlag(FLAGS_max_search_states);
+  control.verify_convergence = absl::GetFlag(FLAGS_verify_convergence);
+  control.num_threads = absl::GetFlag(FLAGS_line_wrap_threads);
+  return control;
+}
+
+}  // namespace formatter
+}  // namespace verilog
@@ -0,0 +1,38 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_VERILOG_FORMATTING_FORMAT_STYLE_FLAGS_H_
+#define VERIBLE_VERILOG_FORMATTING_FORMAT_STYLE_FLAGS_H_
+
+#include "verilog/formatting/format_style.h"
+#include "verilog/formatting/formatter.h"
+
+namespace verilog {
+namespace formatter {
+
+// Returns the formatting style selected by command-line flags, such as
+// --port_declarations_alignment and --try_wrap_long_lines.
+// Shared by all tools that format, so that they produce the same output.
+FormatStyle FormatStyleFromFlags();
+
+// Returns the execution controls selected by command-line flags that affect
+// formatted output, --max_search_states and --verify_convergence, and
+// --line_wrap_threads.
+// Debugging controls are left at their defaults.
+ExecutionControl ExecutionControlFromFlags();
+
+}  // namespace formatter
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_FORMATTING_FORMAT_STYLE_FLAGS_H_
@@ -40,6 +40,7 @@
 #include "common/util/process.h"
 #include "common/util/range.h"
 #include "common/util/spacer.h"
+#include "common/util/thread_pool.h"
 #include "common/util/vector_tree.h"
 #include "verilog/CST/declaration.h"
 #include "verilog/CST/module.h"
@@ -552,21 +553,38 @@ Status Formatter::Format(const ExecutionControl& control) {
       disabled_ranges_, style_);
 
   // For each UnwrappedLine: minimize total penalty of wrap/break decisions.
-  // TODO(fangism): This could be parallelized if results are written
-  // to their own 'slots'.
-  std::vector<const UnwrappedLine*> partially_formatted_lines;
-  formatted_lines_.reserve(unwrapped_lines.size());
-  for (const auto& uwline : unwrapped_lines) {
-    // TODO(fangism): Use different formatting strategies depending on
-    // uwline.PartitionPolicy().
-    if (uwline.PartitionPolicy() == PartitionPolicyEnum::kSuccessfullyAligned) {
+  // Lines are searched independently, each into its own slot, so that they
+  // can be searched concurrently.  The results are then collected in order,
+  // so they do not depend on the number of threads.
+  std::vector<std::vector<verible::FormattedExcerpt>> wrap_solutions(
+      unwrapped_lines.size());
+  {
+    verible::ThreadPool pool(control.num_threads > 1 ? control.num_threads
+                                                     : 0);
+    for (size_t i = 0; i < unwrapped_lines.size(); ++i) {
+      // TODO(fangism): Use different formatting strategies depending on
+      // uwline.PartitionPolicy().
       // For partitions that were successfully aligned, do not search
       // line-wrapping, but instead accept the adjusted padded spacing.
+      if (unwrapped_lines[i].PartitionPolicy() ==
+          PartitionPolicyEnum::kSuccessfullyAligned) {
+        continue;
+      }
+      pool.Schedule([&, i] {
+        wrap_solutions[i] = verible::SearchLineWraps(
+            unwrapped_lines[i], style_, control.max_search_states);
+      });
+    }
+  }  // all searches done here
+
+  std::vector<const UnwrappedLine*> partially_formatted_lines;
+  formatted_lines_.reserve(unwrapped_lines.size());
+  for (size_t i = 0; i < unwrapped_lines.size(); ++i) {
+    const auto& uwline = unwrapped_lines[i];
+    const auto& optimal_solutions = wrap_solutions[i];
+    if (optimal_solutions.empty()) {
       formatted_lines_.emplace_back(uwline);
     } else {
-      // In other case, default to searching for optimal line wrapping.
-      const auto optimal_solutions =
-          verible::SearchLineWraps(uwline, style_, control.max_search_states);
       if (control.show_equally_optimal_wrappings &&
           optimal_solutions.size() > 1) {
         verible::DisplayEquallyOptimalWrappings(control.Stream(), uwline,
@@ -47,6 +47,10 @@ struct ExecutionControl {
   // If this limit is exceeded, error out with a diagnostic message.
   int max_search_states = 10000;
 
+  // Maximum number of threads that search line wraps of separate partitions
+  // concurrently.  The formatted output does not depend on this.
+  int num_threads = 1;
+
   // If true, and not running in incremental format mode with lines specified,
   // format the formatted output one more time to compare and check for
   // convergence: format(format(text)) == format(text).
@@ -0,0 +1,60 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures formatter throughput on the inputs from
+// verilog_benchmark_sources.h.  This covers the whole formatting pipeline:
+// analysis, token annotation, tree unwrapping, tabular alignment
+// and line-wrap search.
+
+#include <sstream>
+
+#include "benchmark/benchmark.h"
+#include "verilog/analysis/verilog_analyzer.h"
+#include "verilog/benchmark/verilog_benchmark_sources.h"
+#include "verilog/formatting/format_style.h"
+#include "verilog/formatting/formatter.h"
+
+namespace verilog {
+namespace formatter {
+namespace {
+
+void BM_FormatVerilog(benchmark::State& state, const BenchmarkSource& source) {
+  const FormatStyle style;
+  ExecutionControl control;
+  // Measure a single pass, not the re-formatting done for verification.
+  control.verify_convergence = false;
+  for (auto _ : state) {
+    std::ostringstream formatted;
+    const auto status =
+        FormatVerilog(source.text, source.name, style, formatted, {}, control);
+    if (!status.ok()) {
+      state.SkipWithError(status.ToString().c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(formatted.str());
+  }
+  // FormatVerilog does not expose its token stream, so count tokens
+  // separately, outside of the timed loop.
+  VerilogAnalyzer analyzer(source.text, source.name);
+  analyzer.Analyze().IgnoreError();
+  SetThroughputCounters(state, source.text.size(),
+                        analyzer.Data().TokenStream().size());
+}
+
+const bool kRegistered =
+    RegisterSourceBenchmarks("BM_FormatVerilog", BM_FormatVerilog);
+
+}  // namespace
+}  // namespace formatter
+}  // namespace verilog
@@ -7104,6 +7104,24 @@ TEST(FormatterEndToEndTest, VerilogFormatTest) {
   }
 }
 
+// Tests that searching line wraps concurrently yields the same results.
+TEST(FormatterEndToEndTest, VerilogFormatMultithreadedTest) {
+  // Use a fixed style.
+  FormatStyle style;
+  style.column_limit = 40;
+  style.indentation_spaces = 2;
+  style.wrap_spaces = 4;
+  ExecutionControl control;
+  control.num_threads = 4;
+  for (const auto& test_case : kFormatterTestCases) {
+    std::ostringstream stream;
+    const auto status = FormatVerilog(test_case.input, "<filename>", style,
+                                      stream, kEnableAllLines, control);
+    EXPECT_OK(status) << status.message();
+    EXPECT_EQ(stream.str(), test_case.expected) << "code:\n" << test_case.input;
+  }
+}
+
 TEST(FormatterEndToEndTest, AutoInferAlignment) {
   static constexpr FormatterTestCase kTestCases[] = {
       {"", ""},
@@ -9306,6 +9324,34 @@ TEST(FormatterEndToEndTest, UnfinishedLineWrapSearching) {
   EXPECT_TRUE(absl::StartsWith(status.message(), "***"));
 }
 
+// Test that unfinished searches are reported the same way by concurrent
+// searches.
+TEST(FormatterEndToEndTest, UnfinishedLineWrapSearchingMultithreaded) {
+  FormatStyle style;
+  style.column_limit = 40;
+  style.indentation_spaces = 2;
+  style.wrap_spaces = 4;
+
+  const absl::string_view code(
+      "parameter int x = 1+1;\n"
+      "parameter int y = 2+2;\n");
+
+  ExecutionControl control;
+  control.max_search_states = 2;  // Cause search to abort early.
+  std::ostringstream serial_stream, serial_debug_stream;
+  control.stream = &serial_debug_stream;
+  const auto serial_status = FormatVerilog(code, "<filename>", style,
+                                           serial_stream, kEnableAllLines,
+                                           control);
+  control.num_threads = 2;
+  std::ostringstream stream, debug_stream;
+  control.stream = &debug_stream;
+  const auto status = FormatVerilog(code, "<filename>", style, stream,
+                                    kEnableAllLines, control);
+  EXPECT_EQ(status.code(), StatusCode::kResourceExhausted);
+  EXPECT_EQ(status.message(), serial_status.message());
+}
+
 // TODO(fangism): directed tests using style variations
 
 }  // namespace
@@ -0,0 +1,42 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures lexer throughput on the inputs from verilog_benchmark_sources.h.
+
+#include <cstddef>
+
+#include "benchmark/benchmark.h"
+#include "verilog/benchmark/verilog_benchmark_sources.h"
+#include "verilog/parser/verilog_lexer.h"
+
+namespace verilog {
+namespace {
+
+void BM_Lex(benchmark::State& state, const BenchmarkSource& source) {
+  size_t num_tokens = 0;
+  for (auto _ : state) {
+    VerilogLexer lexer(source.text);
+    num_tokens = 0;
+    for (lexer.DoNextToken(); !lexer.GetLastToken().isEOF();
+         lexer.DoNextToken()) {
+      ++num_tokens;
+    }
+  }
+  SetThroughputCounters(state, source.text.size(), num_tokens);
+}
+
+const bool kRegistered = RegisterSourceBenchmarks("BM_Lex", BM_Lex);
+
+}  // namespace
+}  // namespace verilog
@@ -626,6 +626,20 @@ void LexicalContext::_UpdateState(const TokenInfo& token) {
   }  // switch (token.token_enum)
 }
 
+int LexicalContext::LexicalTokenEnum(int token_enum) {
+  // Must be kept in sync with all the re-tagging done by this class.
+  switch (token_enum) {
+    case TK_CONSTRAINT_IMPLIES:
+    case TK_LOGICAL_IMPLIES:
+    case TK_TRIGGER:
+      return _TK_RARROW;
+    case SemicolonEndOfAssertionVariableDeclarations:
+      return ';';
+    default:
+      return token_enum;
+  }
+}
+
 int LexicalContext::_InterpretToken(int token_enum) const {
   // Every top-level case of this switch is a token enumeration (_TK_*)
   // that must be transformed into a disambiguated enumeration (TK_*).
@@ -245,6 +245,12 @@ class LexicalContext {
     }
   }
 
+  // Returns the enumeration that the lexer assigned to a token that
+  // TransformVerilogSymbols() may have re-tagged as 'token_enum'.
+  // This undoes the disambiguation, for re-using lexed tokens in a different
+  // context.
+  static int LexicalTokenEnum(int token_enum);
+
  protected:  // Allow direct testing of some methods.
   // Reads a single token, and may alter it depending on internal state.
   void _AdvanceToken(verible::TokenInfo*);
@@ -1202,6 +1202,8 @@ class LexicalContextTest : public ::testing::Test, public LexicalContext {
     EXPECT_EQ(previous_token_->token_enum(), token_enum_after)
         << " (" << verilog_symbol_name(previous_token_->token_enum()) << " vs. "
         << verilog_symbol_name(token_enum_after) << ')';
+    // The transformation can be undone.
+    EXPECT_EQ(LexicalTokenEnum(token_enum_after), token_enum_before);
   }
 
   // Lexes code and initializes token_iter to point to the first token.
@@ -1223,6 +1225,16 @@ class LexicalContextTest : public ::testing::Test, public LexicalContext {
   TokenStreamReferenceView::iterator token_iter_;
 };
 
+// Test that tokens that are never re-tagged keep their enumeration.
+TEST_F(LexicalContextTest, LexicalTokenEnumOfUntransformedTokens) {
+  for (const int token_enum :
+       {int(SymbolIdentifier), int(TK_module), int(';'), int(_TK_RARROW)}) {
+    EXPECT_EQ(LexicalTokenEnum(token_enum), token_enum);
+  }
+  EXPECT_EQ(LexicalTokenEnum(SemicolonEndOfAssertionVariableDeclarations),
+            ';');
+}
+
 // Test that construction and initialization work.
 TEST_F(LexicalContextTest, Initialization) { CheckInitialState(); }
 
@@ -0,0 +1,167 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/preprocessor/verilog_macro_set.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/lexer/token_stream_adapter.h"
+#include "common/strings/fingerprint.h"
+#include "common/strings/line_column_map.h"
+#include "common/strings/range.h"
+#include "common/text/macro_definition.h"
+#include "common/text/token_info.h"
+#include "common/text/token_stream_view.h"
+#include "common/util/container_util.h"
+#include "common/util/status_macros.h"
+#include "verilog/parser/verilog_lexer.h"
+#include "verilog/parser/verilog_token_enum.h"
+#include "verilog/preprocessor/verilog_preprocess.h"
+
+namespace verilog {
+
+using verible::TokenInfo;
+
+// Returns an error about 'token' in 'text', located by line and column.
+static absl::Status ErrorAt(absl::string_view text, const TokenInfo& token,
+                            absl::string_view message) {
+  const verible::LineColumn location =
+      verible::LineColumnMap(text)(token.left(text));
+  return absl::InvalidArgumentError(absl::StrCat(
+      location.line + 1, ":", location.column + 1, ": ", message));
+}
+
+// Lexes and preprocesses 'text' into 'tokens' and 'data'.
+static absl::Status PreprocessText(absl::string_view text,
+                                   const VerilogPreprocessConfig& config,
+                                   verible::TokenSequence* tokens,
+                                   VerilogPreprocessData* data) {
+  VerilogLexer lexer(text);
+  TokenInfo error_token(TokenInfo::EOFToken(text));
+  const auto lex_status = verible::MakeTokenSequence(
+      &lexer, text, tokens,
+      [&error_token](const TokenInfo& token) { error_token = token; });
+  if (!lex_status.ok()) {
+    return ErrorAt(text, error_token,
+                   absl::StrCat("lexical error at \"", error_token.text(),
+                                "\""));
+  }
+
+  verible::TokenStreamView tokens_view;
+  for (auto iter = tokens->cbegin(); iter != tokens->cend(); ++iter) {
+    if (VerilogLexer::KeepSyntaxTreeTokens(*iter)) tokens_view.push_back(iter);
+  }
+  VerilogPreprocess preprocessor(config);
+  *data = preprocessor.ScanStream(tokens_view);
+  if (!data->errors.empty()) {
+    const auto& error = data->errors.front();
+    return ErrorAt(text, error.token_info, error.error_message);
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::shared_ptr<const VerilogMacroSet>> VerilogMacroSet::Build(
+    absl::string_view text, const VerilogPreprocessConfig& config) {
+  verible::TokenSequence tokens;
+  VerilogPreprocessData data;
+  RETURN_IF_ERROR(PreprocessText(text, config, &tokens, &data));
+
+  // A macro is not defined at the end of 'text' if it is `undef'd after its
+  // last definition.  Offsets of the last `undef of each macro:
+  std::map<absl::string_view, int> undef_offsets;
+  const verible::TokenStreamView& stream = data.preprocessed_token_stream;
+  for (size_t i = 0; i + 1 < stream.size(); ++i) {
+    if (stream[i]->token_enum() == PP_undef &&
+        stream[i + 1]->token_enum() == PP_Identifier) {
+      undef_offsets[stream[i + 1]->text()] = stream[i]->left(text);
+    }
+  }
+
+  // The serialized form keeps the original text of each definition, from
+  // `define to the end of the body.  Ordering by name makes it independent
+  // of hashing.
+  std::map<absl::string_view, absl::string_view> directives;
+  for (const auto& entry : data.macro_definitions) {
+    const MacroDefinition& definition(entry.second);
+    const int* undef_offset =
+        verible::container::FindOrNull(undef_offsets, entry.first);
+    if (undef_offset != nullptr &&
+        *undef_offset > definition.Header().left(text)) {
+      continue;
+    }
+    directives.emplace(
+        entry.first,
+        verible::make_string_view_range(
+            definition.Header().text().begin(),
+            definition.DefinitionText().text().end()));
+  }
+  std::string serialized;
+  for (const auto& directive : directives) {
+    absl::StrAppend(&serialized, directive.second, "\n");
+  }
+  return Deserialize(serialized);
+}
+
+absl::StatusOr<std::shared_ptr<const VerilogMacroSet>>
+VerilogMacroSet::Deserialize(absl::string_view serialized) {
+  std::shared_ptr<VerilogMacroSet> macro_set(new VerilogMacroSet);
+  macro_set->text_.assign(serialized.begin(), serialized.end());
+  // All definitions point into the set's own copy of the text.
+  const absl::string_view text(macro_set->text_);
+
+  verible::TokenSequence tokens;
+  VerilogPreprocessData data;
+  RETURN_IF_ERROR(
+      PreprocessText(text, VerilogPreprocessConfig(), &tokens, &data));
+
+  // Reject anything that is not part of a `define directive, which means
+  // that 'serialized' did not come from Serialize().
+  bool in_directive = false;
+  for (const auto& token : data.preprocessed_token_stream) {
+    switch (token->token_enum()) {
+      case PP_define:
+        in_directive = true;
+        break;
+      case PP_define_body:
+        in_directive = false;
+        break;
+      default:
+        if (!in_directive && !token->isEOF()) {
+          return ErrorAt(text, *token,
+                         absl::StrCat("expected only macro definitions, but "
+                                      "got \"",
+                                      token->text(), "\""));
+        }
+    }
+  }
+
+  macro_set->definitions_ = std::move(data.macro_definitions);
+  macro_set->fingerprint_ = verible::FingerprintOf(text);
+  return std::shared_ptr<const VerilogMacroSet>(std::move(macro_set));
+}
+
+const verible::MacroDefinition* VerilogMacroSet::Find(
+    absl::string_view name) const {
+  return verible::container::FindOrNull(definitions_, name);
+}
+
+}  // namespace verilog
@@ -0,0 +1,89 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_VERILOG_PREPROCESSOR_VERILOG_MACRO_SET_H_
+#define VERIBLE_VERILOG_PREPROCESSOR_VERILOG_MACRO_SET_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "common/strings/fingerprint.h"
+#include "common/text/macro_definition.h"
+#include "verilog/preprocessor/verilog_preprocess.h"
+
+namespace verilog {
+
+// VerilogMacroSet is an immutable set of macro definitions, such as those of
+// uvm_macros.svh, that is prepared once, and then shared read-only by the
+// preprocessing of any number of files (see
+// VerilogPreprocessConfig::predefined_macros), possibly concurrently.
+//
+// The set owns the text of its definitions, which is also its serialized
+// form: the `define directives of the macros, ordered by name, one per line,
+// without any other text.  Loading a serialized set only lexes those
+// directives, which is much less work than re-analyzing the headers they
+// came from.
+class VerilogMacroSet {
+ public:
+  using MacroDefinition = verible::MacroDefinition;
+
+  // Collects the macro definitions of 'text', typically the content of one
+  // or more headers, one after another.  Text other than `define directives
+  // is ignored.  With config.filter_branches, only the definitions in active
+  // conditional branches are collected, otherwise those of all branches are.
+  // When a macro is defined more than once, the last definition is kept, and
+  // macros that are `undef'd after their last definition are left out.
+  static absl::StatusOr<std::shared_ptr<const VerilogMacroSet>> Build(
+      absl::string_view text,
+      const VerilogPreprocessConfig& config = VerilogPreprocessConfig());
+
+  // Loads a set from the result of Serialize(), e.g. saved by an earlier run.
+  static absl::StatusOr<std::shared_ptr<const VerilogMacroSet>> Deserialize(
+      absl::string_view serialized);
+
+  VerilogMacroSet(const VerilogMacroSet&) = delete;
+  VerilogMacroSet& operator=(const VerilogMacroSet&) = delete;
+
+  // Returns the serialized form of this set.
+  absl::string_view Serialize() const { return text_; }
+
+  // Returns the definition of the macro 'name', or nullptr if there is none.
+  const MacroDefinition* Find(absl::string_view name) const;
+
+  // Returns the number of macros.
+  size_t size() const { return definitions_.size(); }
+
+  // Identifies the definitions of this set, e.g. for keys of cached results
+  // that depend on them.
+  const verible::Fingerprint& fingerprint() const { return fingerprint_; }
+
+ private:
+  VerilogMacroSet() = default;
+
+  // Owns the text that the definitions refer to.
+  std::string text_;
+
+  // Macro definitions, keyed by name.
+  VerilogPreprocessData::MacroDefinitionRegistry definitions_;
+
+  // Fingerprint of text_.
+  verible::Fingerprint fingerprint_;
+};
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_PREPROCESSOR_VERILOG_MACRO_SET_H_
@@ -0,0 +1,176 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/preprocessor/verilog_macro_set.h"
+
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "common/text/macro_definition.h"
+#include "verilog/preprocessor/verilog_preprocess.h"
+
+namespace verilog {
+namespace {
+
+TEST(VerilogMacroSetTest, BuildEmpty) {
+  const auto macro_set = VerilogMacroSet::Build("module m;\nendmodule\n");
+  ASSERT_TRUE(macro_set.ok()) << macro_set.status();
+  EXPECT_EQ((*macro_set)->size(), 0);
+  EXPECT_EQ((*macro_set)->Serialize(), "");
+  EXPECT_EQ((*macro_set)->Find("FOO"), nullptr);
+}
+
+TEST(VerilogMacroSetTest, BuildCollectsDefinitions) {
+  const auto macro_set = VerilogMacroSet::Build(
+      "// header\n"
+      "`ifndef HEADER_SVH\n"
+      "`define HEADER_SVH\n"
+      "`define ZZZ(a, b=2) (a+b)\n"
+      "module m;\nendmodule\n"
+      "`define AAA 1\n"
+      "`define AAA \\\n"
+      "  3\n"
+      "`endif\n");
+  ASSERT_TRUE(macro_set.ok()) << macro_set.status();
+  EXPECT_EQ((*macro_set)->size(), 3);
+  // Definitions are ordered by name, and the last definition of AAA wins.
+  EXPECT_EQ((*macro_set)->Serialize(),
+            "`define AAA \\\n"
+            "  3\n"
+            "`define HEADER_SVH\n"
+            "`define ZZZ(a, b=2) (a+b)\n");
+
+  const auto* header = (*macro_set)->Find("HEADER_SVH");
+  ASSERT_NE(header, nullptr);
+  EXPECT_FALSE(header->IsCallable());
+  EXPECT_EQ(header->DefinitionText().text(), "");
+
+  const auto* zzz = (*macro_set)->Find("ZZZ");
+  ASSERT_NE(zzz, nullptr);
+  EXPECT_TRUE(zzz->IsCallable());
+  ASSERT_EQ(zzz->Parameters().size(), 2);
+  EXPECT_EQ(zzz->Parameters()[1].default_value.text(), "2");
+  EXPECT_EQ(zzz->DefinitionText().text(), "(a+b)");
+
+  // Definitions refer to the set's own text.
+  const absl::string_view serialized((*macro_set)->Serialize());
+  EXPECT_GE(zzz->Name().begin(), serialized.begin());
+  EXPECT_LE(zzz->Name().end(), serialized.end());
+}
+
+TEST(VerilogMacroSetTest, BuildFiltersBranches) {
+  VerilogPreprocessConfig config;
+  config.filter_branches = true;
+  config.defines = {"USE_A"};
+  const auto macro_set = VerilogMacroSet::Build(
+      "`ifdef USE_A\n"
+      "`define A 1\n"
+      "`else\n"
+      "`define B 1\n"
+      "`endif\n",
+      config);
+  ASSERT_TRUE(macro_set.ok()) << macro_set.status();
+  EXPECT_EQ((*macro_set)->Serialize(), "`define A 1\n");
+  EXPECT_NE((*macro_set)->Find("A"), nullptr);
+  EXPECT_EQ((*macro_set)->Find("B"), nullptr);
+}
+
+TEST(VerilogMacroSetTest, BuildDropsUndefinedMacros) {
+  const absl::string_view kText =
+      "`define A 1\n"
+      "`undef A\n"
+      "`undef B\n"
+      "`define B 2\n"
+      "`define C 3\n"
+      "`undef C\n"
+      "`define C 4\n";
+  for (const bool filter_branches : {false, true}) {
+    VerilogPreprocessConfig config;
+    config.filter_branches = filter_branches;
+    const auto macro_set = VerilogMacroSet::Build(kText, config);
+    ASSERT_TRUE(macro_set.ok()) << macro_set.status();
+    EXPECT_EQ((*macro_set)->Serialize(),
+              "`define B 2\n"
+              "`define C 4\n")
+        << "filter_branches: " << filter_branches;
+  }
+}
+
+TEST(VerilogMacroSetTest, BuildRejectsInvalidDefinitions) {
+  const auto macro_set = VerilogMacroSet::Build("\n`define 789\n");
+  ASSERT_FALSE(macro_set.ok());
+  EXPECT_EQ(macro_set.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(macro_set.status().message().substr(0, 5), "2:9: ");
+}
+
+TEST(VerilogMacroSetTest, BuildDoesNotDependOnOrder) {
+  const auto forward = VerilogMacroSet::Build(
+      "`define A 1\n"
+      "`define B(x) x\n");
+  const auto backward = VerilogMacroSet::Build(
+      "`define B(x) x\n"
+      "`define A 1\n");
+  ASSERT_TRUE(forward.ok());
+  ASSERT_TRUE(backward.ok());
+  EXPECT_EQ((*forward)->Serialize(), (*backward)->Serialize());
+  EXPECT_EQ((*forward)->fingerprint(), (*backward)->fingerprint());
+}
+
+TEST(VerilogMacroSetTest, DeserializeRoundTrip) {
+  const auto built = VerilogMacroSet::Build(
+      "`define A 1\n"
+      "`define B(x, y=\"y\") {x, y}\n"
+      "`define C\n");
+  ASSERT_TRUE(built.ok()) << built.status();
+  const auto loaded = VerilogMacroSet::Deserialize((*built)->Serialize());
+  ASSERT_TRUE(loaded.ok()) << loaded.status();
+  EXPECT_EQ((*loaded)->Serialize(), (*built)->Serialize());
+  EXPECT_EQ((*loaded)->fingerprint(), (*built)->fingerprint());
+  ASSERT_EQ((*loaded)->size(), (*built)->size());
+  for (absl::string_view name : {"A", "B", "C"}) {
+    const auto* expected = (*built)->Find(name);
+    const auto* actual = (*loaded)->Find(name);
+    ASSERT_NE(expected, nullptr) << name;
+    ASSERT_NE(actual, nullptr) << name;
+    EXPECT_EQ(actual->IsCallable(), expected->IsCallable()) << name;
+    EXPECT_EQ(actual->Parameters().size(), expected->Parameters().size())
+        << name;
+    EXPECT_EQ(actual->DefinitionText().text(),
+              expected->DefinitionText().text())
+        << name;
+  }
+}
+
+TEST(VerilogMacroSetTest, DeserializeRejectsOtherText) {
+  const char* test_cases[] = {
+      "module m;\nendmodule\n",
+      "`define A 1\nwire w;\n",
+      "`ifdef A\n`define B\n`endif\n",
+  };
+  for (const auto* test_case : test_cases) {
+    const auto macro_set = VerilogMacroSet::Deserialize(test_case);
+    EXPECT_FALSE(macro_set.ok()) << test_case;
+  }
+}
+
+TEST(VerilogMacroSetTest, DifferentDefinitionsDifferentFingerprints) {
+  const auto a = VerilogMacroSet::Build("`define A 1\n");
+  const auto b = VerilogMacroSet::Build("`define A 2\n");
+  ASSERT_TRUE(a.ok());
+  ASSERT_TRUE(b.ok());
+  EXPECT_NE((*a)->fingerprint(), (*b)->fingerprint());
+}
+
+}  // namespace
+}  // namespace verilog
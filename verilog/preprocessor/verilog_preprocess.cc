@@ -17,6 +17,7 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -33,12 +34,14 @@
 #include "common/util/logging.h"
 #include "verilog/parser/verilog_parser.h"  // for verilog_symbol_name()
 #include "verilog/parser/verilog_token_enum.h"
+#include "verilog/preprocessor/verilog_macro_set.h"
 
 namespace verilog {
 
 using verible::TokenGenerator;
 using verible::TokenInfo;
 using verible::TokenStreamView;
+using verible::container::FindOrNull;
 using verible::container::InsertOrUpdate;
 
 // Copies `define token iterators into a temporary buffer.
@@ -175,11 +178,49 @@ std::unique_ptr<VerilogPreprocessError> VerilogPreprocess::ParseMacroDefinition(
   return nullptr;
 }
 
+VerilogPreprocess::VerilogPreprocess(const VerilogPreprocessConfig& config)
+    : config_(config), preprocess_data_() {
+  for (const auto& name : config_.defines) defined_macros_[name] = true;
+  preprocess_data_.predefined_macros = config_.predefined_macros;
+}
+
+const verible::MacroDefinition* VerilogPreprocessData::FindMacroDefinition(
+    absl::string_view name) const {
+  const auto* definition = FindOrNull(macro_definitions, name);
+  if (definition == nullptr && predefined_macros != nullptr) {
+    definition = predefined_macros->Find(name);
+  }
+  return definition;
+}
+
+bool VerilogPreprocess::IsDefined(absl::string_view name) const {
+  const auto found = defined_macros_.find(name);
+  if (found != defined_macros_.end()) return found->second;
+  return config_.predefined_macros != nullptr &&
+         config_.predefined_macros->Find(name) != nullptr;
+}
+
 // Interprets preprocessor tokens as directives that act on this preprocessor
 // object and possibly transform the input token stream.
 absl::Status VerilogPreprocess::HandleTokenIterator(
     const TokenStreamView::const_iterator iter,
     const StreamIteratorGenerator& generator) {
+  if (config_.filter_branches) {
+    switch ((*iter)->token_enum()) {
+      case PP_ifdef:
+      case PP_ifndef:
+      case PP_elsif:
+      case PP_else:
+      case PP_endif:
+        return HandleConditional(iter, generator);
+      default:
+        break;
+    }
+    // Drop everything in inactive branches, including macro definitions.
+    // EOF is always kept.
+    if (!IsActive() && !(*iter)->isEOF()) return absl::OkStatus();
+    if ((*iter)->token_enum() == PP_undef) return HandleUndef(iter, generator);
+  }
   // For now, pass through all macro definition tokens to next consumer
   // (parser).
   switch ((*iter)->token_enum()) {
@@ -231,12 +272,87 @@ absl::Status VerilogPreprocess::HandleDefine(
   }
   // For now, forward all definition tokens.
   RegisterMacroDefinition(macro_definition);
+  defined_macros_[macro_name->text()] = true;
   for (const auto& token : define_tokens) {
     preprocess_data_.preprocessed_token_stream.push_back(token);
   }
   return absl::OkStatus();
 }
 
+// Responds to `undef directives, when filtering branches.  The directive is
+// forwarded like `define.
+absl::Status VerilogPreprocess::HandleUndef(
+    const TokenStreamView::const_iterator iter,  // points to `undef token
+    const StreamIteratorGenerator& generator) {
+  preprocess_data_.preprocessed_token_stream.push_back(*iter);
+  const auto name_iter = generator();
+  if ((*name_iter)->token_enum() != PP_Identifier) {
+    preprocess_data_.errors.emplace_back(
+        **name_iter, "expected identifier for macro name after `undef");
+    return absl::InvalidArgumentError("Error parsing `undef.");
+  }
+  preprocess_data_.preprocessed_token_stream.push_back(*name_iter);
+  defined_macros_[(*name_iter)->text()] = false;
+  return absl::OkStatus();
+}
+
+// Evaluates `ifdef, `ifndef, `elsif, `else and `endif, when filtering
+// branches.  These directives are not forwarded.
+absl::Status VerilogPreprocess::HandleConditional(
+    const TokenStreamView::const_iterator iter,  // points to the directive
+    const StreamIteratorGenerator& generator) {
+  const TokenInfo& directive = **iter;
+  const int directive_enum = directive.token_enum();
+  const auto error = [&](const TokenInfo& token, absl::string_view message) {
+    preprocess_data_.errors.emplace_back(token, std::string(message));
+    return absl::InvalidArgumentError("Error in conditional directive.");
+  };
+
+  // Condition of `ifdef, `ifndef and `elsif.
+  bool condition = false;
+  if (directive_enum != PP_else && directive_enum != PP_endif) {
+    const auto name_iter = generator();
+    if ((*name_iter)->token_enum() != PP_Identifier) {
+      return error(**name_iter,
+                   absl::StrCat("expected identifier for macro name after ",
+                                directive.text()));
+    }
+    condition = IsDefined((*name_iter)->text());
+    if (directive_enum == PP_ifndef) condition = !condition;
+  }
+
+  if (directive_enum == PP_ifdef || directive_enum == PP_ifndef) {
+    const bool enclosing_active = IsActive();
+    const bool active = enclosing_active && condition;
+    conditional_blocks_.push_back(
+        ConditionalBlock{directive, enclosing_active, active, active, false});
+    return absl::OkStatus();
+  }
+
+  if (conditional_blocks_.empty()) {
+    return error(directive, absl::StrCat(directive.text(),
+                                         " without matching `ifdef/`ifndef"));
+  }
+  ConditionalBlock& block = conditional_blocks_.back();
+  switch (directive_enum) {
+    case PP_elsif:
+      if (block.in_else) return error(directive, "`elsif after `else");
+      block.active = block.enclosing_active && !block.branch_taken && condition;
+      block.branch_taken |= block.active;
+      break;
+    case PP_else:
+      if (block.in_else) return error(directive, "duplicate `else");
+      block.active = block.enclosing_active && !block.branch_taken;
+      block.branch_taken = true;
+      block.in_else = true;
+      break;
+    default:  // PP_endif
+      conditional_blocks_.pop_back();
+      break;
+  }
+  return absl::OkStatus();
+}
+
 VerilogPreprocessData VerilogPreprocess::ScanStream(
     const TokenStreamView& token_stream) {
   preprocess_data_.preprocessed_token_stream.reserve(token_stream.size());
@@ -252,6 +368,11 @@ VerilogPreprocessData VerilogPreprocess::ScanStream(
     }
     iter = iter_generator();
   }
+  if (preprocess_data_.errors.empty() && !conditional_blocks_.empty()) {
+    preprocess_data_.errors.emplace_back(
+        conditional_blocks_.back().opening_directive,
+        "missing `endif of conditional block");
+  }
   return std::move(preprocess_data_);
 }
 
@@ -20,13 +20,13 @@
 // For example, it may expand a macro call if its definition happens to be
 // available, but it is not required to do so.
 // The pseudo-preprocessor is free to evaluate any/all/no conditional
-// branches.
+// branches.  By default, it keeps all of them; when configured to filter
+// branches, it keeps only the active ones, given a set of defined macros.
 // Each analysis tool may configure the pseudo-preprocessor differently.
 
 // TODO(fangism): expand macros if locally defined, and feed un-lexed
 //   body text to lexer.  This approach works if the definition text
 //   does not depend on the start-condition state at the macro call site.
-// TODO(fangism): implement conditional evaluation policy (`ifdef, `else, ...)
 // TODO(fangism): token concatenation, e.g. a``b
 //   This will produce tokens that are not in the original source text.
 // TODO(fangism): token string-ification (turning symbol names into strings)
@@ -36,11 +36,12 @@
 #define VERIBLE_VERILOG_PREPROCESSOR_VERILOG_PREPROCESS_H_
 
 #include <functional>
-#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "common/text/macro_definition.h"
@@ -49,7 +50,25 @@
 
 namespace verilog {
 
-// TODO(fangism): configuration policy enums.
+class VerilogMacroSet;  // defined in verilog_macro_set.h
+
+// VerilogPreprocessConfig selects the transformations done by
+// VerilogPreprocess.
+struct VerilogPreprocessConfig {
+  // If true, evaluate the conditional directives (`ifdef, `ifndef, `elsif,
+  // `else, `endif) and keep only the tokens of the active branches, without
+  // the conditional directives themselves.  Otherwise, keep all tokens.
+  bool filter_branches = false;
+
+  // Names of the macros that are defined before the start of the text, like
+  // +define+NAME on a simulator command line.  Only used to filter branches.
+  std::set<std::string> defines;
+
+  // Macros that are defined before the start of the text, with their
+  // definitions, e.g. those of commonly included headers.  The set is shared,
+  // not copied, so preprocessing a file costs the same with and without it.
+  std::shared_ptr<const VerilogMacroSet> predefined_macros;
+};
 
 // VerilogPreprocessError contains preprocessor error information.
 struct VerilogPreprocessError {
@@ -64,16 +83,24 @@ struct VerilogPreprocessError {
 // Information that results from preprocessing.
 struct VerilogPreprocessData {
   using MacroDefinition = verible::MacroDefinition;
-  using MacroDefinitionRegistry = std::map<absl::string_view, MacroDefinition>;
+  using MacroDefinitionRegistry =
+      absl::flat_hash_map<absl::string_view, MacroDefinition>;
 
   // Resulting token stream after preprocessing
   verible::TokenStreamView preprocessed_token_stream;
 
-  // Map of defined macros.
+  // Map of the macros defined in the text.
   MacroDefinitionRegistry macro_definitions;
 
+  // Macros defined before the text, from VerilogPreprocessConfig.
+  std::shared_ptr<const VerilogMacroSet> predefined_macros;
+
   // Sequence of tokens rejected by preprocessing.
   std::vector<VerilogPreprocessError> errors;
+
+  // Returns the definition of the macro 'name' in the text, or else in
+  // predefined_macros, or nullptr if there is none.
+  const MacroDefinition* FindMacroDefinition(absl::string_view name) const;
 };
 
 // VerilogPreprocess transforms a TokenStreamView.
@@ -86,6 +113,8 @@ class VerilogPreprocess {
  public:
   VerilogPreprocess() : preprocess_data_() {}
 
+  explicit VerilogPreprocess(const VerilogPreprocessConfig& config);
+
   // ScanStream reads in a stream of tokens returns the result as a move
   // of preprocessor_data_.  preprocessor_data_ should not be accessed
   // after this returns.
@@ -104,6 +133,20 @@ class VerilogPreprocess {
   absl::Status HandleDefine(const TokenStreamView::const_iterator,
                             const StreamIteratorGenerator&);
 
+  absl::Status HandleUndef(const TokenStreamView::const_iterator,
+                           const StreamIteratorGenerator&);
+
+  absl::Status HandleConditional(const TokenStreamView::const_iterator,
+                                 const StreamIteratorGenerator&);
+
+  // Returns true if the macro 'name' is defined at the current position.
+  bool IsDefined(absl::string_view name) const;
+
+  // Returns true if tokens at the current position are kept.
+  bool IsActive() const {
+    return conditional_blocks_.empty() || conditional_blocks_.back().active;
+  }
+
   // The following functions return nullptr when there is no error:
   static std::unique_ptr<VerilogPreprocessError> ConsumeMacroDefinition(
       const StreamIteratorGenerator&, TokenStreamView*);
@@ -116,6 +159,36 @@ class VerilogPreprocess {
 
   void RegisterMacroDefinition(const MacroDefinition&);
 
+  // Selected transformations.
+  const VerilogPreprocessConfig config_;
+
+  // State of an `ifdef or `ifndef block, up to its `endif.
+  struct ConditionalBlock {
+    // The directive that opened the block, for diagnostics.
+    verible::TokenInfo opening_directive;
+
+    // True if the text around the block is active.
+    bool enclosing_active;
+
+    // True if one of the branches seen so far is active.
+    bool branch_taken;
+
+    // True if the current branch is active.
+    bool active;
+
+    // True after the `else branch has started.
+    bool in_else;
+  };
+
+  // Nested conditional blocks around the current position, innermost last.
+  // Only used to filter branches.
+  std::vector<ConditionalBlock> conditional_blocks_;
+
+  // Whether each macro that was named by config_.defines, `define or `undef
+  // is defined at the current position.  Other macros are defined if they
+  // are in config_.predefined_macros.  Only used to filter branches.
+  absl::flat_hash_map<absl::string_view, bool> defined_macros_;
+
   // Results of preprocessing
   VerilogPreprocessData preprocess_data_;
 };
@@ -15,21 +15,27 @@
 #include "verilog/preprocessor/verilog_preprocess.h"
 
 #include <map>
+#include <set>
+#include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
 #include "common/text/macro_definition.h"
 #include "common/text/token_info.h"
 #include "common/util/container_util.h"
 #include "verilog/analysis/verilog_analyzer.h"
+#include "verilog/parser/verilog_token_enum.h"
+#include "verilog/preprocessor/verilog_macro_set.h"
 
 namespace verilog {
 namespace {
 
 using testing::ElementsAre;
 using testing::Pair;
+using testing::UnorderedElementsAre;
 using verible::container::FindOrNull;
 
 class PreprocessorTester {
@@ -39,6 +45,12 @@ class PreprocessorTester {
     status_ = analyzer_.Analyze();
   }
 
+  PreprocessorTester(const char* text, const VerilogPreprocessConfig& config)
+      : analyzer_(text, "<<inline-file>>"), status_() {
+    analyzer_.SetPreprocessConfig(config);
+    status_ = analyzer_.Analyze();
+  }
+
   const VerilogPreprocessData& PreprocessorData() const {
     return analyzer_.PreprocessorData();
   }
@@ -206,8 +218,8 @@ TEST(VerilogPreprocessTest, TwoMacroDefinitions) {
   EXPECT_TRUE(tester.Status().ok()) << "Unexpected analyzer failure.";
   EXPECT_TRUE(tester.PreprocessorData().errors.empty());
   EXPECT_TRUE(tester.Analyzer().GetRejectedTokens().empty());
-  EXPECT_THAT(definitions, ElementsAre(Pair("BAAAAR", testing::_),
-                                       Pair("FOOOO", testing::_)));
+  EXPECT_THAT(definitions, UnorderedElementsAre(Pair("BAAAAR", testing::_),
+                                                Pair("FOOOO", testing::_)));
   {
     auto macro = FindOrNull(definitions, "BAAAAR");
     ASSERT_NE(macro, nullptr);
@@ -224,5 +236,220 @@ TEST(VerilogPreprocessTest, TwoMacroDefinitions) {
   }
 }
 
+// Returns the identifiers that remain after preprocessing.
+std::vector<absl::string_view> PreprocessedIdentifiers(
+    const PreprocessorTester& tester) {
+  std::vector<absl::string_view> identifiers;
+  const auto& tokens = tester.PreprocessorData().preprocessed_token_stream;
+  for (const auto& token : tokens) {
+    if (token->token_enum() == SymbolIdentifier) {
+      identifiers.push_back(token->text());
+    }
+  }
+  return identifiers;
+}
+
+VerilogPreprocessConfig FilterBranchesConfig(std::set<std::string> defines) {
+  VerilogPreprocessConfig config;
+  config.filter_branches = true;
+  config.defines = std::move(defines);
+  return config;
+}
+
+TEST(VerilogPreprocessTest, KeepsAllBranchesByDefault) {
+  PreprocessorTester tester(
+      "`ifdef A\n"
+      "module a;\nendmodule\n"
+      "`else\n"
+      "module b;\nendmodule\n"
+      "`endif\n");
+  EXPECT_TRUE(tester.Status().ok());
+  EXPECT_THAT(PreprocessedIdentifiers(tester), ElementsAre("a", "b"));
+}
+
+struct FilterBranchesTest {
+  const char* input;
+  std::set<std::string> defines;
+  std::vector<absl::string_view> expected_identifiers;
+};
+
+TEST(VerilogPreprocessTest, FilterBranches) {
+  const char kIfdefElse[] =
+      "`ifdef A\n"
+      "module a;\nendmodule\n"
+      "`else\n"
+      "module b;\nendmodule\n"
+      "`endif\n";
+  const char kIfndef[] =
+      "`ifndef A\n"
+      "module a;\nendmodule\n"
+      "`endif\n"
+      "module z;\nendmodule\n";
+  const char kElsifChain[] =
+      "`ifdef A\n"
+      "module a;\nendmodule\n"
+      "`elsif B\n"
+      "module b;\nendmodule\n"
+      "`elsif C\n"
+      "module c;\nendmodule\n"
+      "`else\n"
+      "module d;\nendmodule\n"
+      "`endif\n";
+  const char kNested[] =
+      "`ifdef A\n"
+      "`ifdef B\n"
+      "module ab;\nendmodule\n"
+      "`else\n"
+      "module a;\nendmodule\n"
+      "`endif\n"
+      "`else\n"
+      "`ifdef B\n"
+      "module b;\nendmodule\n"
+      "`endif\n"
+      "module n;\nendmodule\n"
+      "`endif\n";
+  const char kDefineInActiveBranch[] =
+      "`ifndef X\n"
+      "`define A\n"
+      "`endif\n"
+      "`ifdef A\n"
+      "module a;\nendmodule\n"
+      "`endif\n";
+  const char kDefineInInactiveBranch[] =
+      "`ifdef X\n"
+      "`define A\n"
+      "`endif\n"
+      "`ifdef A\n"
+      "module a;\nendmodule\n"
+      "`endif\n";
+  const char kUndef[] =
+      "`undef A\n"
+      "`ifdef A\n"
+      "module a;\nendmodule\n"
+      "`endif\n";
+  const FilterBranchesTest test_cases[] = {
+      {kIfdefElse, {}, {"b"}},
+      {kIfdefElse, {"A"}, {"a"}},
+      {kIfdefElse, {"B"}, {"b"}},
+      {kIfndef, {}, {"a", "z"}},
+      {kIfndef, {"A"}, {"z"}},
+      {kElsifChain, {}, {"d"}},
+      {kElsifChain, {"A", "B"}, {"a"}},
+      {kElsifChain, {"B", "C"}, {"b"}},
+      {kElsifChain, {"C"}, {"c"}},
+      {kNested, {}, {"n"}},
+      {kNested, {"B"}, {"b", "n"}},
+      {kNested, {"A"}, {"a"}},
+      {kNested, {"A", "B"}, {"ab"}},
+      {kDefineInActiveBranch, {}, {"a"}},
+      {kDefineInActiveBranch, {"X"}, {}},
+      {kDefineInInactiveBranch, {}, {}},
+      {kUndef, {}, {}},
+      {kUndef, {"A"}, {}},
+  };
+  for (const auto& test_case : test_cases) {
+    PreprocessorTester tester(test_case.input,
+                              FilterBranchesConfig(test_case.defines));
+    EXPECT_TRUE(tester.Status().ok()) << "input:\n" << test_case.input;
+    EXPECT_TRUE(tester.PreprocessorData().errors.empty());
+    EXPECT_EQ(PreprocessedIdentifiers(tester), test_case.expected_identifiers)
+        << "input:\n" << test_case.input;
+  }
+}
+
+TEST(VerilogPreprocessTest, FilterBranchesDropsInactiveDefinitions) {
+  PreprocessorTester tester(
+      "`ifdef X\n"
+      "`define A 1\n"
+      "`else\n"
+      "`define B 2\n"
+      "`endif\n",
+      FilterBranchesConfig({}));
+  EXPECT_TRUE(tester.Status().ok());
+  EXPECT_THAT(tester.PreprocessorData().macro_definitions,
+              ElementsAre(Pair("B", testing::_)));
+}
+
+// Inactive branches need not be valid code, and the remaining tokens still
+// refer to their location in the original text.
+TEST(VerilogPreprocessTest, FilterBranchesSkipsInvalidCode) {
+  const char kText[] =
+      "`ifdef NEVER\n"
+      "this is ) not ( verilog\n"
+      "`endif\n"
+      "module m;\nendmodule\n";
+  {
+    PreprocessorTester tester(kText);
+    EXPECT_FALSE(tester.Status().ok());
+  }
+  {
+    PreprocessorTester tester(kText, FilterBranchesConfig({}));
+    ASSERT_TRUE(tester.Status().ok());
+    const auto identifiers = PreprocessedIdentifiers(tester);
+    ASSERT_THAT(identifiers, ElementsAre("m"));
+    const absl::string_view contents(tester.Analyzer().Data().Contents());
+    EXPECT_EQ(identifiers.front().begin(),
+              contents.begin() + absl::string_view(kText).find("m;"));
+  }
+}
+
+TEST(VerilogPreprocessTest, FilterBranchesInvalidConditionals) {
+  const FailTest test_cases[] = {
+      {"`else\n", 0},                                 // no `ifdef
+      {"`elsif A\n", 0},                              // no `ifdef
+      {"`endif\n", 0},                                // no `ifdef
+      {"`ifdef A\n`else\n`else\n`endif\n", 15},      // duplicate `else
+      {"`ifdef A\n`else\n`elsif B\n`endif\n", 15},   // `elsif after `else
+      {"`ifdef A\nmodule m;\nendmodule\n", 0},        // missing `endif
+      {"`ifdef A\n`ifndef B\n`endif\n", 0},           // missing outer `endif
+  };
+  for (const auto& test_case : test_cases) {
+    PreprocessorTester tester(test_case.input, FilterBranchesConfig({}));
+    EXPECT_FALSE(tester.Status().ok())
+        << "Expected preprocess to fail on invalid input: \"" << test_case.input
+        << "\"";
+    const auto& rejected_tokens = tester.Analyzer().GetRejectedTokens();
+    ASSERT_FALSE(rejected_tokens.empty())
+        << "on invalid input: \"" << test_case.input << "\"";
+    const int rejected_token_offset =
+        rejected_tokens[0].token_info.left(tester.Analyzer().Data().Contents());
+    EXPECT_EQ(rejected_token_offset, test_case.offset)
+        << "on invalid input: \"" << test_case.input << "\"";
+  }
+}
+
+TEST(VerilogPreprocessTest, PredefinedMacros) {
+  const auto predefined = VerilogMacroSet::Build(
+      "`define P1 1\n"
+      "`define P2(x) (x)\n");
+  ASSERT_TRUE(predefined.ok()) << predefined.status();
+  VerilogPreprocessConfig config(FilterBranchesConfig({}));
+  config.predefined_macros = *predefined;
+  PreprocessorTester tester(
+      "`ifdef P1\n"
+      "module a;\nendmodule\n"
+      "`endif\n"
+      "`undef P2\n"
+      "`ifdef P2\n"
+      "module b;\nendmodule\n"
+      "`endif\n"
+      "`define P1 2\n",
+      config);
+  ASSERT_TRUE(tester.Status().ok());
+  EXPECT_THAT(PreprocessedIdentifiers(tester), ElementsAre("a"));
+
+  // Only the macros defined in the text itself are in its registry.
+  const auto& data = tester.PreprocessorData();
+  EXPECT_THAT(data.macro_definitions, ElementsAre(Pair("P1", testing::_)));
+  // Definitions in the text take precedence over predefined ones.
+  const auto* p1 = data.FindMacroDefinition("P1");
+  ASSERT_NE(p1, nullptr);
+  EXPECT_EQ(p1->DefinitionText().text(), "2");
+  const auto* p2 = data.FindMacroDefinition("P2");
+  ASSERT_NE(p2, nullptr);
+  EXPECT_TRUE(p2->IsCallable());
+  EXPECT_EQ(data.FindMacroDefinition("P3"), nullptr);
+}
+
 }  // namespace
 }  // namespace verilog
@@ -22,6 +22,7 @@
 //   0: stdout output can be used to replace original file
 //   nonzero: stdout output (if any) should be discarded
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -36,18 +37,17 @@
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
-#include "common/formatting/align.h"
 #include "common/strings/position.h"
 #include "common/util/file_util.h"
 #include "common/util/init_command_line.h"
 #include "common/util/interval_set.h"
 #include "common/util/logging.h"  // for operator<<, LOG, LogMessage, etc
+#include "common/util/thread_pool.h"
 #include "verilog/formatting/format_style.h"
+#include "verilog/formatting/format_style_flags.h"
 #include "verilog/formatting/formatter.h"
 
 using absl::StatusCode;
-using verible::AlignmentPolicy;
-using verible::IndentationStyle;
 using verible::LineNumberSet;
 using verilog::formatter::ExecutionControl;
 using verilog::formatter::FormatStyle;
@@ -94,15 +94,15 @@ ABSL_FLAG(LineRanges, lines, {},
           "Specific lines to format, 1-based, comma-separated, inclusive N-M "
           "ranges, N is short for N-N.  By default, left unspecified, "
           "all lines are enabled for formatting.  (repeatable, cumulative)");
+ABSL_FLAG(int, jobs, 1,
+          "Number of files to format concurrently with --inplace.  0 means "
+          "use all available cores.  Diagnostics are still printed in the "
+          "order of the files.");
 ABSL_FLAG(bool, failsafe_success, true,
           "If true, always exit with 0 status, even if there were input errors "
           "or internal errors.  In all error conditions, the original text is "
           "always preserved.  This is useful in deploying services where "
           "fail-safe behaviors should be considered a success.");
-ABSL_FLAG(bool, verify_convergence, true,
-          "If true, and not incrementally formatting with --lines, "
-          "verify that re-formatting the formatted output yields "
-          "no further changes, i.e. formatting is convergent.");
 
 ABSL_FLAG(int, show_largest_token_partitions, 0,
           "If > 0, print token partitioning and then "
@@ -116,72 +116,22 @@ ABSL_FLAG(bool, show_inter_token_info, false,
 ABSL_FLAG(bool, show_equally_optimal_wrappings, false,
           "If true, print when multiple optimal solutions are found (stderr), "
           "but continue to operate normally.");
-ABSL_FLAG(int, max_search_states, 100000,
-          "Limits the number of search states explored during "
-          "line wrap optimization.");
-
-// These flags exist in the short term to disable formatting of some regions.
-// Do not expect to be able to use these in the long term, once they find
-// a better home in a configuration struct.
-
-// "indent" means 2 spaces, "wrap" means 4 spaces.
-ABSL_FLAG(IndentationStyle, port_declarations_indentation,
-          IndentationStyle::kWrap, "Indent port declarations: {indent,wrap}");
-ABSL_FLAG(IndentationStyle, formal_parameters_indentation,
-          IndentationStyle::kWrap, "Indent formal parameters: {indent,wrap}");
-ABSL_FLAG(IndentationStyle, named_parameter_indentation,
-          IndentationStyle::kWrap,
-          "Indent named parameter assignments: {indent,wrap}");
-ABSL_FLAG(IndentationStyle, named_port_indentation, IndentationStyle::kWrap,
-          "Indent named port connections: {indent,wrap}");
-
-// For most of the following in this group, kInferUserIntent is a reasonable
-// default behavior because it allows for user-control with minimal invasiveness
-// and burden on the user.
-ABSL_FLAG(AlignmentPolicy, port_declarations_alignment,
-          AlignmentPolicy::kInferUserIntent,
-          "Format port declarations: {align,flush-left,preserve,infer}");
-ABSL_FLAG(AlignmentPolicy, named_parameter_alignment,
-          AlignmentPolicy::kInferUserIntent,
-          "Format named actual parameters: {align,flush-left,preserve,infer}");
-ABSL_FLAG(AlignmentPolicy, named_port_alignment,
-          AlignmentPolicy::kInferUserIntent,
-          "Format named port connections: {align,flush-left,preserve,infer}");
-ABSL_FLAG(
-    AlignmentPolicy, net_variable_alignment,  //
-    AlignmentPolicy::kInferUserIntent,
-    "Format net/variable declarations: {align,flush-left,preserve,infer}");
-ABSL_FLAG(AlignmentPolicy, formal_parameters_alignment,
-          AlignmentPolicy::kInferUserIntent,
-          "Format formal parameters: {align,flush-left,preserve,infer}");
-ABSL_FLAG(AlignmentPolicy, class_member_variables_alignment,
-          AlignmentPolicy::kInferUserIntent,
-          "Format class member variables: {align,flush-left,preserve,infer}");
-ABSL_FLAG(AlignmentPolicy, case_items_alignment,
-          AlignmentPolicy::kInferUserIntent,
-          "Format case items: {align,flush-left,preserve,infer}");
-ABSL_FLAG(AlignmentPolicy, assignment_statement_alignment,
-          AlignmentPolicy::kInferUserIntent,
-          "Format various assignments: {align,flush-left,preserve,infer}");
-
-ABSL_FLAG(bool, try_wrap_long_lines, false,
-          "If true, let the formatter attempt to optimize line wrapping "
-          "decisions where wrapping is needed, else leave them unformatted.  "
-          "This is a short-term measure to reduce risk-of-harm.");
-
-static std::ostream& FileMsg(absl::string_view filename) {
-  std::cerr << filename << ": ";
-  return std::cerr;
+static std::ostream& FileMsg(std::ostream& err, absl::string_view filename) {
+  err << filename << ": ";
+  return err;
 }
 
+// Formats one file, writing the result to 'out' unless in-place, and
+// diagnostics to 'err'.
 static bool formatOneFile(absl::string_view filename,
-                          const LineNumberSet& lines_to_format) {
+                          const LineNumberSet& lines_to_format,
+                          std::ostream& out, std::ostream& err) {
   const bool inplace = absl::GetFlag(FLAGS_inplace);
   const bool is_stdin = filename == "-";
   const auto& stdin_name = absl::GetFlag(FLAGS_stdin_name);
 
   if (inplace && is_stdin) {
-    FileMsg(filename)
+    FileMsg(err, filename)
         << "--inplace is incompatible with stdin.  Ignoring --inplace "
         << "and writing to stdout." << std::endl;
   }
@@ -192,65 +142,27 @@ static bool formatOneFile(absl::string_view filename,
   std::string content;
   absl::Status status = verible::file::GetContents(filename, &content);
   if (!status.ok()) {
-    FileMsg(filename) << status << std::endl;
+    FileMsg(err, filename) << status << std::endl;
     return false;
   }
 
   // TODO(fangism): When requesting --inplace, verify that file
   // is write-able, and fail-early if it is not.
 
-  // TODO(fangism): support style configuration from flags.
-  FormatStyle format_style;
+  const FormatStyle format_style = verilog::formatter::FormatStyleFromFlags();
 
   // Handle special debugging modes.
-  ExecutionControl formatter_control;
-  {
-    // execution control flags
-    formatter_control.stream = &std::cout;  // for diagnostics only
-    formatter_control.show_largest_token_partitions =
-        absl::GetFlag(FLAGS_show_largest_token_partitions);
-    formatter_control.show_token_partition_tree =
-        absl::GetFlag(FLAGS_show_token_partition_tree);
-    formatter_control.show_inter_token_info =
-        absl::GetFlag(FLAGS_show_inter_token_info);
-    formatter_control.show_equally_optimal_wrappings =
-        absl::GetFlag(FLAGS_show_equally_optimal_wrappings);
-    formatter_control.max_search_states =
-        absl::GetFlag(FLAGS_max_search_states);
-    formatter_control.verify_convergence =
-        absl::GetFlag(FLAGS_verify_convergence);
-
-    // formatting style flags
-    format_style.try_wrap_long_lines = absl::GetFlag(FLAGS_try_wrap_long_lines);
-
-    // various indentation control
-    format_style.port_declarations_indentation =
-        absl::GetFlag(FLAGS_port_declarations_indentation);
-    format_style.formal_parameters_indentation =
-        absl::GetFlag(FLAGS_formal_parameters_indentation);
-    format_style.named_parameter_indentation =
-        absl::GetFlag(FLAGS_named_parameter_indentation);
-    format_style.named_port_indentation =
-        absl::GetFlag(FLAGS_named_port_indentation);
-
-    // various alignment control
-    format_style.port_declarations_alignment =
-        absl::GetFlag(FLAGS_port_declarations_alignment);
-    format_style.named_parameter_alignment =
-        absl::GetFlag(FLAGS_named_parameter_alignment);
-    format_style.named_port_alignment =
-        absl::GetFlag(FLAGS_named_port_alignment);
-    format_style.module_net_variable_alignment =
-        absl::GetFlag(FLAGS_net_variable_alignment);
-    format_style.formal_parameters_alignment =
-        absl::GetFlag(FLAGS_formal_parameters_alignment);
-    format_style.class_member_variable_alignment =
-        absl::GetFlag(FLAGS_class_member_variables_alignment);
-    format_style.case_items_alignment =
-        absl::GetFlag(FLAGS_case_items_alignment);
-    format_style.assignment_statement_alignment =
-        absl::GetFlag(FLAGS_assignment_statement_alignment);
-  }
+  ExecutionControl formatter_control =
+      verilog::formatter::ExecutionControlFromFlags();
+  formatter_control.stream = &out;  // for diagnostics only
+  formatter_control.show_largest_token_partitions =
+      absl::GetFlag(FLAGS_show_largest_token_partitions);
+  formatter_control.show_token_partition_tree =
+      absl::GetFlag(FLAGS_show_token_partition_tree);
+  formatter_control.show_inter_token_info =
+      absl::GetFlag(FLAGS_show_inter_token_info);
+  formatter_control.show_equally_optimal_wrappings =
+      absl::GetFlag(FLAGS_show_equally_optimal_wrappings);
 
   std::ostringstream stream;
   const auto format_status =
@@ -261,21 +173,21 @@ static bool formatOneFile(absl::string_view filename,
   if (!format_status.ok()) {
     if (!inplace) {
       // Fall back to printing original content regardless of error condition.
-      std::cout << content;
+      out << content;
     }
     switch (format_status.code()) {
       case StatusCode::kCancelled:
       case StatusCode::kInvalidArgument:
-        FileMsg(filename) << format_status.message() << std::endl;
+        FileMsg(err, filename) << format_status.message() << std::endl;
         break;
       case StatusCode::kDataLoss:
-        FileMsg(filename) << format_status.message()
-                          << "; problematic formatter output is\n"
-                          << formatted_output << "<<EOF>>" << std::endl;
+        FileMsg(err, filename) << format_status.message()
+                               << "; problematic formatter output is\n"
+                               << formatted_output << "<<EOF>>" << std::endl;
         break;
       default:
-        FileMsg(filename) << format_status.message() << "[other error status]"
-                          << std::endl;
+        FileMsg(err, filename) << format_status.message()
+                               << "[other error status]" << std::endl;
         break;
     }
 
@@ -286,17 +198,20 @@ static bool formatOneFile(absl::string_view filename,
   if (inplace && !is_stdin) {
     // Don't write if the output is exactly as the input, so that we don't mess
     // with tools that look for timestamp changes (such as make).
+    // Replace the file atomically, so that it is never seen partially written.
     if (content != formatted_output) {
-      status = verible::file::SetContents(filename, formatted_output);
+      status =
+          verible::file::SetContentsAtomically(filename, formatted_output);
       if (!status.ok()) {
-        FileMsg(filename) << "error writing result " << status << std::endl;
+        FileMsg(err, filename) << "error writing result " << status
+                               << std::endl;
         return false;
       }
     } else {
-      FileMsg(filename) << "Already formatted, no change." << std::endl;
+      FileMsg(err, filename) << "Already formatted, no change." << std::endl;
     }
   } else {
-    std::cout << formatted_output;
+    out << formatted_output;
   }
 
   return true;
@@ -338,11 +253,43 @@ int main(int argc, char** argv) {
     }
   }
 
-  bool all_success = true;
   // All positional arguments are file names.  Exclude program name.
-  for (const absl::string_view filename :
-       verible::make_range(file_args.begin() + 1, file_args.end())) {
-    all_success &= formatOneFile(filename, lines_to_format);
+  const std::vector<absl::string_view> filenames(file_args.begin() + 1,
+                                                 file_args.end());
+  int jobs = absl::GetFlag(FLAGS_jobs);
+  if (jobs <= 0) jobs = verible::ThreadPool::DefaultNumThreads();
+  jobs = std::min<int>(jobs, filenames.size());
+  bool all_success = true;
+  if (jobs <= 1) {
+    for (const absl::string_view filename : filenames) {
+      all_success &=
+          formatOneFile(filename, lines_to_format, std::cout, std::cerr);
+    }
+    return all_success ? 0 : 1;
+  }
+
+  // Each file's output is collected separately, and printed in order once all
+  // files are done.
+  struct FileResult {
+    std::ostringstream out;
+    std::ostringstream err;
+    bool success = false;
+  };
+  std::vector<FileResult> results(filenames.size());
+  {
+    verible::ThreadPool pool(jobs);
+    for (size_t i = 0; i < filenames.size(); ++i) {
+      pool.Schedule([&, i] {
+        FileResult& result = results[i];
+        result.success = formatOneFile(filenames[i], lines_to_format,
+                                       result.out, result.err);
+      });
+    }
+  }  // all files done here
+  for (const auto& result : results) {
+    std::cout << result.out.str();
+    std::cerr << result.err.str();
+    all_success &= result.success;
   }
 
   return all_success ? 0 : 1;
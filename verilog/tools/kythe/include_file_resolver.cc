@@ -0,0 +1,109 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/tools/kythe/include_file_resolver.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "common/strings/mem_block.h"
+#include "common/util/file_util.h"
+
+namespace verilog {
+namespace kythe {
+
+template <typename T>
+IncludeFileResolver::CacheEntry<T>* IncludeFileResolver::GetEntry(
+    Cache<T>* cache, absl::string_view key) {
+  absl::MutexLock l(&lock_);
+  auto& entry = (*cache)[std::string(key)];
+  if (entry == nullptr) entry = absl::make_unique<CacheEntry<T>>();
+  // Map nodes are stable, and entries are never removed.
+  return entry.get();
+}
+
+const IncludeFileResolver::IncludedFile* IncludeFileResolver::Resolve(
+    absl::string_view filename) {
+  auto* entry = GetEntry(&included_files_, filename);
+  // Concurrent lookups of the same file wait for the first one to finish.
+  absl::call_once(entry->once, [this, entry, filename] {
+    // If a file with name "filename" exists in more than one of the
+    // directories the first found one is used.
+    for (const auto& dir_path : include_dir_paths_) {
+      std::string file_path = verible::file::JoinPath(dir_path, filename);
+      if (!FileExists(file_path)) continue;
+      auto content = GetContents(file_path);
+      if (content.ok()) {
+        entry->value = absl::make_unique<IncludedFile>(
+            IncludedFile{std::move(file_path), *std::move(content)});
+      }
+      return;
+    }
+  });
+  return entry->value.get();
+}
+
+absl::StatusOr<std::shared_ptr<verible::MemBlock>>
+IncludeFileResolver::GetContents(absl::string_view path) {
+  auto* entry = GetEntry(&contents_, path);
+  absl::call_once(entry->once, [entry, path] {
+    auto content = verible::file::GetContentAsMemBlock(path);
+    if (content.ok()) {
+      entry->value = std::shared_ptr<verible::MemBlock>(*std::move(content));
+    } else {
+      entry->value = content.status();
+    }
+  });
+  return entry->value;
+}
+
+bool IncludeFileResolver::FileExists(absl::string_view path) {
+  const auto last_slash = path.find_last_of('/');
+  const absl::string_view dir_path =
+      last_slash == absl::string_view::npos
+          ? "."
+          : last_slash == 0 ? "/" : path.substr(0, last_slash);
+  const absl::string_view name = last_slash == absl::string_view::npos
+                                     ? path
+                                     : path.substr(last_slash + 1);
+
+  // One directory listing answers lookups of all the files in it, instead of
+  // checking each candidate path separately.
+  auto* entry = GetEntry(&directories_, dir_path);
+  absl::call_once(entry->once, [entry, dir_path] {
+    const auto dir = verible::file::ListDir(dir_path);
+    if (!dir.ok()) return;
+    entry->value = absl::make_unique<std::set<std::string>>();
+    for (const auto& file : dir->files) {
+      entry->value->emplace(verible::file::Basename(file));
+    }
+  });
+  if (entry->value == nullptr) {
+    // Fall back to checking the file itself, e.g. for directories that are
+    // searchable but not readable.
+    return verible::file::FileExists(std::string(path)).ok();
+  }
+  return entry->value->find(std::string(name)) != entry->value->end();
+}
+
+}  // namespace kythe
+}  // namespace verilog
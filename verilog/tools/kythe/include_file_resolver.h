@@ -0,0 +1,108 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_VERILOG_TOOLS_KYTHE_INCLUDE_FILE_RESOLVER_H_
+#define VERIBLE_VERILOG_TOOLS_KYTHE_INCLUDE_FILE_RESOLVER_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "absl/base/call_once.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "common/strings/mem_block.h"
+
+namespace verilog {
+namespace kythe {
+
+// Locates the files named by `include directives in the given directories,
+// and loads file contents.
+// Everything is looked up at most once and then served from caches:
+//   * the resolution of every included file name (found or not),
+//   * the listing of every searched directory, so looking for a file doesn't
+//     need to probe every include directory,
+//   * the contents of every file path, shared by all the files that include it.
+// Changes to the file system after a lookup are not noticed.
+// This class is thread-safe.
+class IncludeFileResolver {
+ public:
+  struct IncludedFile {
+    // Path of the found file (include directory joined with the file name).
+    std::string path;
+    std::shared_ptr<verible::MemBlock> content;
+  };
+
+  explicit IncludeFileResolver(std::vector<std::string> include_dir_paths)
+      : include_dir_paths_(std::move(include_dir_paths)) {}
+
+  IncludeFileResolver(const IncludeFileResolver&) = delete;
+  IncludeFileResolver& operator=(const IncludeFileResolver&) = delete;
+
+  // Searches the include directories in order for "filename", and returns
+  // the first found file, or nullptr if it doesn't exist in any of them, or
+  // couldn't be read.
+  // The returned object lives as long as this resolver.
+  const IncludedFile* Resolve(absl::string_view filename);
+
+  // Returns the contents of the file at "path".
+  absl::StatusOr<std::shared_ptr<verible::MemBlock>> GetContents(
+      absl::string_view path);
+
+ private:
+  // A lookup result which is computed once.
+  template <typename T>
+  struct CacheEntry {
+    absl::once_flag once;
+    T value;
+  };
+
+  template <typename T>
+  using Cache = std::map<std::string, std::unique_ptr<CacheEntry<T>>>;
+
+  // Returns the (possibly not yet computed) entry for "key".
+  template <typename T>
+  CacheEntry<T>* GetEntry(Cache<T>* cache, absl::string_view key)
+      ABSL_LOCKS_EXCLUDED(lock_);
+
+  // Returns true if "path" is a regular file (or a link to one).
+  bool FileExists(absl::string_view path);
+
+  // Holds the paths of the directories used to look for the included
+  // files.
+  const std::vector<std::string> include_dir_paths_;
+
+  absl::Mutex lock_;
+
+  // "Key: referenced file name (could be relative)", nullptr if not found.
+  Cache<std::unique_ptr<IncludedFile>> included_files_ ABSL_GUARDED_BY(lock_);
+
+  // "Key: directory path", Value: names of the files in that directory, or
+  // nullptr if the directory couldn't be listed.
+  Cache<std::unique_ptr<std::set<std::string>>> directories_
+      ABSL_GUARDED_BY(lock_);
+
+  // "Key: file path"
+  Cache<absl::StatusOr<std::shared_ptr<verible::MemBlock>>> contents_
+      ABSL_GUARDED_BY(lock_);
+};
+
+}  // namespace kythe
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_TOOLS_KYTHE_INCLUDE_FILE_RESOLVER_H_
@@ -0,0 +1,109 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/tools/kythe/include_file_resolver.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "common/util/file_util.h"
+
+namespace verilog {
+namespace kythe {
+namespace {
+
+using verible::file::testing::ScopedTestFile;
+
+TEST(IncludeFileResolverTest, NotFound) {
+  IncludeFileResolver resolver({testing::TempDir()});
+  EXPECT_EQ(resolver.Resolve("does-not-exist.svh"), nullptr);
+}
+
+TEST(IncludeFileResolverTest, FoundInFirstDirectory) {
+  const std::string dir1 = verible::file::JoinPath(testing::TempDir(), "dir1");
+  const std::string dir2 = verible::file::JoinPath(testing::TempDir(), "dir2");
+  ASSERT_TRUE(verible::file::CreateDir(dir1).ok());
+  ASSERT_TRUE(verible::file::CreateDir(dir2).ok());
+  ScopedTestFile file2(dir2, "second");
+  const std::string name(verible::file::Basename(file2.filename()));
+  // Same name in the first directory.
+  const std::string path1 = verible::file::JoinPath(dir1, name);
+  ASSERT_TRUE(verible::file::SetContents(path1, "first").ok());
+
+  IncludeFileResolver resolver({dir1, dir2});
+  const auto* included_file = resolver.Resolve(name);
+  ASSERT_NE(included_file, nullptr);
+  EXPECT_EQ(included_file->path, path1);
+  EXPECT_EQ(included_file->content->AsStringView(), "first");
+  unlink(path1.c_str());
+}
+
+TEST(IncludeFileResolverTest, ResultsAreCached) {
+  const std::string dir = verible::file::JoinPath(testing::TempDir(), "cache");
+  ASSERT_TRUE(verible::file::CreateDir(dir).ok());
+  const std::string path = verible::file::JoinPath(dir, "cached.svh");
+  ASSERT_TRUE(verible::file::SetContents(path, "content").ok());
+
+  IncludeFileResolver resolver({dir});
+  EXPECT_EQ(resolver.Resolve("new.svh"), nullptr);
+  const auto* included_file = resolver.Resolve("cached.svh");
+  ASSERT_NE(included_file, nullptr);
+
+  // Changes to the file system are not noticed.
+  unlink(path.c_str());
+  ASSERT_TRUE(
+      verible::file::SetContents(verible::file::JoinPath(dir, "new.svh"), "")
+          .ok());
+  EXPECT_EQ(resolver.Resolve("new.svh"), nullptr);
+  EXPECT_EQ(resolver.Resolve("cached.svh"), included_file);
+  EXPECT_EQ(included_file->content->AsStringView(), "content");
+  unlink(verible::file::JoinPath(dir, "new.svh").c_str());
+}
+
+TEST(IncludeFileResolverTest, ContentsSharedBetweenNames) {
+  const std::string dir = verible::file::JoinPath(testing::TempDir(), "sub");
+  ASSERT_TRUE(verible::file::CreateDir(dir).ok());
+  ScopedTestFile file(dir, "shared");
+  const std::string name(verible::file::Basename(file.filename()));
+
+  // Found as "sub/<name>" in the first directory and as "<name>" in the
+  // second, both under the same path.
+  IncludeFileResolver resolver({testing::TempDir(), dir});
+  const auto* included_file1 =
+      resolver.Resolve(verible::file::JoinPath("sub", name));
+  const auto* included_file2 = resolver.Resolve(name);
+  ASSERT_NE(included_file1, nullptr);
+  ASSERT_NE(included_file2, nullptr);
+  EXPECT_EQ(included_file1->path, included_file2->path);
+  EXPECT_EQ(included_file1->content, included_file2->content);
+
+  const auto content = resolver.GetContents(included_file1->path);
+  ASSERT_TRUE(content.ok());
+  EXPECT_EQ(*content, included_file1->content);
+}
+
+TEST(IncludeFileResolverTest, GetContentsError) {
+  IncludeFileResolver resolver({});
+  EXPECT_FALSE(
+      resolver.GetContents(verible::file::JoinPath(testing::TempDir(), "nope"))
+          .ok());
+}
+
+}  // namespace
+}  // namespace kythe
+}  // namespace verilog
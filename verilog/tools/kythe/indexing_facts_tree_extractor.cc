@@ -15,13 +15,24 @@
 #include "verilog/tools/kythe/indexing_facts_tree_extractor.h"
 
 #include <iostream>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/memory/memory.h"
 #include "absl/strings/strip.h"
+#include "absl/synchronization/mutex.h"
+#include "common/analysis/syntax_tree_index.h"
+#include "common/analysis/syntax_tree_search.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/tree_context_visitor.h"
 #include "common/text/tree_utils.h"
 #include "common/util/file_util.h"
+#include "common/util/thread_pool.h"
 #include "verilog/CST/class.h"
 #include "verilog/CST/declaration.h"
 #include "verilog/CST/functions.h"
@@ -49,30 +60,44 @@ using verible::SyntaxTreeLeaf;
 using verible::SyntaxTreeNode;
 using verible::TreeSearchMatch;
 
+// Indexing facts of one file, extracted independently of other files.
+struct ExtractedFile {
+  // Status of reading the file.
+  absl::Status status;
+
+  // The extracted indexing facts tree (kFile), nullptr if the file couldn't
+  // be read.
+  std::unique_ptr<IndexingFactNode> tree;
+
+  // Names of the (resolved) files included by this file, in order.
+  std::vector<std::string> included_files;
+};
+
 // Given a root to CST this function traverses the tree, extracts and constructs
 // the indexing facts tree.
-IndexingFactNode BuildIndexingFactsTree(
-    const verible::ConcreteSyntaxTree& syntax_tree, absl::string_view base,
-    absl::string_view file_name, IndexingFactNode& file_list_facts_tree,
-    std::map<std::string, std::string>& extracted_files,
-    const std::vector<std::string>& include_dir_paths) {
-  IndexingFactsTreeExtractor visitor(base, file_name, file_list_facts_tree,
-                                     extracted_files, include_dir_paths);
-  if (syntax_tree == nullptr) {
-    return visitor.GetRoot();
-  }
-
-  syntax_tree->Accept(&visitor);
-  return visitor.GetRoot();
+void BuildIndexingFactsTree(const verible::ConcreteSyntaxTree& syntax_tree,
+                            absl::string_view base, absl::string_view file_name,
+                            IncludeFileResolver& include_resolver,
+                            ExtractedFile* extracted_file) {
+  IndexingFactsTreeExtractor visitor(base, file_name, include_resolver);
+  if (syntax_tree != nullptr) {
+    // Speeds up the many subtree searches done by the extractor.
+    const verible::SyntaxTreeIndex index(*syntax_tree);
+    const verible::SyntaxTreeIndex::ScopedActivation activate_index(&index);
+    syntax_tree->Accept(&visitor);
+  }
+
+  extracted_file->tree =
+      absl::make_unique<IndexingFactNode>(std::move(visitor.GetRoot()));
+  extracted_file->included_files = visitor.IncludedFiles();
 }
 
 // Extracts indexing facts tree for one file.
-IndexingFactNode ExtractOneFile(
-    absl::string_view content, absl::string_view filename,
-    IndexingFactNode& file_list_facts_tree,
-    std::map<std::string, std::string>& extracted_files,
-    const std::vector<std::string>& include_dir_paths) {
-  verilog::VerilogAnalyzer analyzer(content, filename);
+void ExtractOneFile(std::shared_ptr<verible::MemBlock> content,
+                    absl::string_view filename,
+                    IncludeFileResolver& include_resolver,
+                    ExtractedFile* extracted_file) {
+  verilog::VerilogAnalyzer analyzer(std::move(content), filename);
   // Do not parse using AnalyzeAutomaticMode() because index extraction is only
   // expected to work on self-contained files with full syntactic context.
   const auto status = analyzer.Analyze();
@@ -89,24 +114,85 @@ IndexingFactNode ExtractOneFile(
   const auto& text_structure = analyzer.Data();
   const auto& syntax_tree = text_structure.SyntaxTree();
 
-  return BuildIndexingFactsTree(syntax_tree, analyzer.Data().Contents(),
-                                filename, file_list_facts_tree, extracted_files,
-                                include_dir_paths);
+  BuildIndexingFactsTree(syntax_tree, analyzer.Data().Contents(), filename,
+                         include_resolver, extracted_file);
 }
 
-// Searches for the given "filename" in all the given diretories.
-// If the a file with name "filename" exists in more than one of the given
-// directories the first found one will be returned.
-absl::Status SearchForFileAndGetContents(
-    std::string& file_path, std::string& content, absl::string_view filename,
-    const std::vector<std::string>& directories) {
-  for (const auto& dir_path : directories) {
-    file_path = verible::file::JoinPath(dir_path, filename);
-    if (verible::file::FileExists(file_path).ok()) {
-      return verible::file::GetContents(file_path, &content);
+// Concurrently extracts the listed files, and all the files they include
+// (transitively), using a ThreadPool.  Included files are keyed by the name
+// used in the `include directive, and each one is extracted only once.
+class ConcurrentFileExtractor {
+ public:
+  explicit ConcurrentFileExtractor(IncludeFileResolver& include_resolver)
+      : include_resolver_(include_resolver) {}
+
+  // Schedules reading and extracting "file_path" into "extracted_file".
+  void ExtractListedFile(verible::ThreadPool* pool, std::string file_path,
+                         ExtractedFile* extracted_file) {
+    pool->Schedule([this, pool, file_path, extracted_file] {
+      auto content = include_resolver_.GetContents(file_path);
+      extracted_file->status = content.status();
+      if (!content.ok()) return;
+      ExtractOneFile(*std::move(content), file_path, include_resolver_,
+                     extracted_file);
+      ExtractIncludedFiles(pool, *extracted_file);
+    });
+  }
+
+  // Returns the extracted included files.
+  // Only call this once all the scheduled work is done.
+  std::map<std::string, ExtractedFile>& IncludedFiles() {
+    absl::MutexLock l(&lock_);
+    return included_files_;
+  }
+
+ private:
+  // Schedules the extraction of the files included by "includer" that are
+  // not already extracted or being extracted.
+  void ExtractIncludedFiles(verible::ThreadPool* pool,
+                            const ExtractedFile& includer) {
+    for (const auto& filename : includer.included_files) {
+      ExtractedFile* extracted_file;
+      {
+        absl::MutexLock l(&lock_);
+        const auto inserted =
+            included_files_.emplace(filename, ExtractedFile());
+        if (!inserted.second) continue;
+        // Map nodes are stable, so this pointer stays valid.
+        extracted_file = &inserted.first->second;
+      }
+      pool->Schedule([this, pool, filename, extracted_file] {
+        // Already resolved by the includer, so this is a cache lookup.
+        const IncludeFileResolver::IncludedFile* included_file =
+            include_resolver_.Resolve(filename);
+        ExtractOneFile(included_file->content, included_file->path,
+                       include_resolver_, extracted_file);
+        ExtractIncludedFiles(pool, *extracted_file);
+      });
     }
   }
-  return absl::NotFoundError(absl::StrCat("Couldn't find file: ", filename));
+
+  IncludeFileResolver& include_resolver_;
+
+  absl::Mutex lock_;
+
+  // "Key: referenced file name (could be relative)"
+  std::map<std::string, ExtractedFile> included_files_ ABSL_GUARDED_BY(lock_);
+};
+
+// Appends "file" to "file_list_facts_tree", preceded by the files it includes
+// which weren't appended yet (depth-first, in order of inclusion).
+// This yields the same order as extracting the files one at a time.
+void AppendExtractedFile(ExtractedFile& file,
+                         std::map<std::string, ExtractedFile>& included_files,
+                         std::set<std::string>& appended_included_files,
+                         IndexingFactNode& file_list_facts_tree) {
+  for (const auto& filename : file.included_files) {
+    if (!appended_included_files.insert(filename).second) continue;
+    AppendExtractedFile(included_files.at(filename), included_files,
+                        appended_included_files, file_list_facts_tree);
+  }
+  file_list_facts_tree.NewChild(std::move(*file.tree));
 }
 
 }  // namespace
@@ -115,36 +201,55 @@ IndexingFactNode ExtractFiles(const std::vector<std::string>& ordered_file_list,
                               absl::string_view file_list_path,
                               absl::string_view file_list_root,
                               const std::vector<std::string>& include_dir_paths,
-                              std::vector<absl::Status>& errors) {
+                              std::vector<absl::Status>& errors,
+                              int num_threads) {
   // Create a node to hold the path and root of the ordered file list, group
   // all the files and acts as a ordered file list of these files.
   IndexingFactNode file_list_facts_tree(IndexingNodeData(
       {Anchor(file_list_path, 0, 0), Anchor(file_list_root, 0, 0)},
       IndexingFactType::kFileList));
 
-  // Maps each "filename" to its file path.
-  // Used to prevent extracting the same file more than once.
-  std::map<std::string, std::string> extracted_files;
+  // Shared by all files, so every included file (and every listed file) is
+  // looked up and read only once.
+  IncludeFileResolver include_resolver(include_dir_paths);
 
-  for (const auto& filename : ordered_file_list) {
-    // Check if this included file was extracted before.
-    if (extracted_files.find(filename) != extracted_files.end()) {
+  // Phase 1: Read, parse and extract all files concurrently.  The facts trees
+  // of different files don't depend on each other.
+  std::vector<ExtractedFile> listed_files(ordered_file_list.size());
+  ConcurrentFileExtractor extractor(include_resolver);
+  {
+    // With a single thread, extract everything in the calling thread.
+    verible::ThreadPool pool(num_threads > 1 ? num_threads : 0);
+    for (size_t i = 0; i < ordered_file_list.size(); ++i) {
+      extractor.ExtractListedFile(
+          &pool, verible::file::JoinPath(file_list_root, ordered_file_list[i]),
+          &listed_files[i]);
+    }
+  }  // Waits for all files, including the discovered included files.
+  std::map<std::string, ExtractedFile>& included_files =
+      extractor.IncludedFiles();
+
+  // Phase 2: Assemble the file list in order.
+  // Tracks the included files that were already added to the file list.
+  // Used to prevent adding the same file more than once.
+  std::set<std::string> appended_included_files;
+
+  for (size_t i = 0; i < ordered_file_list.size(); ++i) {
+    // Check if this file was included (and added) before.
+    if (appended_included_files.find(ordered_file_list[i]) !=
+        appended_included_files.end()) {
       continue;
     }
 
-    std::string file_path = verible::file::JoinPath(file_list_root, filename);
-    std::string content;
-
-    const auto status = verible::file::GetContents(file_path, &content);
-    if (!status.ok()) {
-      errors.push_back(status);
-      LOG(ERROR) << status.message();
+    ExtractedFile& listed_file = listed_files[i];
+    if (!listed_file.status.ok()) {
+      errors.push_back(listed_file.status);
+      LOG(ERROR) << listed_file.status.message();
       continue;
     }
 
-    file_list_facts_tree.NewChild(
-        ExtractOneFile(content, file_path, file_list_facts_tree,
-                       extracted_files, include_dir_paths));
+    AppendExtractedFile(listed_file, included_files, appended_included_files,
+                        file_list_facts_tree);
   }
 
   return file_list_facts_tree;
@@ -342,9 +447,8 @@ void IndexingFactsTreeExtractor::ExtractDataDeclaration(
       FindAllRegisterVariables(data_declaration);
   if (!register_variables.empty()) {
     // for classes.
-    const std::vector<TreeSearchMatch> class_instances =
-        verible::SearchSyntaxTree(data_declaration, NodekClassNew());
-    if (!class_instances.empty()) {
+    if (verible::FindFirstMatch(data_declaration, NodekClassNew()) !=
+        nullptr) {
       ExtractClassInstances(data_declaration, register_variables);
       return;
     }
@@ -378,9 +482,8 @@ void IndexingFactsTreeExtractor::ExtractDataDeclaration(
 
   if (!variable_declaration_assign.empty()) {
     // for classes.
-    const std::vector<TreeSearchMatch> class_instances =
-        verible::SearchSyntaxTree(data_declaration, NodekClassNew());
-    if (!class_instances.empty()) {
+    if (verible::FindFirstMatch(data_declaration, NodekClassNew()) !=
+        nullptr) {
       ExtractClassInstances(data_declaration, variable_declaration_assign);
       return;
     }
@@ -1375,36 +1478,23 @@ void IndexingFactsTreeExtractor::ExtractInclude(
   int startLocation = included_filename->get().left(context_.base);
   int endLocation = included_filename->get().right(context_.base);
 
-  std::string file_path = "";
-
-  // Check if this included file was extracted before.
-  const auto filename_itr = extracted_files_.find(filename);
-  if (filename_itr != extracted_files_.end()) {
-    file_path = filename_itr->second;
-  } else {
-    std::string content;
-
-    auto status = SearchForFileAndGetContents(file_path, content, filename,
-                                              include_dir_paths_);
-    if (!status.ok()) {
-      // Couldn't find the included file in any of include directories.
-      LOG(ERROR) << "Error while reading file: " << filename;
-      return;
-    }
-
-    extracted_files_[filename] = file_path;
-
-    file_list_facts_tree_.NewChild(
-        ExtractOneFile(content, file_path, file_list_facts_tree_,
-                       extracted_files_, include_dir_paths_));
+  const IncludeFileResolver::IncludedFile* included_file =
+      include_resolver_.Resolve(filename);
+  if (included_file == nullptr) {
+    // Couldn't find the included file in any of include directories.
+    LOG(ERROR) << "Error while reading file: " << filename;
+    return;
   }
 
+  // The included file itself is extracted separately, see ExtractFiles().
+  included_files_.push_back(filename);
+
   // Create a node for include statement with two Anchors:
   // 1st one holds the actual text in the include statement.
   // 2nd one holds the path of the included file relative to the file list.
   facts_tree_context_.top().NewChild(
       IndexingNodeData({Anchor(filename_text, startLocation, endLocation),
-                        Anchor(file_path, 0, 0)},
+                        Anchor(included_file->path, 0, 0)},
                        IndexingFactType::kInclude));
 }
 
@@ -16,6 +16,8 @@
 #define VERIBLE_VERILOG_TOOLS_KYTHE_INDEXING_FACTS_TREE_EXTRACTOR_H_
 
 #include <initializer_list>
+#include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
@@ -23,6 +25,7 @@
 #include "common/text/tree_context_visitor.h"
 #include "verilog/CST/verilog_matchers.h"
 #include "verilog/CST/verilog_nonterminals.h"
+#include "verilog/tools/kythe/include_file_resolver.h"
 #include "verilog/tools/kythe/indexing_facts_tree.h"
 #include "verilog/tools/kythe/indexing_facts_tree_context.h"
 
@@ -31,17 +34,15 @@ namespace kythe {
 
 // This class is used for traversing CST and extracting different indexing
 // facts from CST nodes and constructs a tree of indexing facts.
+// Included files are not extracted recursively, but only recorded (see
+// IncludedFiles()), so that every file can be extracted independently.
 class IndexingFactsTreeExtractor : public verible::TreeContextVisitor {
  public:
-  IndexingFactsTreeExtractor(
-      absl::string_view base, absl::string_view file_name,
-      IndexingFactNode& file_list_facts_tree,
-      std::map<std::string, std::string>& extracted_files,
-      const std::vector<std::string>& include_dir_paths)
+  IndexingFactsTreeExtractor(absl::string_view base,
+                             absl::string_view file_name,
+                             IncludeFileResolver& include_resolver)
       : context_(verible::TokenInfo::Context(base)),
-        file_list_facts_tree_(file_list_facts_tree),
-        extracted_files_(extracted_files),
-        include_dir_paths_(include_dir_paths) {
+        include_resolver_(include_resolver) {
     // Create the Anchors for file path node.
     root_.Value().AppendAnchor(Anchor(file_name, 0, base.size()));
     // Create the Anchors for text (code) node.
@@ -53,6 +54,12 @@ class IndexingFactsTreeExtractor : public verible::TreeContextVisitor {
 
   IndexingFactNode& GetRoot() { return root_; }
 
+  // Returns the names of the successfully resolved included files, in the
+  // order of their `include directives.
+  const std::vector<std::string>& IncludedFiles() const {
+    return included_files_;
+  }
+
  private:
   // Extracts facts from module, intraface and program declarations.
   void ExtractModuleOrInterfaceOrProgram(
@@ -266,20 +273,11 @@ class IndexingFactsTreeExtractor : public verible::TreeContextVisitor {
   // Keeps track of indexing facts tree ancestors as the visitor traverses CST.
   IndexingFactsTreeContext facts_tree_context_;
 
-  // "IndexingFactNode" with tag kFileList which holds the extracted indexing
-  // facts trees of the files in the ordered file list. The extracted files will
-  // be children of this node and ordered as they are given in the ordered file
-  // list.
-  IndexingFactNode& file_list_facts_tree_;
-
-  // Maps every file name to its file path.
-  // Used to avoid extracting some file more than one time.
-  // "Key: referenced file name (could be relative), Value: resolved file path"
-  std::map<std::string, std::string>& extracted_files_;
+  // Resolves and loads included files.
+  IncludeFileResolver& include_resolver_;
 
-  // Holds the paths of the directories used to look for the included
-  // files.
-  const std::vector<std::string>& include_dir_paths_;
+  // Names of the included files, in order of appearance.
+  std::vector<std::string> included_files_;
 
   // Counter used as an id for the anonymous scopes.
   int next_anonymous_id = 0;
@@ -288,12 +286,16 @@ class IndexingFactsTreeExtractor : public verible::TreeContextVisitor {
 // Given the ordered SystemVerilog files, Extracts and returns the
 // IndexingFactsTree for the given files.
 // The returned Root will have the files as children and they will retain their
-// original ordering from the file list.
+// original ordering from the file list.  Every included file is placed before
+// the first file that includes it.
+// Files are read, parsed and extracted concurrently using up to "num_threads"
+// threads; the resulting tree doesn't depend on the number of threads.
 IndexingFactNode ExtractFiles(const std::vector<std::string>& ordered_file_list,
                               absl::string_view file_list_path,
                               absl::string_view file_list_root,
                               const std::vector<std::string>& include_dir_paths,
-                              std::vector<absl::Status>& errors);
+                              std::vector<absl::Status>& errors,
+                              int num_threads = 1);
 
 }  // namespace kythe
 }  // namespace verilog
@@ -16,6 +16,7 @@
 
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "common/analysis/syntax_tree_search_test_utils.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/util/file_util.h"
@@ -5125,6 +5126,51 @@ TEST(FactsTreeExtractor, FileIncludeSameFileTwice) {
   EXPECT_EQ(result_pair.right, nullptr) << *result_pair.right;
 }
 
+TEST(FactsTreeExtractor, ConcurrentExtractionMatchesSerial) {
+  // b.svh is included by a.svh and by the second listed file.
+  ScopedTestFile included_b(testing::TempDir(), "class class_b;\nendclass\n");
+  const std::string name_b(verible::file::Basename(included_b.filename()));
+  ScopedTestFile included_a(
+      testing::TempDir(),
+      absl::StrCat("`include \"", name_b, "\"\nclass class_a;\nendclass\n"));
+  const std::string name_a(verible::file::Basename(included_a.filename()));
+
+  ScopedTestFile file0(
+      testing::TempDir(),
+      absl::StrCat("`include \"", name_a, "\"\nmodule m0;\nendmodule\n"));
+  ScopedTestFile file1(testing::TempDir(),
+                       absl::StrCat("`include \"", name_b, "\"\n`include \"",
+                                    name_a, "\"\nmodule m1;\nendmodule\n"));
+
+  const std::vector<std::string> file_list = {
+      std::string(verible::file::Basename(file0.filename())),
+      "does-not-exist.sv",
+      std::string(verible::file::Basename(file1.filename())),
+      name_a,  // already extracted as an included file
+  };
+  const std::vector<std::string> include_dir_paths = {testing::TempDir()};
+
+  std::vector<absl::Status> serial_errors;
+  const auto serial_tree =
+      ExtractFiles(file_list, "", testing::TempDir(), include_dir_paths,
+                   serial_errors, /*num_threads=*/1);
+  EXPECT_EQ(serial_errors.size(), 1);
+  // b.svh, a.svh, file0, file1
+  EXPECT_EQ(serial_tree.Children().size(), 4);
+
+  for (int num_threads : {2, 4, 8}) {
+    std::vector<absl::Status> errors;
+    const auto facts_tree =
+        ExtractFiles(file_list, "", testing::TempDir(), include_dir_paths,
+                     errors, num_threads);
+    EXPECT_EQ(errors.size(), serial_errors.size());
+
+    const auto result_pair = DeepEqual(facts_tree, serial_tree);
+    EXPECT_EQ(result_pair.left, nullptr) << *result_pair.left;
+    EXPECT_EQ(result_pair.right, nullptr) << *result_pair.right;
+  }
+}
+
 TEST(FactsTreeExtractor, EnumTest) {
   constexpr int kTag = 1;  // value doesn't matter
   const verible::SyntaxTreeSearchTestCase kTestCase = {
@@ -29,6 +29,7 @@
 #include "common/util/enum_flags.h"
 #include "common/util/file_util.h"
 #include "common/util/init_command_line.h"
+#include "common/util/thread_pool.h"
 #include "verilog/analysis/verilog_analyzer.h"
 #include "verilog/tools/kythe/indexing_facts_tree_extractor.h"
 #include "verilog/tools/kythe/kythe_facts_extractor.h"
@@ -79,6 +80,10 @@ ABSL_FLAG(
     std::string, file_list_root, ".",
     R"(The absolute location which we prepend to the files in the file list (where listed files are relative to).)");
 
+ABSL_FLAG(int, jobs, 0,
+          "Number of files to parse and extract concurrently.  0 means use "
+          "all available cores.  The output doesn't depend on this.");
+
 // TODO: support repeatable flag
 ABSL_FLAG(
     std::vector<std::string>, include_dir_paths, {},
@@ -145,10 +150,14 @@ static std::vector<absl::Status> ExtractFiles(
     const std::vector<std::string>& ordered_file_list,
     absl::string_view file_list_path, absl::string_view file_list_root,
     const std::vector<std::string>& include_dir_paths) {
+  int jobs = absl::GetFlag(FLAGS_jobs);
+  if (jobs <= 0) jobs = verible::ThreadPool::DefaultNumThreads();
+
   std::vector<absl::Status> errors;
   const verilog::kythe::IndexingFactNode file_list_facts_tree(
       verilog::kythe::ExtractFiles(ordered_file_list, file_list_path,
-                                   file_list_root, include_dir_paths, errors));
+                                   file_list_root, include_dir_paths, errors,
+                                   jobs));
 
   // check for printextraction flag, and print extraction if on
   if (absl::GetFlag(FLAGS_printextraction)) {
@@ -192,6 +192,34 @@ status="$?"
   exit 1
 }
 
+################################################################################
+echo "=== Test --jobs preserves file order and exit status"
+
+CLEAN_FILE="${TEST_TMPDIR}/lint-clean.sv"
+
+cat > "${CLEAN_FILE}" <<EOF
+class c;
+endclass
+EOF
+
+"$lint_tool" --rules=no-tabs "$TEST_FILE" "$CLEAN_FILE" "$TEST_FILE" \
+  > "${MY_OUTPUT_FILE}.serial" 2> "${MY_OUTPUT_FILE}.err"
+serial_status="$?"
+
+"$lint_tool" --rules=no-tabs --jobs=3 "$TEST_FILE" "$CLEAN_FILE" "$TEST_FILE" \
+  > "${MY_OUTPUT_FILE}.parallel" 2> "${MY_OUTPUT_FILE}.err"
+
+status="$?"
+[[ $status == $serial_status ]] || {
+  echo "Expected exit code $serial_status, but got $status"
+  exit 1
+}
+
+diff -u "${MY_OUTPUT_FILE}.serial" "${MY_OUTPUT_FILE}.parallel" || {
+  echo "Expected identical output with --jobs."
+  exit 1
+}
+
 ################################################################################
 echo "=== Test invalid rule (--rules)"
 
@@ -18,6 +18,7 @@
 // Example usage:
 // verilog_lint files...
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
@@ -25,13 +26,23 @@
 #include <vector>
 
 #include "absl/flags/flag.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "common/analysis/lint_result_cache.h"
+#include "common/util/file_util.h"
 #include "common/util/init_command_line.h"
 #include "common/util/logging.h"  // for operator<<, LOG, LogMessage, etc
+#include "common/util/status_macros.h"
+#include "common/util/thread_pool.h"
 #include "verilog/analysis/verilog_linter.h"
 #include "verilog/analysis/verilog_linter_configuration.h"
+#include "verilog/preprocessor/verilog_macro_set.h"
+#include "verilog/preprocessor/verilog_preprocess.h"
 
 ABSL_FLAG(bool, check_syntax, true,
           "If true, check for lexical and syntax errors, otherwise ignore.");
@@ -47,8 +58,106 @@ ABSL_FLAG(
     "If true, print the description of every rule formatted for the "
     "Markdown and exit immediately. Intended for the output to be written "
     "to a snippet of Markdown.");
+ABSL_FLAG(int, jobs, 1,
+          "Number of files to analyze concurrently.  0 means use all "
+          "available cores.  Diagnostics are always reported in the order "
+          "of the files on the command line.");
+ABSL_FLAG(std::string, cache_dir, "",
+          "If not empty, directory that keeps the diagnostics of linted "
+          "files.  Files whose content, lint configuration, waivers and "
+          "options are unchanged since they were last linted with the same "
+          "tool version are reported from the cache without analyzing "
+          "them.  The directory can be shared by concurrent invocations.");
+ABSL_FLAG(bool, filter_branches, false,
+          "If true, analyze only the active branches of `ifdef/`ifndef/"
+          "`elsif/`else blocks, given the macros of --define, --macro_files "
+          "and those `define-d earlier in the same file.  Diagnostics still "
+          "refer to the original source locations.");
+ABSL_FLAG(std::vector<std::string>, define, {},
+          "Comma-separated list of macros that are defined at the start of "
+          "every file, like +define+NAME.  Values given as NAME=VALUE are "
+          "ignored, only definedness matters.  Only used with "
+          "--filter_branches.");
+ABSL_FLAG(std::vector<std::string>, macro_files, {},
+          "Comma-separated list of headers, like uvm_macros.svh, whose macro "
+          "definitions are available in every file, as if the headers were "
+          "included one after another before it.  The headers are only "
+          "analyzed once per run.");
+ABSL_FLAG(std::string, precompiled_macros, "",
+          "File with the macro definitions of --macro_files in a compact "
+          "form.  With --macro_files, it is written, otherwise it is read, "
+          "so that later runs do not analyze the headers again.");
 
 using verilog::LinterConfiguration;
+using verilog::VerilogMacroSet;
+using verilog::VerilogPreprocessConfig;
+
+// Returns the preprocessor configuration from flags, shared by all files.
+static absl::StatusOr<VerilogPreprocessConfig> PreprocessConfigFromFlags() {
+  VerilogPreprocessConfig config;
+  config.filter_branches = absl::GetFlag(FLAGS_filter_branches);
+  for (const auto& define : absl::GetFlag(FLAGS_define)) {
+    const absl::string_view name = absl::StripAsciiWhitespace(
+        absl::string_view(define).substr(0, define.find('=')));
+    if (!name.empty()) config.defines.emplace(name);
+  }
+
+  const std::vector<std::string> macro_files =
+      absl::GetFlag(FLAGS_macro_files);
+  const std::string precompiled_macros =
+      absl::GetFlag(FLAGS_precompiled_macros);
+  if (!macro_files.empty()) {
+    std::string headers;
+    for (const auto& filename : macro_files) {
+      std::string content;
+      RETURN_IF_ERROR(verible::file::GetContents(filename, &content));
+      absl::StrAppend(&headers, content, "\n");
+    }
+    const auto macro_set = VerilogMacroSet::Build(headers, config);
+    if (!macro_set.ok()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("In the concatenation of --macro_files: ",
+                       macro_set.status().message()));
+    }
+    config.predefined_macros = *macro_set;
+    if (!precompiled_macros.empty()) {
+      RETURN_IF_ERROR(verible::file::SetContentsAtomically(
+          precompiled_macros, (*macro_set)->Serialize()));
+    }
+  } else if (!precompiled_macros.empty()) {
+    std::string content;
+    RETURN_IF_ERROR(verible::file::GetContents(precompiled_macros, &content));
+    const auto macro_set = VerilogMacroSet::Deserialize(content);
+    if (!macro_set.ok()) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "In ", precompiled_macros, ": ", macro_set.status().message()));
+    }
+    config.predefined_macros = *macro_set;
+  }
+  return config;
+}
+
+// Lints one file with configuration from flags, and returns exit status.
+static int LintOneFileFromFlags(std::ostream* stream,
+                                absl::string_view filename,
+                                const verible::LintResultCache* cache,
+                                const VerilogPreprocessConfig& preprocess) {
+  // Copy configuration, so that it can be locally modified per file.
+  const LinterConfiguration config(
+      verilog::LinterConfigurationFromFlags(filename));
+
+  return verilog::LintOneFile(
+      stream, filename, config,  //
+      absl::GetFlag(FLAGS_check_syntax), absl::GetFlag(FLAGS_parse_fatal),
+      absl::GetFlag(FLAGS_lint_fatal), cache, preprocess);
+}
+
+// Buffered diagnostics of one file, for concurrent analysis.
+struct FileLintResult {
+  std::ostringstream output;
+  int status = 0;
+  bool done = false;  // guarded by a mutex shared among all results
+};
 
 int main(int argc, char** argv) {
   const auto usage =
@@ -68,19 +177,65 @@ int main(int argc, char** argv) {
     return 0;
   }
 
+  std::unique_ptr<verible::LintResultCache> cache;
+  const std::string cache_dir = absl::GetFlag(FLAGS_cache_dir);
+  if (!cache_dir.empty()) {
+    const auto version =
+        verible::LintResultCache::ProgramVersion(verible::GetBuildVersion());
+    if (version.ok()) {
+      cache = absl::make_unique<verible::LintResultCache>(cache_dir, *version);
+    } else {
+      LOG(WARNING) << "Not caching lint results: " << version.status();
+    }
+  }
+
+  const auto preprocess_or = PreprocessConfigFromFlags();
+  if (!preprocess_or.ok()) {
+    std::cerr << preprocess_or.status().message() << std::endl;
+    return 2;
+  }
+  const VerilogPreprocessConfig& preprocess(*preprocess_or);
+
   int exit_status = 0;
   // All positional arguments are file names.  Exclude program name.
-  for (const auto filename :
-       verible::make_range(args.begin() + 1, args.end())) {
-    // Copy configuration, so that it can be locally modified per file.
-    const LinterConfiguration config(
-        verilog::LinterConfigurationFromFlags(filename));
-
-    const int lint_status = verilog::LintOneFile(
-        &std::cout, filename, config,  //
-        absl::GetFlag(FLAGS_check_syntax), absl::GetFlag(FLAGS_parse_fatal),
-        absl::GetFlag(FLAGS_lint_fatal));
-    exit_status = std::max(lint_status, exit_status);
+  const std::vector<absl::string_view> files(args.begin() + 1, args.end());
+  int jobs = absl::GetFlag(FLAGS_jobs);
+  if (jobs <= 0) jobs = verible::ThreadPool::DefaultNumThreads();
+  jobs = std::min<int>(jobs, files.size());
+
+  if (jobs <= 1) {
+    for (const auto filename : files) {
+      const int lint_status =
+          LintOneFileFromFlags(&std::cout, filename, cache.get(), preprocess);
+      exit_status = std::max(lint_status, exit_status);
+    }  // for each file
+    return exit_status;
+  }
+
+  // Files are analyzed independently on a pool of workers, where each idle
+  // worker picks up the next unprocessed file.  Diagnostics are buffered per
+  // file, and printed in command-line order as soon as all preceding files
+  // have been reported.
+  std::vector<FileLintResult> results(files.size());
+  absl::Mutex results_lock;
+  verible::ThreadPool pool(jobs);
+  for (size_t i = 0; i < results.size(); ++i) {
+    pool.Schedule([&files, &results, &results_lock, &cache, &preprocess, i] {
+      FileLintResult& result(results[i]);
+      result.status = LintOneFileFromFlags(&result.output, files[i],
+                                           cache.get(), preprocess);
+      absl::MutexLock l(&results_lock);
+      result.done = true;
+    });
+  }
+  for (auto& result : results) {
+    {
+      absl::MutexLock l(&results_lock);
+      results_lock.Await(absl::Condition(&result.done));
+    }
+    std::cout << result.output.str() << std::flush;
+    result.output.str("");  // release memory early
+    exit_status = std::max(result.status, exit_status);
   }  // for each file
 
   return exit_status;
@@ -0,0 +1,143 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/tools/server/verilog_server.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <sstream>  // IWYU pragma: keep  // for ostringstream
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "common/strings/mem_block.h"
+#include "common/util/logging.h"
+#include "verilog/analysis/verilog_analyzer.h"
+#include "verilog/analysis/verilog_linter.h"
+#include "verilog/analysis/verilog_linter_configuration.h"
+#include "verilog/formatting/formatter.h"
+
+namespace verilog {
+
+// Largest part of a request's content that is read at once.
+static constexpr size_t kReadChunkSize = 1 << 20;
+
+absl::Status ReadServerRequest(std::istream* input, ServerRequest* request) {
+  std::string header;
+  if (!std::getline(*input, header)) {
+    return absl::OutOfRangeError("end of input");
+  }
+  const std::vector<absl::string_view> fields =
+      absl::StrSplit(header, absl::MaxSplits(' ', 2));
+  size_t length;
+  if (fields.size() != 3 || !absl::SimpleAtoi(fields[1], &length)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("malformed request header: \"", header, "\""));
+  }
+  request->command = std::string(fields[0]);
+  request->filename = std::string(fields[2]);
+
+  // Read in chunks, so that a bogus length fails at the end of the input
+  // rather than allocating all of it up front.
+  auto content = std::make_shared<verible::StringMemBlock>();
+  std::string* text = content->mutable_content();
+  while (text->size() < length) {
+    const size_t offset = text->size();
+    const size_t chunk = std::min(length - offset, kReadChunkSize);
+    text->resize(offset + chunk);
+    if (!input->read(&(*text)[offset], chunk)) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("truncated content of \"", request->filename, "\""));
+    }
+  }
+  request->content = std::move(content);
+  return absl::OkStatus();
+}
+
+void WriteServerResponse(const ServerResponse& response, std::ostream* output) {
+  *output << response.status << ' ' << response.output.length() << '\n'
+          << response.output << std::flush;
+}
+
+ServerResponse VerilogServer::HandleRequest(
+    const ServerRequest& request) const {
+  if (request.command == "lint") return Lint(request);
+  if (request.command == "format") return Format(request);
+  if (request.command == "syntax") return CheckSyntax(request);
+  return {2, absl::StrCat("unknown command: \"", request.command, "\"\n")};
+}
+
+ServerResponse VerilogServer::Lint(const ServerRequest& request) const {
+  const LinterConfiguration config(
+      LinterConfigurationFromFlags(request.filename));
+  std::ostringstream stream;
+  ServerResponse response;
+  response.status = LintOneFileContent(
+      &stream, request.filename, request.content, config,
+      options_.check_syntax, options_.parse_fatal, options_.lint_fatal,
+      options_.lint_cache);
+  response.output = stream.str();
+  return response;
+}
+
+ServerResponse VerilogServer::Format(const ServerRequest& request) const {
+  // Formatter diagnostics must not interleave with responses.
+  std::ostringstream diagnostics;
+  formatter::ExecutionControl control(options_.format_control);
+  control.stream = &diagnostics;
+
+  std::ostringstream stream;
+  const absl::Status status = formatter::FormatVerilog(
+      request.content->AsStringView(), request.filename, options_.format_style,
+      stream, {}, control);
+  if (!status.ok()) {
+    return {1, absl::StrCat(request.filename, ": ", status.message(), "\n")};
+  }
+  return {0, stream.str()};
+}
+
+ServerResponse VerilogServer::CheckSyntax(const ServerRequest& request) const {
+  const auto analyzer =
+      VerilogAnalyzer::AnalyzeAutomaticMode(request.content, request.filename);
+  ServerResponse response;
+  if (!ABSL_DIE_IF_NULL(analyzer)->LexStatus().ok() ||
+      !analyzer->ParseStatus().ok()) {
+    for (const auto& message : analyzer->LinterTokenErrorMessages()) {
+      absl::StrAppend(&response.output, message, "\n");
+    }
+    response.status = 1;
+  }
+  return response;
+}
+
+int VerilogServer::Serve(std::istream* input, std::ostream* output) const {
+  ServerRequest request;
+  while (true) {
+    const absl::Status status = ReadServerRequest(input, &request);
+    if (status.code() == absl::StatusCode::kOutOfRange) return 0;
+    if (!status.ok()) {
+      LOG(ERROR) << status.message();
+      return 1;
+    }
+    WriteServerResponse(HandleRequest(request), output);
+  }
+}
+
+}  // namespace verilog
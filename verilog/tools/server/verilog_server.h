@@ -0,0 +1,106 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_VERILOG_TOOLS_SERVER_VERILOG_SERVER_H_
+#define VERIBLE_VERILOG_TOOLS_SERVER_VERILOG_SERVER_H_
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include "absl/status/status.h"
+#include "common/analysis/lint_result_cache.h"
+#include "common/strings/mem_block.h"
+#include "verilog/formatting/format_style.h"
+#include "verilog/formatting/formatter.h"
+
+namespace verilog {
+
+// The server reads a stream of requests, and writes one response per request,
+// in order.  Every message is a header line followed by a payload of exactly
+// the number of bytes given in the header, so that payloads need no escaping.
+//
+// Request:   <command> <length> <filename>\n<content>
+// Response:  <status> <length>\n<output>
+//
+// <command> is one of:
+//   lint:   <output> are the lint diagnostics of <content>, and <status> is
+//           the exit status of verible-verilog-lint for it.
+//   format: <output> is the formatted <content> if <status> is 0, otherwise
+//           an error message.
+//   syntax: <output> are the syntax errors of <content>, and <status> is 1 if
+//           there are any.
+// <filename> is used in diagnostics, and to look up lint configuration.  It
+// may contain spaces, and the file need not exist.
+// Unknown commands are answered with <status> 2.
+
+struct ServerRequest {
+  std::string command;
+  std::string filename;
+  std::shared_ptr<verible::MemBlock> content;
+};
+
+struct ServerResponse {
+  int status = 0;
+  std::string output;
+};
+
+// Reads the next request from 'input'.
+// Returns an OutOfRange error at the end of input, and an InvalidArgument
+// error for malformed requests, after which 'input' cannot be resumed.
+absl::Status ReadServerRequest(std::istream* input, ServerRequest* request);
+
+// Writes 'response' to 'output'.
+void WriteServerResponse(const ServerResponse& response, std::ostream* output);
+
+// Options that apply to all requests served by one VerilogServer.
+struct ServerOptions {
+  // Same as the flags of verible-verilog-lint.
+  bool check_syntax = true;
+  bool parse_fatal = true;
+  bool lint_fatal = true;
+
+  // If not null, lint results are looked up in and stored in this cache.
+  const verible::LintResultCache* lint_cache = nullptr;
+
+  formatter::FormatStyle format_style;
+  formatter::ExecutionControl format_control;
+};
+
+// VerilogServer services lint, format and syntax requests for many files
+// within one process.  Lint configurations and waiver files are read and
+// compiled once, and re-read only when they change on disk, see
+// LinterConfigurationFromFlags().
+class VerilogServer {
+ public:
+  explicit VerilogServer(const ServerOptions& options) : options_(options) {}
+
+  // Returns the response to 'request'.
+  ServerResponse HandleRequest(const ServerRequest& request) const;
+
+  // Answers requests from 'input' on 'output' until the end of input.
+  // Returns an exit status: 0 at the end of input, 1 on a malformed request.
+  int Serve(std::istream* input, std::ostream* output) const;
+
+ private:
+  ServerResponse Lint(const ServerRequest& request) const;
+  ServerResponse Format(const ServerRequest& request) const;
+  ServerResponse CheckSyntax(const ServerRequest& request) const;
+
+  const ServerOptions options_;
+};
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_TOOLS_SERVER_VERILOG_SERVER_H_
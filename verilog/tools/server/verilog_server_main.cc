@@ -0,0 +1,76 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// verilog_server is a long-running process that lints, formats and checks
+// the syntax of many files on request, avoiding the startup cost of running
+// a tool per file.  See verilog_server.h for the protocol.
+//
+// Example usage:
+// verible-verilog-server --rules_config_search < requests > responses
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "common/analysis/lint_result_cache.h"
+#include "common/util/init_command_line.h"
+#include "common/util/logging.h"
+#include "verilog/formatting/format_style_flags.h"
+#include "verilog/tools/server/verilog_server.h"
+
+ABSL_FLAG(bool, check_syntax, true,
+          "If true, lint requests check for lexical and syntax errors, "
+          "otherwise ignore.");
+ABSL_FLAG(bool, parse_fatal, true,
+          "If true, lint requests fail if there are any syntax errors.");
+ABSL_FLAG(bool, lint_fatal, true,
+          "If true, lint requests fail if linter finds violations.");
+ABSL_FLAG(std::string, cache_dir, "",
+          "If not empty, directory that keeps the diagnostics of linted "
+          "files, shared with verible-verilog-lint --cache_dir.");
+
+int main(int argc, char** argv) {
+  const auto usage = absl::StrCat("usage: ", argv[0],
+                                  " [options] < requests > responses");
+  verible::InitCommandLine(usage, &argc, &argv);
+
+  std::unique_ptr<verible::LintResultCache> cache;
+  const std::string cache_dir = absl::GetFlag(FLAGS_cache_dir);
+  if (!cache_dir.empty()) {
+    const auto version =
+        verible::LintResultCache::ProgramVersion(verible::GetBuildVersion());
+    if (version.ok()) {
+      cache = absl::make_unique<verible::LintResultCache>(cache_dir, *version);
+    } else {
+      LOG(WARNING) << "Not caching lint results: " << version.status();
+    }
+  }
+
+  verilog::ServerOptions options;
+  options.check_syntax = absl::GetFlag(FLAGS_check_syntax);
+  options.parse_fatal = absl::GetFlag(FLAGS_parse_fatal);
+  options.lint_fatal = absl::GetFlag(FLAGS_lint_fatal);
+  options.lint_cache = cache.get();
+  options.format_style = verilog::formatter::FormatStyleFromFlags();
+  options.format_control = verilog::formatter::ExecutionControlFromFlags();
+
+  // Requests and responses are exchanged in large blocks.
+  std::ios_base::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+  const verilog::VerilogServer server(options);
+  return server.Serve(&std::cin, &std::cout);
+}
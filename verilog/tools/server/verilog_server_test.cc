@@ -0,0 +1,146 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/tools/server/verilog_server.h"
+
+#include <sstream>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace verilog {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+std::string Request(absl::string_view command, absl::string_view filename,
+                    absl::string_view content) {
+  return absl::StrCat(command, " ", content.length(), " ", filename, "\n",
+                      content);
+}
+
+TEST(ReadServerRequestTest, ReadsSequenceOfRequests) {
+  std::istringstream input(absl::StrCat(Request("lint", "a b.sv", "x\ny\n"),
+                                        Request("format", "c.sv", "")));
+  ServerRequest request;
+  ASSERT_TRUE(ReadServerRequest(&input, &request).ok());
+  EXPECT_EQ(request.command, "lint");
+  EXPECT_EQ(request.filename, "a b.sv");
+  EXPECT_EQ(request.content->AsStringView(), "x\ny\n");
+  ASSERT_TRUE(ReadServerRequest(&input, &request).ok());
+  EXPECT_EQ(request.command, "format");
+  EXPECT_EQ(request.filename, "c.sv");
+  EXPECT_EQ(request.content->AsStringView(), "");
+  EXPECT_EQ(ReadServerRequest(&input, &request).code(),
+            absl::StatusCode::kOutOfRange);
+}
+
+TEST(ReadServerRequestTest, ReadsLargeContent) {
+  const std::string content(3 << 20, 'x');
+  std::istringstream input(Request("lint", "a.sv", content));
+  ServerRequest request;
+  ASSERT_TRUE(ReadServerRequest(&input, &request).ok());
+  EXPECT_EQ(request.content->AsStringView(), content);
+}
+
+TEST(ReadServerRequestTest, MalformedRequests) {
+  constexpr absl::string_view kTestCases[] = {
+      "lint\n",
+      "lint 3\n",
+      "lint x a.sv\n",
+      "lint -1 a.sv\n",
+      "lint 10 a.sv\nshort",
+      "lint 18446744073709551615 a.sv\nshort",
+  };
+  for (const auto test : kTestCases) {
+    std::istringstream input{std::string(test)};
+    ServerRequest request;
+    EXPECT_EQ(ReadServerRequest(&input, &request).code(),
+              absl::StatusCode::kInvalidArgument)
+        << test;
+  }
+}
+
+TEST(WriteServerResponseTest, HeaderAndOutput) {
+  std::ostringstream output;
+  WriteServerResponse({1, "a\nb"}, &output);
+  EXPECT_EQ(output.str(), "1 3\na\nb");
+}
+
+class VerilogServerTest : public testing::Test {
+ protected:
+  ServerResponse Handle(absl::string_view command, absl::string_view content) {
+    std::istringstream input(Request(command, "test.sv", content));
+    ServerRequest request;
+    EXPECT_TRUE(ReadServerRequest(&input, &request).ok());
+    return server_.HandleRequest(request);
+  }
+
+  const VerilogServer server_{ServerOptions()};
+};
+
+TEST_F(VerilogServerTest, Syntax) {
+  EXPECT_EQ(Handle("syntax", "module m;\nendmodule\n").status, 0);
+  const ServerResponse response = Handle("syntax", "module m;\n");
+  EXPECT_EQ(response.status, 1);
+  EXPECT_THAT(response.output, StartsWith("test.sv:"));
+}
+
+TEST_F(VerilogServerTest, Format) {
+  const ServerResponse response = Handle("format", "module   m;endmodule");
+  EXPECT_EQ(response.status, 0);
+  EXPECT_EQ(response.output, "module m;\nendmodule\n");
+  EXPECT_EQ(Handle("format", "module m;\n").status, 1);
+}
+
+TEST_F(VerilogServerTest, Lint) {
+  EXPECT_EQ(Handle("lint", "").status, 0);
+  const ServerResponse response = Handle("lint",
+                                         "task automatic foo;\n"
+                                         "  $psprintf(\"blah\");\n"
+                                         "endtask\n");
+  EXPECT_EQ(response.status, 1);
+  EXPECT_THAT(response.output, HasSubstr("psprintf"));
+}
+
+TEST_F(VerilogServerTest, UnknownCommand) {
+  EXPECT_EQ(Handle("compile", "").status, 2);
+}
+
+TEST(VerilogServerServeTest, AnswersEachRequest) {
+  const VerilogServer server{ServerOptions()};
+  std::istringstream input(
+      absl::StrCat(Request("syntax", "a.sv", "module m;\nendmodule\n"),
+                   Request("syntax", "b.sv", "module m;\n")));
+  std::ostringstream output;
+  EXPECT_EQ(server.Serve(&input, &output), 0);
+  EXPECT_THAT(output.str(), StartsWith("0 0\n1 "));
+  EXPECT_THAT(output.str(), HasSubstr("b.sv:"));
+}
+
+TEST(VerilogServerServeTest, StopsAtMalformedRequest) {
+  const VerilogServer server{ServerOptions()};
+  std::istringstream input("syntax\n");
+  std::ostringstream output;
+  EXPECT_EQ(server.Serve(&input, &output), 1);
+  EXPECT_EQ(output.str(), "");
+}
+
+}  // namespace
+}  // namespace verilog